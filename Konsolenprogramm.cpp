@@ -1,532 +1,1292 @@
-#include <iostream>
-#include <thread>
-#include <chrono>
-#include <vector>
-#include <limits>
-#include <fstream>
-#include <Pfad_zu/RPS_Header.h>
-
-
-//// Game & Player config variables
-int p1{}, p2{}, rounds{};
-char fix_init{ 'R' };
-short rot_init_1{}, rot_init_2{};
-int rand_seed_1{}, rand_seed_2{};
-int meta_scoring_func_1{}, meta_scoring_func_2{};
-double scoring_array_1[6]{}, scoring_array_2[6]{};
-double default_mul_scoring_array[6]{ 0.95, 1.1, 0.9, 1, 10, 1 };
-int round_delay{};
-
-// Bunch of control flags for program flow
-bool user_flag{};
-bool set_flag_rand_seed_1{}, set_flag_rand_seed_2{}, set_flag_rot_init_1{}, set_flag_rot_init_2{}, \
-set_flag_meta_scoring_func_1{}, set_flag_meta_scoring_func_2{}, set_flag_scoring_array_1{}, \
-set_flag_scoring_array_2{}, set_flag_user_name_1{}, set_flag_user_name_2{}, \
-set_flag_no_seed_1{}, set_flag_no_seed_2{};
-bool set_flag_print_rot_init{}, set_flag_print_rand_seed{}, set_flag_print_meta_scoring_func{}, set_flag_print_score_array{};
-
-std::string user_name_1{ "" }, user_name_2{ "" };
-std::string save_path{}, f_name{};
-const std::vector<std::string> scoring_funcs{ "multiplicative", "additive", "multiplicative drop switch", "additive drop switch", "default multiplicative" };
-
-
-
-
-// flush_cin() clears iostream stream buffer in case of bad input
-void flush_cin() {
-	std::cin.clear();
-	std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-}
-
-// input_exception_handler() wraps exception handling and stream buffer clearing around std::cin >> target_variable 
-template<typename T>
-T input_exception_handler(std::string err_msg = "Invalid input!") {
-	T target{};
-	while (true) {
-		try {
-			std::cin >> target;
-			if (!std::cin) throw std::runtime_error{ err_msg };
-		}
-		catch (std::exception& e) {
-			std::cout << "\nError: " << e.what() << "\n\n";
-			flush_cin();
-			continue;
-		}
-		flush_cin();
-		break;
-	}
-	return target;
-}
-
-
-// Sets up player variables based on user input
-void configure_player(int p) {
-	auto scoring_array_ptr = (set_flag_scoring_array_1 ? scoring_array_2 : scoring_array_1);// points to first or second scoring array based on truth value of set_flag_scoring_array_1
-																						    // --> will choose second scoring array if first has already been set
-	switch (p) {
-	case 0: // Fixed Player
-		std::cout << "\n\nChoose Fixed Player move shape (R for Rock, P for Paper, S for Scissors): ";
-		while (true) {
-			try {
-				fix_init = input_exception_handler<char>();
-				if (!(fix_init == 'R' or fix_init == 'P' or fix_init == 'S')) throw std::domain_error{ "Fixed shape has to be R, P or S!" };
-			}
-			catch (std::exception& e) {
-				std::cout << "\nError: " << e.what() << "\n\n";
-				continue;
-			}
-			break;
-		}
-		break;
-	case 1: // Rotation Player
-		std::cout << "\n\nChoose Rotation Player rotation (0-2; will use Euclidian modulo for negative or larger than 2 numbers): ";
-		if (!set_flag_rot_init_1) { // if first rotation player
-			rot_init_1 = input_exception_handler<short>();
-			set_flag_rot_init_1 = true;
-		}
-		else { // if second rotation player
-			rot_init_2 = input_exception_handler<short>();
-			set_flag_rot_init_2 = true;
-		}
-		break;
-	case 2: // Frequency Player
-		break;
-	case 3: // Anti Rotation Player
-		break;
-	case 4: // Human Player
-		std::cout << "\nYour name: ";
-		if (!set_flag_user_name_1) { // if first human player
-			user_name_1 = input_exception_handler<std::string>();
-			set_flag_user_name_1 = true;
-		}
-		else { // if second human player
-			user_name_2 = input_exception_handler<std::string>();
-			set_flag_user_name_2 = true;
-		}
-		break;
-	case 5: // Random Player
-		std::cout << "\nDo you want to use a seed for Random Player's RNG (1=yes, 0=no)? ";
-		user_flag = input_exception_handler<bool>();
-
-		if (user_flag) {// if seed is put in
-			std::cout << "\nSeed: ";
-			if (!set_flag_rand_seed_1) { // if first random player
-				rand_seed_1 = input_exception_handler<int>();
-				set_flag_rand_seed_1 = true;
-			}
-			else { // if second random player
-				rand_seed_2 = input_exception_handler<int>();
-				set_flag_rand_seed_2 = true;
-			}
-		}
-		else {// if no seed is put in
-			if (!set_flag_rand_seed_1) { // if first random player
-				set_flag_no_seed_1 = true; // random player will be initialised without seed -> pseudo random seed
-				set_flag_rand_seed_1 = true;
-			}
-			else { // if second random player
-				set_flag_no_seed_2 = true; // random player will be initialised without seed -> pseudo random seed
-				set_flag_rand_seed_2 = true;
-			}
-		}
-		break;
-	case 6: // Meta Player
-		std::cout << "\n\nMeta Player needs a scoring funtion, and scoring function needs a scoring vector. Choose from the following scoring functions:\n\n";
-		std::cout << "(0) Multiplicative scoring function: Multiplies Meta Player scores by values in scoring vector\n";
-		std::cout << "(1) Additive scoring function: Adds values in scoring vector to Meta Player scores\n";
-		std::cout << "(2) Multiplicative drop switch: Multipies Meta Player scores by values in scoring vector in case of win or draw; in case of loss sets score to 3rd value in scoring vector\n";
-		std::cout << "(3) Additive drop switch: Adds values in scoring vector to Meta Player scores in case of win or draw; in case of loss sets score to 3rd value in scoring vector\n";
-		std::cout << "(4) Default scoring function: multiplicative with scoring vector {0.95 (draw), 1.1 (win), 0.9 (loss), 1 (floor), 10 (ceil), 1 (decay)}\n\n";
-		std::cout << "Choose one of the scoring functions above or put in 4 for default scoring function: ";
-		while (true) {
-			try {
-				if (!set_flag_meta_scoring_func_1) { // if first meta player
-					meta_scoring_func_1 = input_exception_handler<int>();
-					if (meta_scoring_func_1 < 0 or meta_scoring_func_1 > 4) throw std::range_error{ "You have to choose between 0 and 4!" };
-					set_flag_meta_scoring_func_1 = true;
-				}
-				else { // if second meta player
-					meta_scoring_func_2 = input_exception_handler<int>();
-					set_flag_meta_scoring_func_2 = true;
-				}
-				if (meta_scoring_func_2 < 0 or meta_scoring_func_2 > 4) throw std::range_error{ "You have to choose between 0 and 4!" };
-			}
-			catch (std::exception& e) {
-				std::cout << "\nError: " << e.what() << "\n\n";
-				continue;
-			}
-			break;
-		}
-		switch ((set_flag_meta_scoring_func_2 ? meta_scoring_func_2 : meta_scoring_func_1)) { // choosing scoring function
-		case 0: // Multiplicative Scoring Function
-			std::cout << "\n\nMultiplicative scoring function needs a scoring vector.\n";
-			std::cout << "You will successively put in the constants that build up the scoring vector:\n\n";
-			std::cout << "Set Draw Multiplier (score of any meta strategy will be multiplied by this value in case of draw): ";
-			*(scoring_array_ptr + 0) = input_exception_handler<double>(); // write either to scoring array_1 or scoring_array_2
-			std::cout << "Set Win Multiplier (score of any meta strategy will be multiplied by this value in case of win): ";
-			*(scoring_array_ptr + 1) = input_exception_handler<double>();
-			std::cout << "Set Loss Multiplier (score of any meta strategy will be multiplied by this value in case of loss): ";
-			*(scoring_array_ptr + 2) = input_exception_handler<double>();
-			std::cout << "Set score floor (score of any meta strategy can never be smaller than this value): ";
-			*(scoring_array_ptr + 3) = input_exception_handler<double>();
-			std::cout << "Set score ceiling (score of any meta strategy can never be larger than this value): ";
-			*(scoring_array_ptr + 4) = input_exception_handler<double>();
-			std::cout << "Set score decay (every score will get multiplied by this constant regardless of outcome): ";
-			*(scoring_array_ptr + 5) = input_exception_handler<double>();
-			if (!set_flag_scoring_array_1) set_flag_scoring_array_1 = true;
-			else set_flag_scoring_array_2 = true;
-			break;
-		case 1: // Additive scoring function
-			std::cout << "\n\nAdditive scoring function needs a scoring vector.\n";
-			std::cout << "You will successively put in the constants that build up the scoring vector:\n\n";
-			std::cout << "Set Draw Constant (this value will be added to score of any meta strategy in case of draw): ";
-			*(scoring_array_ptr + 0) = input_exception_handler<double>();
-			std::cout << "Set Win Constant (this value will be added to score of any meta strategy in case of win): ";
-			*(scoring_array_ptr + 1) = input_exception_handler<double>();
-			std::cout << "Set Loss Constant (this value will be added to score of any meta strategy in case of loss): ";
-			*(scoring_array_ptr + 2) = input_exception_handler<double>();
-			std::cout << "Set score floor (score of any meta strategy can never be smaller than this value): ";
-			*(scoring_array_ptr + 3) = input_exception_handler<double>();
-			std::cout << "Set score ceiling (score of any meta strategy can never be larger than this value): ";
-			*(scoring_array_ptr + 4) = input_exception_handler<double>();
-			std::cout << "Set score decay (every score will get multiplied by this constant regardless of outcome): ";
-			*(scoring_array_ptr + 5) = input_exception_handler<double>();
-			if (!set_flag_scoring_array_1) set_flag_scoring_array_1 = true;
-			else set_flag_scoring_array_2 = true;
-			break;
-		case 2: // Multiplicative drop switch
-			std::cout << "\n\nMultiplicative drop switch needs a scoring vector.\n";
-			std::cout << "You will successively put in the constants that build up the scoring vector:\n\n";
-			std::cout << "Set Draw Multiplier (score of any meta strategy will be multiplied by this value in case of draw): ";
-			*(scoring_array_ptr + 0) = input_exception_handler<double>();
-			std::cout << "Set Win Multiplier (score of any meta strategy will be multiplied by this value in case of win): ";
-			*(scoring_array_ptr + 1) = input_exception_handler<double>();
-			std::cout << "Set Loss Value (score of any meta strategy will be set to this value in case of loss): ";
-			*(scoring_array_ptr + 2) = input_exception_handler<double>();
-			std::cout << "Set score floor (score of any meta strategy can never be smaller than this value): ";
-			*(scoring_array_ptr + 3) = input_exception_handler<double>();
-			std::cout << "Set score ceiling (score of any meta strategy can never be larger than this value): ";
-			*(scoring_array_ptr + 4) = input_exception_handler<double>();
-			std::cout << "Set score decay (every score will get multiplied by this constant regardless of outcome): ";
-			*(scoring_array_ptr + 5) = input_exception_handler<double>();
-			if (!set_flag_scoring_array_1) set_flag_scoring_array_1 = true;
-			else set_flag_scoring_array_2 = true;
-			break;
-		case 3: // Additive drop switch
-			std::cout << "\n\nAdditive drop switch needs a scoring vector.\n";
-			std::cout << "You will successively put in the constants that build up the scoring vector:\n\n";
-			std::cout << "Set Draw Constant (this value will be added to score of any meta strategy in case of draw): ";
-			*(scoring_array_ptr + 0) = input_exception_handler<double>();
-			std::cout << "Set Win Constant (this value will be added to score of any meta strategy in case of win): ";
-			*(scoring_array_ptr + 1) = input_exception_handler<double>();
-			std::cout << "Set Loss Constant (score of any meta strategy will be set to this value in case of loss): ";
-			*(scoring_array_ptr + 2) = input_exception_handler<double>();
-			std::cout << "Set score floor (score of any meta strategy can never be smaller than this value): ";
-			*(scoring_array_ptr + 3) = input_exception_handler<double>();
-			std::cout << "Set score ceiling (score of any meta strategy can never be larger than this value): ";
-			*(scoring_array_ptr + 4) = input_exception_handler<double>();
-			std::cout << "Set score decay (every score will get multiplied by this constant regardless of outcome): ";
-			*(scoring_array_ptr + 5) = input_exception_handler<double>();
-			if (!set_flag_scoring_array_1) set_flag_scoring_array_1 = true;
-			else set_flag_scoring_array_2 = true;
-			break;
-		case 4: // Default Multiplicative Scoring Function (uses default scoring array)
-			for (int i{}; i < 6; i += 1) {
-				*(scoring_array_ptr + i) = default_mul_scoring_array[i]; // copy default scoring array to current array (if default was chosen); just for printing
-																		 // because if default, random player will be initialised with default scoring array, 
-																		 // not with scoring array_1 or scoring_array_2
-			}
-			if (!set_flag_scoring_array_1) set_flag_scoring_array_1 = true;
-			else set_flag_scoring_array_2 = true;
-			break;
-		}
-		break;
-	case 7: // Random Strategy Player
-		break;
-	}
-}
-
-// Prints current player setup after configuration is complete but before playing the game; main() gives option to reconfigure
-void print_setup(int p, int p_num, Player* player) {
-	std::cout << "Player " << p_num << " : ";
-	auto scoring_array_ptr = (set_flag_print_score_array ? scoring_array_2 : scoring_array_1);
-
-	switch (p) {
-	case 0: // Fixed Player
-		std::cout << player->get_name();
-		break;
-	case 1: // Rotation Player
-		std::cout << player->get_name();
-		std::cout << " (Rotation by " << (set_flag_print_rot_init ? rot_init_2 : rot_init_1) << ")\n";
-		set_flag_print_rot_init = true;
-		break;
-	case 2: // Frequency Player
-		std::cout << player->get_name();
-		break;
-	case 3: // Anti Rotation Player
-		std::cout << player->get_name();
-		break;
-	case 4: // Human Player
-		std::cout << player->get_name();
-		break;
-	case 5: // Random Player
-		std::cout << player->get_name();
-		if (!set_flag_print_rand_seed and set_flag_no_seed_1) {
-			std::cout << " (no seed)";
-		}
-		else if (set_flag_print_rand_seed and set_flag_no_seed_2) {
-			std::cout << " (no seed)";
-		}
-		else {
-			std::cout << " (Seed: " << (set_flag_print_rand_seed ? rand_seed_2 : rand_seed_1) << ")";
-		}
-		set_flag_print_rand_seed = true;
-		break;
-	case 6: // Meta Player
-		std::cout << player->get_name();
-		std::cout << " (scoring array {";
-		for (int i{}; i < 6; i += 1) { // print scoring array associated with meta player
-			std::cout << *(scoring_array_ptr + i) << " ";
-		}
-		std::cout << "})\n";
-		set_flag_print_meta_scoring_func = true;
-		set_flag_print_score_array = true;
-		break;
-	case 7: // Random Strategy Player
-		std::cout << player->get_name();
-		break;
-	}
-
-}
-
-// Initializes Player objects based on configuration
-Player* setup_player(int p) {
-	Player* player{};
-	auto scoring_array_ptr = (set_flag_scoring_array_2 ? &scoring_array_2 : &scoring_array_1);
-	switch (p) {
-	case 0: // Fixed Player
-		player = new Fixed{ fix_init };
-		break;
-	case 1: // Rotation Player
-		if (!set_flag_rot_init_2) player = new Rotation{ rot_init_1 };
-		else player = new Rotation{ rot_init_2 };
-		break;
-	case 2: // Frequency Player
-		player = new Frequency{};
-		break;
-	case 3: // Anti Rotation Player
-		player = new Anti_Rotation{};
-		break;
-	case 4: // Human Player
-		if (!set_flag_user_name_2) player = new Human{ user_name_1 };
-		else player = new Human{ user_name_2 };
-		break;
-	case 5: // Random Player
-		if (!set_flag_rand_seed_2 and set_flag_no_seed_1) {
-			player = new Random{};
-		}
-		else if (set_flag_rand_seed_2 and set_flag_no_seed_2) {
-			player = new Random{};
-		}
-		else if (!set_flag_rand_seed_2 and !set_flag_no_seed_1) {
-			player = new Random{ rand_seed_1 };
-		}
-		else if (set_flag_rand_seed_2 and !set_flag_no_seed_2) {
-			player = new Random{ rand_seed_2 };
-		}
-		break;
-	case 6: // Meta Player
-		switch ((set_flag_meta_scoring_func_2 ? meta_scoring_func_2 : meta_scoring_func_1)) {
-		case 0: // Multiplicative Scoring Function
-			player = new Meta_Player_Naive{ false, scoring_funcs[0], naive_score_mul, *scoring_array_ptr };
-			break;
-		case 1: // Additive scoring function
-			player = new Meta_Player_Naive{ false, scoring_funcs[1], naive_score_add, *scoring_array_ptr };
-			break;
-		case 2: // Multiplicative drop switch
-			player = new Meta_Player_Naive{ false, scoring_funcs[2], drop_switch_mul, *scoring_array_ptr };
-			break;
-		case 3: // Additive drop switch
-			player = new Meta_Player_Naive{ false, scoring_funcs[3], drop_switch_add, *scoring_array_ptr };
-			break;
-		case 4: // Default Multiplicative Scoring Function (uses default scoring array)
-			player = new Meta_Player_Naive{ false, scoring_funcs[4], naive_score_mul, default_mul_scoring_array };
-			break;
-		}
-		break;
-	case 7: // Random Strategy Player
-		player = new Meta_Player_Rand_Strat{ false };
-		break;
-	}
-	return player;
-}
-
-// Resets all control flags before a new game is played within the same console session; is called by main()
-void reset_config() {
-	set_flag_rand_seed_1 = false; set_flag_rand_seed_2 = false; set_flag_rot_init_1 = false; set_flag_rot_init_2 = false; \
-		set_flag_meta_scoring_func_1 = false; set_flag_meta_scoring_func_2 = false; set_flag_scoring_array_1 = false; \
-		set_flag_scoring_array_2 = false; set_flag_user_name_1 = false; set_flag_user_name_2 = false;
-		set_flag_print_rot_init = false; set_flag_print_rand_seed = false; set_flag_print_meta_scoring_func = false; \
-		set_flag_print_score_array = false; set_flag_no_seed_1 = false; set_flag_no_seed_2 = false;
-
-}
-
-//// Main
-int main() {
-
-	std::cout << "==================================================\n";
-	std::cout << "== Welcome to Rock-Paper-Scissors engine v.1.0! ==\n";
-	std::cout << "==================================================\n\n\n";
-
-	while (true) {
-
-		Player* player1{}, * player2{};
-
-		while (true) {
-			std::cout << "\n\nFirst, you need to choose two players to play against each other from the following selection:\n\n";
-			std::cout << "(0) Fixed Player: Always plays the same move (Rock, Paper or Scissors)\n";
-			std::cout << "(1) Rotation Player: Rotates last opponent Move by set amount \n     (Rotation is clockwise for positive and counter clockwise for negative rotation values)\n";
-			std::cout << "(2) Frequency Player: Plays winning move against most frequently played\n     opponent move; always beats fixed player\n";
-			std::cout << "(3) Anti Rotation Player: Assuming opponent is a rotation player,\n     figures out opponent rotation and plays winning move against it\n";
-			std::cout << "(4) Human Player: Plays whatever you tell it to; your chance to prove\n     our carbon-based superiority!\n";
-			std::cout << "(5) Random Player: Plays uniformly distributed random moves;\n     unpredictable (except if you know the seed)!\n";
-			std::cout << "(6) Meta Player: Smart player that chooses the best strategy\n     against its opponent; will win against Players 1-3 and 7\n";
-			std::cout << "(7) Random Strategy Player: Chooses between strategies 0-3 and applies\n     a rotation between 0 and 2; frequently switches strategy and rotation\n";
-			std::cout << "\nChoose Strategy (0-7): ";
-
-			while (true) { // Choose Player 1
-				try {
-					p1 = input_exception_handler<int>();
-					if (p1 < 0 or p1 > 7) throw std::domain_error{ "You have to choose between Strategy 0 and 7!" };
-				}
-				catch (std::exception& e) {
-					std::cout << "\nError: " << e.what() << "\n\n";
-					continue;
-				}
-				break;
-			}
-
-			// Depending on player type, different initialization variables are needed, so call configure_player(), then setup_player()
-			configure_player(p1);
-			player1 = setup_player(p1);
-
-			while (true) { // Choose Player 2
-				std::cout << "\n\nChoose Player 2 (0-7): ";
-				try {
-					p2 = input_exception_handler<int>();
-					if (p2 > 7 or p2 < 0) throw std::range_error{ "You have to choose between Strategy 0 and 7!" };
-				}
-				catch (std::exception& e) {
-					std::cout << "\nError: " << e.what() << "\n\n";
-					continue;
-				}
-				break;
-			}
-
-			configure_player(p2);
-			player2 = setup_player(p2);
-
-
-			while (true) { // Set number of game rounds
-				std::cout << "\n\nChoose number of rounds to play: ";
-				try {
-					rounds = input_exception_handler<int>();
-					if (rounds < 0) throw std::domain_error{ "Number of rounds has to be larger than 0!" };
-				}
-				catch (std::exception& e) {
-					std::cout << "\nError: " << e.what() << "\n\n";
-					continue;
-				}
-				break;
-			}
-
-			// Print final setup
-			std::cout << "\n\n----------------\n\n";
-			std::cout << "Your game set up:\n\n\n";
-			print_setup(p1, 1, player1);
-			std::cout << "\n\n            vs            \n\n";
-			print_setup(p2, 2, player2);
-			std::cout << "\n\n\nPlaying " << rounds << " rounds";
-			std::cout << "\n\n----------------\n\n";
-			std::cout << "Do you want to continue with this setup or reconfigure your settings (0: reconfigure, 1: continue)? ";
-
-			// Choice to reconfigure or play
-			user_flag = input_exception_handler<bool>();
-
-			if (!user_flag) {
-				delete player1, player2;
-				continue;
-			}
-			else break;
-		}
-
-		std::cout << "\n\nBefore starting the game, you can set a delay in milliseconds between \ngame rounds";
-		std::cout << " (not recommended for large number of rounds; set to 0 for no extra delay): ";
-
-		while (true) { // Set delay
-			try {
-				round_delay = input_exception_handler<int>();
-				if (round_delay < 0) throw std::domain_error{ "Delay has to be larger than 0!" };
-			}
-			catch (std::exception& e) {
-				std::cout << "Error: " << e.what() << std::endl;
-				continue;
-			}
-			break;
-		}
-
-		Game this_game{ *player1, *player2, rounds , round_delay }; // Init Game
-
-
-		std::cout << "\n\n----------------\n----------------\n\nGame starts!\n\n";
-
-		this_game.play(); // Play
-
-		delete player1, player2; // Delete dynamic player objects
-
-		// choice to save game data
-		std::cout << "\n\nDo you want to save the current win and move histories to a file (0=no, 1=yes)? ";
-		user_flag = input_exception_handler<bool>();
-
-		if (user_flag) { // Save game
-			while (true) {
-				try {
-					std::cout << "\n\nSpecify a path to save game data: ";
-					save_path = input_exception_handler<std::string>();
-					std::cout << "\nFile name (file extension .csv is automatic): ";
-					f_name = input_exception_handler<std::string>();
-
-					std::cout << save_path;
-					if (this_game.save(save_path, f_name)) break;
-					else throw std::runtime_error{ "Something went wrong while saving your game data." };
-				}
-				catch (std::exception& e) {
-					std::cout << "\nAn Error occured while saving game data: " << e.what();
-					std::cout << "\nTry another path and make sure to only include alphanumeric characters or cancel (0: cancel, 1: try again): ";
-					user_flag = input_exception_handler<bool>();
-					if (user_flag) continue;
-					else break;
-				}
-				break;
-			}
-			std::cout << "\n\nSuccessfully saved game data to " << save_path + "\\" + f_name + ".csv" << std::endl;
-
-		}
-
-		// Exit or continue with new game
-		std::cout << "\n\n----------------\n\nDo you want to set up another game or exit (0: exit; 1: new game)? ";
-
-		user_flag = input_exception_handler<bool>();
-
-		if (!user_flag) {
-			break;
-		}
-		else {
-			reset_config(); // reset control flags for next game
-			continue;
-		}
-	}
-
-	return 0;
-
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <limits>
+#include <fstream>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <Pfad_zu/RPS_Header.h>
+#include <Pfad_zu/RPS_Plugin.h>
+#include <Pfad_zu/RPS_Cache.h>
+#include <Pfad_zu/RPS_Evolution.h>
+#include <Pfad_zu/RPS_Plot.h>
+#include <Pfad_zu/RPS_Archive.h>
+#include <Pfad_zu/RPS_Query.h>
+#include <Pfad_zu/RPS_Scheduler.h>
+#include <Pfad_zu/RPS_Batch.h>
+#include <Pfad_zu/RPS_Backtest.h>
+#include <Pfad_zu/RPS_Perf.h>
+#include <Pfad_zu/RPS_Markov.h>
+#include <Pfad_zu/RPS_Script.h>
+#include <Pfad_zu/RPS_Workers.h>
+#include <Pfad_zu/RPS_Trace.h>
+#include <Pfad_zu/RPS_Cyclic.h>
+#include <Pfad_zu/RPS_Profile.h>
+#include <Pfad_zu/RPS_Adversary.h>
+#include <Pfad_zu/RPS_Workload.h>
+#define RPS_ALLOC_HOOK // this program counts its allocations (see RPS_Alloc.h)
+#include <Pfad_zu/RPS_Alloc.h>
+
+
+//// Game & Player config variables
+int p1{}, p2{};
+long long rounds{};
+char fix_init{ 'R' };
+short rot_init_1{}, rot_init_2{};
+int rand_seed_1{}, rand_seed_2{};
+int meta_scoring_func_1{}, meta_scoring_func_2{};
+double scoring_array_1[6]{}, scoring_array_2[6]{};
+double default_mul_scoring_array[6]{ 0.95, 1.1, 0.9, 1, 10, 1 };
+int round_delay{};
+
+// Bunch of control flags for program flow
+bool user_flag{};
+bool set_flag_rand_seed_1{}, set_flag_rand_seed_2{}, set_flag_rot_init_1{}, set_flag_rot_init_2{}, \
+set_flag_meta_scoring_func_1{}, set_flag_meta_scoring_func_2{}, set_flag_scoring_array_1{}, \
+set_flag_scoring_array_2{}, set_flag_user_name_1{}, set_flag_user_name_2{}, \
+set_flag_no_seed_1{}, set_flag_no_seed_2{};
+bool set_flag_print_rot_init{}, set_flag_print_rand_seed{}, set_flag_print_meta_scoring_func{}, set_flag_print_score_array{};
+
+std::string user_name_1{ "" }, user_name_2{ "" };
+std::string save_path{}, f_name{};
+const std::vector<std::string> scoring_funcs{ "multiplicative", "additive", "multiplicative drop switch", "additive drop switch", "default multiplicative" };
+
+// Strategy plugins (see RPS_Plugin.h) are loaded from plugin_dir at startup and listed after the built-in strategies 0-7
+const int num_builtin_strategies{ 8 };
+std::string plugin_dir{ "plugins" };
+std::vector<std::shared_ptr<Plugin_Library>> plugins{};
+bool meta_plugins_1{}, meta_plugins_2{}; // whether Meta Player 1/2 consults loaded plugins as additional oracles
+
+// Strategy scripts (see RPS_Script.h) are compiled from script_dir at startup and listed after the plugins
+std::string script_dir{ "Strategies" }; // example scripts are shipped there
+std::vector<std::shared_ptr<Script_Strategy>> scripts{};
+bool meta_scripts_1{}, meta_scripts_2{}; // whether Meta Player 1/2 consults loaded scripts as additional oracles
+
+// Meta Players with additional oracles may consult them in parallel (see Meta_Player_Naive::set_oracle_pool()); created on first use
+std::unique_ptr<Fork_Join_Pool> oracle_pool{};
+
+// is_script() returns true if strategy number p is a strategy script
+bool is_script(int p) {
+	return p >= num_builtin_strategies + (int)plugins.size();
+}
+
+// Results of reproducible games are cached in cache_dir (see RPS_Cache.h)
+std::string cache_dir{ "rps_cache" };
+
+
+
+
+// flush_cin() clears iostream stream buffer in case of bad input
+void flush_cin() {
+	std::cin.clear();
+	std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+}
+
+// input_exception_handler() wraps exception handling and stream buffer clearing around std::cin >> target_variable 
+template<typename T>
+T input_exception_handler(std::string err_msg = "Invalid input!") {
+	T target{};
+	while (true) {
+		try {
+			std::cin >> target;
+			if (!std::cin) throw std::runtime_error{ err_msg };
+		}
+		catch (std::exception& e) {
+			std::cout << "\nError: " << e.what() << "\n\n";
+			flush_cin();
+			continue;
+		}
+		flush_cin();
+		break;
+	}
+	return target;
+}
+
+
+// Sets up player variables based on user input
+void configure_player(int p) {
+	auto scoring_array_ptr = (set_flag_scoring_array_1 ? scoring_array_2 : scoring_array_1);// points to first or second scoring array based on truth value of set_flag_scoring_array_1
+																						    // --> will choose second scoring array if first has already been set
+	switch (p) {
+	case 0: // Fixed Player
+		std::cout << "\n\nChoose Fixed Player move shape (R for Rock, P for Paper, S for Scissors): ";
+		while (true) {
+			try {
+				fix_init = input_exception_handler<char>();
+				if (!(fix_init == 'R' or fix_init == 'P' or fix_init == 'S')) throw std::domain_error{ "Fixed shape has to be R, P or S!" };
+			}
+			catch (std::exception& e) {
+				std::cout << "\nError: " << e.what() << "\n\n";
+				continue;
+			}
+			break;
+		}
+		break;
+	case 1: // Rotation Player
+		std::cout << "\n\nChoose Rotation Player rotation (0-2; will use Euclidian modulo for negative or larger than 2 numbers): ";
+		if (!set_flag_rot_init_1) { // if first rotation player
+			rot_init_1 = input_exception_handler<short>();
+			set_flag_rot_init_1 = true;
+		}
+		else { // if second rotation player
+			rot_init_2 = input_exception_handler<short>();
+			set_flag_rot_init_2 = true;
+		}
+		break;
+	case 2: // Frequency Player
+		break;
+	case 3: // Anti Rotation Player
+		break;
+	case 4: // Human Player
+		std::cout << "\nYour name: ";
+		if (!set_flag_user_name_1) { // if first human player
+			user_name_1 = input_exception_handler<std::string>();
+			set_flag_user_name_1 = true;
+		}
+		else { // if second human player
+			user_name_2 = input_exception_handler<std::string>();
+			set_flag_user_name_2 = true;
+		}
+		break;
+	case 5: // Random Player
+		std::cout << "\nDo you want to use a seed for Random Player's RNG (1=yes, 0=no)? ";
+		user_flag = input_exception_handler<bool>();
+
+		if (user_flag) {// if seed is put in
+			std::cout << "\nSeed: ";
+			if (!set_flag_rand_seed_1) { // if first random player
+				rand_seed_1 = input_exception_handler<int>();
+				set_flag_rand_seed_1 = true;
+			}
+			else { // if second random player
+				rand_seed_2 = input_exception_handler<int>();
+				set_flag_rand_seed_2 = true;
+			}
+		}
+		else {// if no seed is put in
+			if (!set_flag_rand_seed_1) { // if first random player
+				set_flag_no_seed_1 = true; // random player will be initialised without seed -> pseudo random seed
+				set_flag_rand_seed_1 = true;
+			}
+			else { // if second random player
+				set_flag_no_seed_2 = true; // random player will be initialised without seed -> pseudo random seed
+				set_flag_rand_seed_2 = true;
+			}
+		}
+		break;
+	case 6: // Meta Player
+		std::cout << "\n\nMeta Player needs a scoring funtion, and scoring function needs a scoring vector. Choose from the following scoring functions:\n\n";
+		std::cout << "(0) Multiplicative scoring function: Multiplies Meta Player scores by values in scoring vector\n";
+		std::cout << "(1) Additive scoring function: Adds values in scoring vector to Meta Player scores\n";
+		std::cout << "(2) Multiplicative drop switch: Multipies Meta Player scores by values in scoring vector in case of win or draw; in case of loss sets score to 3rd value in scoring vector\n";
+		std::cout << "(3) Additive drop switch: Adds values in scoring vector to Meta Player scores in case of win or draw; in case of loss sets score to 3rd value in scoring vector\n";
+		std::cout << "(4) Default scoring function: multiplicative with scoring vector {0.95 (draw), 1.1 (win), 0.9 (loss), 1 (floor), 10 (ceil), 1 (decay)}\n\n";
+		std::cout << "Choose one of the scoring functions above or put in 4 for default scoring function: ";
+		while (true) {
+			try {
+				if (!set_flag_meta_scoring_func_1) { // if first meta player
+					meta_scoring_func_1 = input_exception_handler<int>();
+					if (meta_scoring_func_1 < 0 or meta_scoring_func_1 > 4) throw std::range_error{ "You have to choose between 0 and 4!" };
+					set_flag_meta_scoring_func_1 = true;
+				}
+				else { // if second meta player
+					meta_scoring_func_2 = input_exception_handler<int>();
+					set_flag_meta_scoring_func_2 = true;
+				}
+				if (meta_scoring_func_2 < 0 or meta_scoring_func_2 > 4) throw std::range_error{ "You have to choose between 0 and 4!" };
+			}
+			catch (std::exception& e) {
+				std::cout << "\nError: " << e.what() << "\n\n";
+				continue;
+			}
+			break;
+		}
+		switch ((set_flag_meta_scoring_func_2 ? meta_scoring_func_2 : meta_scoring_func_1)) { // choosing scoring function
+		case 0: // Multiplicative Scoring Function
+			std::cout << "\n\nMultiplicative scoring function needs a scoring vector.\n";
+			std::cout << "You will successively put in the constants that build up the scoring vector:\n\n";
+			std::cout << "Set Draw Multiplier (score of any meta strategy will be multiplied by this value in case of draw): ";
+			*(scoring_array_ptr + 0) = input_exception_handler<double>(); // write either to scoring array_1 or scoring_array_2
+			std::cout << "Set Win Multiplier (score of any meta strategy will be multiplied by this value in case of win): ";
+			*(scoring_array_ptr + 1) = input_exception_handler<double>();
+			std::cout << "Set Loss Multiplier (score of any meta strategy will be multiplied by this value in case of loss): ";
+			*(scoring_array_ptr + 2) = input_exception_handler<double>();
+			std::cout << "Set score floor (score of any meta strategy can never be smaller than this value): ";
+			*(scoring_array_ptr + 3) = input_exception_handler<double>();
+			std::cout << "Set score ceiling (score of any meta strategy can never be larger than this value): ";
+			*(scoring_array_ptr + 4) = input_exception_handler<double>();
+			std::cout << "Set score decay (every score will get multiplied by this constant regardless of outcome): ";
+			*(scoring_array_ptr + 5) = input_exception_handler<double>();
+			if (!set_flag_scoring_array_1) set_flag_scoring_array_1 = true;
+			else set_flag_scoring_array_2 = true;
+			break;
+		case 1: // Additive scoring function
+			std::cout << "\n\nAdditive scoring function needs a scoring vector.\n";
+			std::cout << "You will successively put in the constants that build up the scoring vector:\n\n";
+			std::cout << "Set Draw Constant (this value will be added to score of any meta strategy in case of draw): ";
+			*(scoring_array_ptr + 0) = input_exception_handler<double>();
+			std::cout << "Set Win Constant (this value will be added to score of any meta strategy in case of win): ";
+			*(scoring_array_ptr + 1) = input_exception_handler<double>();
+			std::cout << "Set Loss Constant (this value will be added to score of any meta strategy in case of loss): ";
+			*(scoring_array_ptr + 2) = input_exception_handler<double>();
+			std::cout << "Set score floor (score of any meta strategy can never be smaller than this value): ";
+			*(scoring_array_ptr + 3) = input_exception_handler<double>();
+			std::cout << "Set score ceiling (score of any meta strategy can never be larger than this value): ";
+			*(scoring_array_ptr + 4) = input_exception_handler<double>();
+			std::cout << "Set score decay (every score will get multiplied by this constant regardless of outcome): ";
+			*(scoring_array_ptr + 5) = input_exception_handler<double>();
+			if (!set_flag_scoring_array_1) set_flag_scoring_array_1 = true;
+			else set_flag_scoring_array_2 = true;
+			break;
+		case 2: // Multiplicative drop switch
+			std::cout << "\n\nMultiplicative drop switch needs a scoring vector.\n";
+			std::cout << "You will successively put in the constants that build up the scoring vector:\n\n";
+			std::cout << "Set Draw Multiplier (score of any meta strategy will be multiplied by this value in case of draw): ";
+			*(scoring_array_ptr + 0) = input_exception_handler<double>();
+			std::cout << "Set Win Multiplier (score of any meta strategy will be multiplied by this value in case of win): ";
+			*(scoring_array_ptr + 1) = input_exception_handler<double>();
+			std::cout << "Set Loss Value (score of any meta strategy will be set to this value in case of loss): ";
+			*(scoring_array_ptr + 2) = input_exception_handler<double>();
+			std::cout << "Set score floor (score of any meta strategy can never be smaller than this value): ";
+			*(scoring_array_ptr + 3) = input_exception_handler<double>();
+			std::cout << "Set score ceiling (score of any meta strategy can never be larger than this value): ";
+			*(scoring_array_ptr + 4) = input_exception_handler<double>();
+			std::cout << "Set score decay (every score will get multiplied by this constant regardless of outcome): ";
+			*(scoring_array_ptr + 5) = input_exception_handler<double>();
+			if (!set_flag_scoring_array_1) set_flag_scoring_array_1 = true;
+			else set_flag_scoring_array_2 = true;
+			break;
+		case 3: // Additive drop switch
+			std::cout << "\n\nAdditive drop switch needs a scoring vector.\n";
+			std::cout << "You will successively put in the constants that build up the scoring vector:\n\n";
+			std::cout << "Set Draw Constant (this value will be added to score of any meta strategy in case of draw): ";
+			*(scoring_array_ptr + 0) = input_exception_handler<double>();
+			std::cout << "Set Win Constant (this value will be added to score of any meta strategy in case of win): ";
+			*(scoring_array_ptr + 1) = input_exception_handler<double>();
+			std::cout << "Set Loss Constant (score of any meta strategy will be set to this value in case of loss): ";
+			*(scoring_array_ptr + 2) = input_exception_handler<double>();
+			std::cout << "Set score floor (score of any meta strategy can never be smaller than this value): ";
+			*(scoring_array_ptr + 3) = input_exception_handler<double>();
+			std::cout << "Set score ceiling (score of any meta strategy can never be larger than this value): ";
+			*(scoring_array_ptr + 4) = input_exception_handler<double>();
+			std::cout << "Set score decay (every score will get multiplied by this constant regardless of outcome): ";
+			*(scoring_array_ptr + 5) = input_exception_handler<double>();
+			if (!set_flag_scoring_array_1) set_flag_scoring_array_1 = true;
+			else set_flag_scoring_array_2 = true;
+			break;
+		case 4: // Default Multiplicative Scoring Function (uses default scoring array)
+			for (int i{}; i < 6; i += 1) {
+				*(scoring_array_ptr + i) = default_mul_scoring_array[i]; // copy default scoring array to current array (if default was chosen); just for printing
+																		 // because if default, random player will be initialised with default scoring array, 
+																		 // not with scoring array_1 or scoring_array_2
+			}
+			if (!set_flag_scoring_array_1) set_flag_scoring_array_1 = true;
+			else set_flag_scoring_array_2 = true;
+			break;
+		}
+		break;
+	case 7: // Random Strategy Player
+		break;
+	default: // Plugin or script Player (no configuration needed)
+		break;
+	}
+
+	// Meta Players can add every loaded plugin to their strategy repertoire
+	if (p == 6 and !plugins.empty()) {
+		std::cout << "\nAdd the " << plugins.size() << " loaded plugin strategies to Meta Player's repertoire (1=yes, 0=no)? ";
+		(set_flag_meta_scoring_func_2 ? meta_plugins_2 : meta_plugins_1) = input_exception_handler<bool>();
+	}
+	if (p == 6 and !scripts.empty()) {
+		std::cout << "\nAdd the " << scripts.size() << " loaded strategy scripts to Meta Player's repertoire (1=yes, 0=no)? ";
+		(set_flag_meta_scoring_func_2 ? meta_scripts_2 : meta_scripts_1) = input_exception_handler<bool>();
+	}
+}
+
+// Prints current player setup after configuration is complete but before playing the game; main() gives option to reconfigure
+void print_setup(int p, int p_num, Player* player) {
+	std::cout << "Player " << p_num << " : ";
+	auto scoring_array_ptr = (set_flag_print_score_array ? scoring_array_2 : scoring_array_1);
+
+	switch (p) {
+	case 0: // Fixed Player
+		std::cout << player->get_name();
+		break;
+	case 1: // Rotation Player
+		std::cout << player->get_name();
+		std::cout << " (Rotation by " << (set_flag_print_rot_init ? rot_init_2 : rot_init_1) << ")\n";
+		set_flag_print_rot_init = true;
+		break;
+	case 2: // Frequency Player
+		std::cout << player->get_name();
+		break;
+	case 3: // Anti Rotation Player
+		std::cout << player->get_name();
+		break;
+	case 4: // Human Player
+		std::cout << player->get_name();
+		break;
+	case 5: // Random Player
+		std::cout << player->get_name();
+		if (!set_flag_print_rand_seed and set_flag_no_seed_1) {
+			std::cout << " (no seed)";
+		}
+		else if (set_flag_print_rand_seed and set_flag_no_seed_2) {
+			std::cout << " (no seed)";
+		}
+		else {
+			std::cout << " (Seed: " << (set_flag_print_rand_seed ? rand_seed_2 : rand_seed_1) << ")";
+		}
+		set_flag_print_rand_seed = true;
+		break;
+	case 6: // Meta Player
+		std::cout << player->get_name();
+		std::cout << " (scoring array {";
+		for (int i{}; i < 6; i += 1) { // print scoring array associated with meta player
+			std::cout << *(scoring_array_ptr + i) << " ";
+		}
+		std::cout << "})\n";
+		set_flag_print_meta_scoring_func = true;
+		set_flag_print_score_array = true;
+		break;
+	case 7: // Random Strategy Player
+		std::cout << player->get_name();
+		break;
+	default: // Plugin or script Player
+		if (is_script(p)) std::cout << player->get_name() << " (script " << ((Script_Player*)player)->get_path() << ")";
+		else std::cout << player->get_name() << " (plugin " << plugins[p - num_builtin_strategies]->get_path() << ")";
+		break;
+	}
+
+}
+
+// Initializes Player objects based on configuration
+Player* setup_player(int p) {
+	Player* player{};
+	auto scoring_array_ptr = (set_flag_scoring_array_2 ? &scoring_array_2 : &scoring_array_1);
+	switch (p) {
+	case 0: // Fixed Player
+		player = new Fixed{ fix_init };
+		break;
+	case 1: // Rotation Player
+		if (!set_flag_rot_init_2) player = new Rotation{ rot_init_1 };
+		else player = new Rotation{ rot_init_2 };
+		break;
+	case 2: // Frequency Player
+		player = new Frequency{};
+		break;
+	case 3: // Anti Rotation Player
+		player = new Anti_Rotation{};
+		break;
+	case 4: // Human Player
+		if (!set_flag_user_name_2) player = new Human{ user_name_1 };
+		else player = new Human{ user_name_2 };
+		break;
+	case 5: // Random Player
+		if (!set_flag_rand_seed_2 and set_flag_no_seed_1) {
+			player = new Random{};
+		}
+		else if (set_flag_rand_seed_2 and set_flag_no_seed_2) {
+			player = new Random{};
+		}
+		else if (!set_flag_rand_seed_2 and !set_flag_no_seed_1) {
+			player = new Random{ rand_seed_1 };
+		}
+		else if (set_flag_rand_seed_2 and !set_flag_no_seed_2) {
+			player = new Random{ rand_seed_2 };
+		}
+		break;
+	case 6: // Meta Player
+		switch ((set_flag_meta_scoring_func_2 ? meta_scoring_func_2 : meta_scoring_func_1)) {
+		case 0: // Multiplicative Scoring Function
+			player = new Meta_Player_Naive{ false, scoring_funcs[0], naive_score_mul, *scoring_array_ptr };
+			break;
+		case 1: // Additive scoring function
+			player = new Meta_Player_Naive{ false, scoring_funcs[1], naive_score_add, *scoring_array_ptr };
+			break;
+		case 2: // Multiplicative drop switch
+			player = new Meta_Player_Naive{ false, scoring_funcs[2], drop_switch_mul, *scoring_array_ptr };
+			break;
+		case 3: // Additive drop switch
+			player = new Meta_Player_Naive{ false, scoring_funcs[3], drop_switch_add, *scoring_array_ptr };
+			break;
+		case 4: // Default Multiplicative Scoring Function (uses default scoring array)
+			player = new Meta_Player_Naive{ false, scoring_funcs[4], naive_score_mul, default_mul_scoring_array };
+			break;
+		}
+		if (set_flag_meta_scoring_func_2 ? meta_plugins_2 : meta_plugins_1) {
+			for (std::shared_ptr<Plugin_Library>& plugin : plugins) {
+				((Meta_Player_Naive*)player)->add_oracle(new Plugin_Player{ plugin });
+			}
+		}
+		if (set_flag_meta_scoring_func_2 ? meta_scripts_2 : meta_scripts_1) {
+			for (std::shared_ptr<Script_Strategy>& script : scripts) {
+				((Meta_Player_Naive*)player)->add_oracle(new Script_Player{ script });
+			}
+		}
+		if (((Meta_Player_Naive*)player)->get_strategy_names().size() > 4 and std::thread::hardware_concurrency() > 1) {
+			if (!oracle_pool) oracle_pool = std::make_unique<Fork_Join_Pool>();
+			((Meta_Player_Naive*)player)->set_oracle_pool(oracle_pool.get());
+		}
+		break;
+	case 7: // Random Strategy Player
+		player = new Meta_Player_Rand_Strat{ false };
+		break;
+	default: // Plugin or script Player
+		if (is_script(p)) player = new Script_Player{ scripts[p - num_builtin_strategies - plugins.size()] };
+		else player = new Plugin_Player{ plugins[p - num_builtin_strategies] };
+		break;
+	}
+	return player;
+}
+
+// Resets all control flags before a new game is played within the same console session; is called by main()
+void reset_config() {
+	set_flag_rand_seed_1 = false; set_flag_rand_seed_2 = false; set_flag_rot_init_1 = false; set_flag_rot_init_2 = false; \
+		set_flag_meta_scoring_func_1 = false; set_flag_meta_scoring_func_2 = false; set_flag_scoring_array_1 = false; \
+		set_flag_scoring_array_2 = false; set_flag_user_name_1 = false; set_flag_user_name_2 = false;
+		set_flag_print_rot_init = false; set_flag_print_rand_seed = false; set_flag_print_meta_scoring_func = false; \
+		set_flag_print_score_array = false; set_flag_no_seed_1 = false; set_flag_no_seed_2 = false;
+		meta_plugins_1 = false; meta_plugins_2 = false; meta_scripts_1 = false; meta_scripts_2 = false;
+
+}
+
+//// Command line tools
+// Besides the interactive console game, batch tools can be started as: Konsolenprogramm <tool> key=value key=value ...
+
+// parse_tool_args() collects key=value arguments following the tool name
+std::map<std::string, std::string> parse_tool_args(int argc, char* argv[]) {
+	std::map<std::string, std::string> args{};
+	for (int i{ 2 }; i < argc; i += 1) {
+		std::string arg{ argv[i] };
+		std::size_t pos = arg.find('=');
+		if (pos == std::string::npos) throw std::invalid_argument{ "Arguments have to be given as key=value (got " + arg + ")" };
+		args[arg.substr(0, pos)] = arg.substr(pos + 1);
+	}
+	return args;
+}
+
+// tool_arg() returns value of argument key converted to T, or default_value if it wasn't given
+template<typename T>
+T tool_arg(const std::map<std::string, std::string>& args, std::string key, T default_value) {
+	auto arg = args.find(key);
+	if (arg == args.end()) return default_value;
+	if constexpr (std::is_same_v<T, std::string>) return arg->second; // strings may contain spaces
+	std::istringstream iss{ arg->second };
+	T value{};
+	if (!(iss >> value)) throw std::invalid_argument{ "Invalid value for " + key + ": " + arg->second };
+	return value;
+}
+
+// evolve: replicator dynamics over the basic strategies (see RPS_Evolution.h)
+int run_evolution(const std::map<std::string, std::string>& args) {
+	Evolution_Config config{};
+	config.population = tool_arg<std::size_t>(args, "population", config.population);
+	config.generations = tool_arg<int>(args, "generations", config.generations);
+	config.rounds_per_match = tool_arg<long long>(args, "rounds", config.rounds_per_match);
+	config.mutation_rate = tool_arg<double>(args, "mutation", config.mutation_rate);
+	config.selection = tool_arg<double>(args, "selection", config.selection);
+	config.seed = tool_arg<std::uint64_t>(args, "seed", config.seed);
+	config.threads = tool_arg<unsigned>(args, "threads", config.threads);
+
+	std::cout << "Evolving " << config.population << " agents for " << config.generations << " generations (" << config.rounds_per_match << " rounds per match)\n\n";
+	Evolution_Simulator simulator{ config };
+	simulator.run(tool_arg<int>(args, "print_every", 10), tool_arg<std::string>(args, "out", ""));
+	return 0;
+}
+
+// archive: lists games of a game archive or extracts one game as CSV (same format as Game::save())
+int run_archive(const std::map<std::string, std::string>& args) {
+	Archive_Reader reader{ tool_arg<std::string>(args, "file", "") };
+	auto game_arg = args.find("game");
+
+	if (game_arg == args.end()) {
+		std::cout << "Game,Rounds,Draws,Wins P1,Wins P2,Player 1,Player 2\n";
+		for (std::uint64_t k{}; k < reader.size(); k += 1) {
+			if (!reader.has_game(k)) continue;
+			Archived_Game game = reader.read_game(k);
+			std::cout << k << "," << game.rounds << "," << game.score[0] << "," << game.score[1] << "," << game.score[2] << "," \
+				<< game.name_p1 << "," << game.name_p2 << "\n";
+		}
+		return 0;
+	}
+
+	Archived_Game game = reader.read_game(tool_arg<std::uint64_t>(args, "game", 0));
+	std::string out = tool_arg<std::string>(args, "out", "");
+	std::ofstream ofs{};
+	if (!out.empty()) {
+		ofs.open(out, std::ofstream::out);
+		if (!ofs.is_open()) throw std::runtime_error{ "Unable to open " + out };
+	}
+	std::ostream& os = (out.empty() ? std::cout : ofs);
+
+	// both streams are decoded side by side, so extracting needs constant memory
+	Move_Stream moves_p1 = reader.stream(game, 0), moves_p2 = reader.stream(game, 1);
+	os << "Move History P1,Move History P2,Win History\n";
+	short m1{}, m2{};
+	while (moves_p1.next(m1) and moves_p2.next(m2)) {
+		os << m1 << "," << m2 << "," << evaluate_round(Move{ m1 }, Move{ m2 }) << "\n";
+	}
+	return 0;
+}
+
+// query: grouped win rates over a directory of saved games (see RPS_Query.h)
+int run_query(const std::map<std::string, std::string>& args) {
+	Game_Query query{ tool_arg<std::string>(args, "dir", "Game_saves"), tool_arg<unsigned>(args, "threads", 0) };
+	query.scan();
+	std::cout << query.size() << " saved games (" << query.files_parsed() << " parsed, " << query.files_cached() << " from cache)\n\n";
+
+	std::map<std::string, Query_Group> groups = query.group(tool_arg<std::string>(args, "by", "player"), tool_arg<std::string>(args, "player", ""));
+	print_query(groups);
+
+	std::string curves = tool_arg<std::string>(args, "curves", "");
+	if (!curves.empty() and !save_query_curves(curves, groups)) throw std::runtime_error{ "Unable to write " + curves };
+	return 0;
+}
+
+// multiplex: plays many bot games (and optionally one interactive game) concurrently on a few threads (see RPS_Scheduler.h)
+int run_multiplex(const std::map<std::string, std::string>& args) {
+	int num_games = tool_arg<int>(args, "games", 1000);
+	long long num_rounds = tool_arg<long long>(args, "rounds", 100);
+	int delay = tool_arg<int>(args, "delay", 10);
+	bool human = tool_arg<bool>(args, "human", false);
+	std::mt19937 engine{ tool_arg<unsigned>(args, "seed", 1) };
+
+	// basic strategies 0-5 (Random with seed) assigned at random
+	auto make_player = [&engine](int strategy) -> Player* {
+		switch (strategy) {
+		case 0: return new Fixed{ shapes[engine() % 3] };
+		case 1: return new Rotation{ (short)(engine() % 3) };
+		case 2: return new Frequency{};
+		case 3: return new Anti_Rotation{};
+		default: return new Random{ (int)(engine() % 1000000) };
+		}
+	};
+	std::vector<std::unique_ptr<Player>> players{};
+	std::vector<std::unique_ptr<Game>> games{};
+	for (int k{}; k < num_games; k += 1) {
+		players.emplace_back(make_player(engine() % 5));
+		players.emplace_back(make_player(engine() % 5));
+		games.push_back(std::make_unique<Game>(*players[players.size() - 2], *players.back(), num_rounds, delay));
+	}
+
+	Scheduler scheduler{ tool_arg<unsigned>(args, "threads", 1) };
+	for (std::unique_ptr<Game>& game : games) scheduler.spawn(play_async(*game, scheduler));
+
+	// interactive game against Meta Player: console input is read by one extra thread and handed to the waiting game. The thread can't be
+	// joined (it may block on std::cin after the game is over), so it shares ownership of the Player and stops once input is closed
+	std::shared_ptr<Async_Human> human_player = std::make_shared<Async_Human>();
+	Meta_Player_Naive meta{ false, "", naive_score_mul, default_mul_scoring_array };
+	Game human_game{ *human_player, meta, num_rounds };
+	if (human) {
+		scheduler.spawn(play_async(human_game, scheduler, true, true));
+		std::thread{ [input = human_player]() {
+			short move{};
+			while (std::cin >> move and !input->input_closed()) {
+				if (move < 0 or move > 2) std::cout << "Error: Move shape must be 0 (Rock), 1 (Paper) or 2 (Scissors).\n";
+				else input->provide_input(move);
+			}
+			input->close_input();
+		} }.detach();
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	scheduler.run();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	human_player->close_input(); // game is over, the reading thread stops at its next input
+
+	std::map<std::string, Round_Stats> wins{}; // strategy -> merged stats of its games, seen from the strategy (outcome 1: it won)
+	for (std::unique_ptr<Game>& game : games) {
+		const Round_Stats& stats = game->get_stats();
+		wins[game->player(0).get_name()].merge(stats);
+		wins[game->player(1).get_name()].merge(stats.swapped());
+	}
+	std::cout << "\n" << num_games << " games of " << num_rounds << " rounds (" << delay << " ms delay per round) finished in " << seconds << " s\n\n";
+	std::cout << "Strategy,Win Rate\n";
+	for (const auto& [name, stats] : wins) std::cout << name << "," << stats.rate(1) << "\n";
+	return 0;
+}
+
+// batch: plays many games between two batched strategies in lockstep (see RPS_Batch.h)
+int run_batch(const std::map<std::string, std::string>& args) {
+	std::unique_ptr<Batch_Strategy> s1 = make_batch_strategy(tool_arg<std::string>(args, "p1", "Meta"));
+	std::unique_ptr<Batch_Strategy> s2 = make_batch_strategy(tool_arg<std::string>(args, "p2", "Random(1)"));
+	std::size_t num_games = tool_arg<std::size_t>(args, "games", 10000);
+	long long num_rounds = tool_arg<long long>(args, "rounds", 1000);
+
+	Batch_Game batch{ *s1, *s2, num_games, num_rounds };
+	auto start = std::chrono::steady_clock::now();
+	batch.play();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	Round_Stats total = batch.total();
+	std::cout << num_games << " games of " << num_rounds << " rounds: " << s1->get_name() << " vs " << s2->get_name() << " (" << seconds << " s)\n\n";
+	std::cout << "Win Rate " << s1->get_name() << " : " << total.rate(1) * 100 << "%\n";
+	std::cout << "Win Rate " << s2->get_name() << " : " << total.rate(2) * 100 << "%\n";
+	std::cout << "Draw Rate : " << total.rate(0) * 100 << "%\n";
+	return 0;
+}
+
+// backtest: candidate strategies against recorded opponent moves of saved games or an archive (see RPS_Backtest.h)
+int run_backtest_tool(const std::map<std::string, std::string>& args) {
+	std::vector<std::string> candidates{};
+	std::istringstream iss{ tool_arg<std::string>(args, "candidates", "Meta Frequency Anti_Rotation Rotation(0) Rotation(1) Rotation(2)") };
+	for (std::string candidate{}; iss >> candidate;) candidates.push_back(candidate); // separated by spaces
+
+	std::vector<Backtest_Sequence> corpus = load_backtest_corpus(tool_arg<std::string>(args, "corpus", "Game_saves"), tool_arg<int>(args, "side", 2));
+	long long corpus_rounds{};
+	for (const Backtest_Sequence& sequence : corpus) corpus_rounds += (long long)sequence.moves.size();
+
+	auto start = std::chrono::steady_clock::now();
+	Backtest_Result result = run_backtest(candidates, corpus, tool_arg<unsigned>(args, "threads", 0));
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << candidates.size() << " candidates x " << corpus.size() << " recorded sequences (" << corpus_rounds << " rounds) in " << seconds << " s\n\n";
+	std::cout << "Candidate,Win Rate,Draw Rate,Loss Rate\n";
+	for (std::size_t c{}; c < candidates.size(); c += 1) {
+		Round_Stats total = result.total(c);
+		std::cout << candidates[c] << "," << total.rate(1) << "," << total.rate(0) << "," << total.rate(2) << "\n";
+	}
+
+	std::string out = tool_arg<std::string>(args, "out", "");
+	if (!out.empty() and !result.save(out)) throw std::runtime_error{ "Unable to write " + out };
+	return 0;
+}
+
+// sweep: every pair of batched strategies, games split into units played by worker processes (see RPS_Workers.h)
+int run_sweep(const std::map<std::string, std::string>& args) {
+	std::vector<std::string> strategies{};
+	std::istringstream iss{ tool_arg<std::string>(args, "strategies", "Meta Frequency Anti_Rotation Rotation(1) Random(1)") };
+	for (std::string strategy{}; iss >> strategy;) strategies.push_back(strategy); // separated by spaces
+
+	Process_Sweep sweep{ strategies, tool_arg<std::size_t>(args, "games", 1000), tool_arg<long long>(args, "rounds", 1000), tool_arg<std::size_t>(args, "unit", 256) };
+	sweep.set_crash_unit(tool_arg<long long>(args, "crash", -1));
+	unsigned workers = tool_arg<unsigned>(args, "workers", 0);
+	if (workers == 0) workers = std::max(std::thread::hardware_concurrency(), 1u);
+
+	auto start = std::chrono::steady_clock::now();
+	sweep.run(workers);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "\n" << sweep.get_matchups().size() << " matchups in " << sweep.get_units() << " units on " << workers << " worker processes (" << seconds << " s)";
+	std::cout << ", " << sweep.get_reissued() << " units re-issued, " << sweep.get_failed() << " failed\n\n";
+	std::cout << "Player 1,Player 2,Draws,Wins P1,Wins P2\n";
+	for (const Sweep_Matchup& matchup : sweep.get_matchups()) {
+		std::cout << matchup.p1 << "," << matchup.p2 << "," << matchup.stats.get_score(0) << "," << matchup.stats.get_score(1) << "," << matchup.stats.get_score(2) << "\n";
+	}
+	return (sweep.get_failed() ? 1 : 0);
+}
+
+// perf: hardware counters per get_move() of every built-in bot strategy against a seeded Random Player (see RPS_Perf.h)
+int run_perf(const std::map<std::string, std::string>& args) {
+	long long num_rounds = tool_arg<long long>(args, "rounds", 10000);
+	long long sample_every = tool_arg<long long>(args, "sample", 1);
+
+	std::vector<std::unique_ptr<Player>> strategies{};
+	strategies.emplace_back(new Fixed{ 'R' });
+	strategies.emplace_back(new Rotation{ 1 });
+	strategies.emplace_back(new Frequency{});
+	strategies.emplace_back(new Anti_Rotation{});
+	strategies.emplace_back(new Random{ 2 });
+	strategies.emplace_back(new Meta_Player_Naive{ false, "", naive_score_mul, default_mul_scoring_array });
+	strategies.emplace_back(new Meta_Player_Rand_Strat{});
+
+	std::vector<Perf_Row> rows{};
+	Perf_Row evaluate{ "evaluate" }, output{ "output" };
+	std::vector<Alloc_Row> alloc_rows{};
+	Alloc_Row alloc_evaluate{ "evaluate" }, alloc_output{ "output" }, alloc_round{ "round" };
+	std::unique_ptr<Perf_Profiler> profiler{};
+	for (std::unique_ptr<Player>& strategy : strategies) {
+		Random opponent{ tool_arg<int>(args, "seed", 1) };
+		Game game{ *strategy, opponent, num_rounds };
+		profiler = std::make_unique<Perf_Profiler>(sample_every);
+		Alloc_Profiler allocs{ profiler.get() }; // allocations of every round, counters of every sample_every-th
+		game.set_profiler(&allocs);
+
+		game.begin_play();
+		for (long long i{}; i < num_rounds; i += 1) {
+			Move next_move_p1 = game.next_move(0);
+			Move next_move_p2 = game.next_move(1);
+			game.play_round(i, next_move_p1, next_move_p2);
+		}
+
+		rows.push_back({ "get_move " + strategy->get_name(), profiler->get_stats(Game_Phase::move_p1) });
+		for (auto [row, phase] : { std::pair{ &evaluate, Game_Phase::evaluate }, std::pair{ &output, Game_Phase::output } }) {
+			const Perf_Stats& s = profiler->get_stats(phase);
+			row->stats.calls += s.calls;
+			row->stats.nanoseconds += s.nanoseconds;
+			for (int e{}; e < num_perf_events; e += 1) row->stats.counts[e] += s.counts[e];
+		}
+		allocs.finish();
+		alloc_rows.push_back({ "get_move " + strategy->get_name(), allocs.get_stats(Game_Phase::move_p1) });
+		alloc_evaluate.stats.add(allocs.get_stats(Game_Phase::evaluate));
+		alloc_output.stats.add(allocs.get_stats(Game_Phase::output));
+		alloc_round.stats.add(allocs.get_round_stats());
+	}
+	rows.push_back(evaluate);
+	rows.push_back(output);
+	alloc_rows.push_back(alloc_evaluate);
+	alloc_rows.push_back(alloc_output);
+	alloc_rows.push_back(alloc_round);
+
+	std::cout << strategies.size() << " strategies, " << num_rounds << " rounds each against Random Player (every " << sample_every << ". round measured)\n";
+	print_perf_report(rows, profiler->get_counters());
+	print_alloc_report(alloc_rows);
+	return 0;
+}
+
+// markov: exact expected results of a matchup from the joint Markov chain of both players (see RPS_Markov.h)
+int run_markov(const std::map<std::string, std::string>& args) {
+	std::unique_ptr<Player> player1 = make_markov_player(tool_arg<std::string>(args, "p1", "Meta_Player_Rand_Strat"));
+	std::unique_ptr<Player> player2 = make_markov_player(tool_arg<std::string>(args, "p2", "Fixed(R)"));
+	long long num_rounds = tool_arg<long long>(args, "rounds", 100);
+	Markov_Analyzer analyzer{ *player1, *player2, tool_arg<std::size_t>(args, "max_states", 1 << 20) };
+	const std::string outcomes[3]{ "Draws", "Wins " + player1->get_name(), "Wins " + player2->get_name() };
+
+	auto start = std::chrono::steady_clock::now();
+	Markov_Horizon horizon = analyzer.finite_horizon(num_rounds);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << player1->get_name() << " vs " << player2->get_name() << ", " << num_rounds << " rounds (up to " << horizon.max_states << " joint states, " << seconds << " s";
+	std::cout << (horizon.approximate ? ", approximate)\n\n" : ")\n\n");
+	std::cout << "Outcome,Expected,Standard Deviation,Rate\n";
+	for (int k{}; k < 3; k += 1) {
+		std::cout << outcomes[k] << "," << horizon.expected[k] << "," << std::sqrt(horizon.variance[k]) << "," << horizon.expected[k] / (double)std::max(num_rounds, 1ll) << "\n";
+	}
+
+	// the long run needs every reachable joint state at once, which may be too many; approximate results went through states in which a
+	// Player lumps histories (e.g. Frequency's count differences above 64)
+	try {
+		start = std::chrono::steady_clock::now();
+		Markov_Stationary stationary = analyzer.stationary();
+		seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "\nLong run (" << stationary.states << " joint states, " << stationary.closed_classes << " closed class(es), " << seconds << " s";
+		std::cout << (stationary.converged ? "" : ", not converged") << (stationary.approximate ? ", approximate)\n\n" : ")\n\n");
+		std::cout << "Outcome,Rate,Variance per Round\n";
+		for (int k{}; k < 3; k += 1) std::cout << outcomes[k] << "," << stationary.rate[k] << "," << stationary.variance_rate[k] << "\n";
+	}
+	catch (std::length_error& e) {
+		std::cout << "\nNo long run solution: " << e.what() << "\n";
+	}
+	return 0;
+}
+
+// cyclic: one game of a cyclic game with K shapes (see RPS_Cyclic.h); every supported K is compiled separately
+template<int K>
+int run_cyclic(const std::map<std::string, std::string>& args) {
+	std::unique_ptr<Cyclic_Player<K>> player1 = make_cyclic_player<K>(tool_arg<std::string>(args, "p1", "Meta"));
+	std::unique_ptr<Cyclic_Player<K>> player2 = make_cyclic_player<K>(tool_arg<std::string>(args, "p2", "Rotation(1)"));
+	long long num_rounds = tool_arg<long long>(args, "rounds", 1000);
+
+	Cyclic_Game<K> game{ *player1, *player2, num_rounds };
+	game.set_keep_histories(false); // bounded histories if both strategies allow them (e.g. Frequency only needs move counts)
+	std::cout << K << " shapes (";
+	for (int i{}; i < K; i += 1) std::cout << (i ? ", " : "") << Cyclic_Rules<K>::shape(i) << " " << Cyclic_Rules<K>::shape_name(i);
+	std::cout << "), " << num_rounds << " rounds: " << player1->get_name() << " vs " << player2->get_name() << "\n";
+
+	auto start = std::chrono::steady_clock::now();
+	game.play(false);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "Played in " << seconds << " s\n";
+	return 0;
+}
+
+int run_cyclic_tool(const std::map<std::string, std::string>& args) {
+	switch (tool_arg<int>(args, "shapes", 5)) {
+	case 3: return run_cyclic<3>(args);
+	case 5: return run_cyclic<5>(args);
+	case 7: return run_cyclic<7>(args);
+	case 9: return run_cyclic<9>(args);
+	case 11: return run_cyclic<11>(args);
+	}
+	throw std::invalid_argument{ "Cyclic games are compiled for 3, 5, 7, 9 and 11 shapes" };
+}
+
+// adversary: worst opponent move sequences and exploitability of Meta Player scoring configurations (see RPS_Adversary.h)
+int run_adversary(const std::map<std::string, std::string>& args) {
+	std::vector<std::string> configs{};
+	std::istringstream iss{ tool_arg<std::string>(args, "configs", "Meta Meta_Player_Naive(naive_score_add,{0;1;-1;0;10;1})") };
+	for (std::string config{}; iss >> config;) configs.push_back(config); // separated by spaces
+	long long depth = tool_arg<long long>(args, "depth", 100);
+	std::size_t top = tool_arg<std::size_t>(args, "top", 3);
+	Fork_Join_Pool pool{ tool_arg<unsigned>(args, "threads", 0) };
+
+	for (const std::string& config : configs) {
+		Adversary_Search search{ config, tool_arg<std::size_t>(args, "beam", 4096) };
+		auto start = std::chrono::steady_clock::now();
+		Adversary_Result result = search.search(depth, top, pool);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		std::cout << "\n" << config << ": exploitability " << result.exploitability << " over " << depth << " rounds (" << result.expanded << " nodes, ";
+		std::cout << result.transpositions << " transpositions merged, " << pool.size() << " threads, " << seconds << " s)\n";
+		for (const Adversary_Sequence& sequence : result.worst) {
+			std::vector<long long> score = search.replay(sequence.moves);
+			std::cout << "  opponent wins - Meta wins " << sequence.value << " (replayed against Meta Player: " << score[2] << " - " << score[1];
+			if (sequence.fallback_rounds) std::cout << ", " << sequence.fallback_rounds << " random fallback rounds";
+			std::cout << "): ";
+			for (short move : sequence.moves) std::cout << shapes[move];
+			std::cout << "\n";
+		}
+	}
+	return 0;
+}
+
+// workload: load test of Meta Player configurations against synthetic regime-switching opponents, batched (see RPS_Workload.h)
+int run_workload(const std::map<std::string, std::string>& args) {
+	std::vector<std::string> configs{}, workloads{};
+	std::istringstream config_stream{ tool_arg<std::string>(args, "configs", "Meta") };
+	for (std::string config{}; config_stream >> config;) configs.push_back(config); // separated by spaces
+	std::istringstream workload_stream{ tool_arg<std::string>(args, "workloads", "Workload Workload(noise=0.2) Workload(dwell=5-50,burst=0.2;10)") };
+	for (std::string workload{}; workload_stream >> workload;) workloads.push_back(workload);
+	std::size_t num_games = tool_arg<std::size_t>(args, "games", 1000);
+	long long num_rounds = tool_arg<long long>(args, "rounds", 1000);
+
+	std::cout << num_games << " games of " << num_rounds << " rounds per matchup\n\n";
+	std::cout << "Meta Player,Workload,Win Rate,Loss Rate,Draw Rate,Rounds per Second\n";
+	for (const std::string& config : configs) {
+		for (const std::string& workload : workloads) {
+			std::unique_ptr<Batch_Strategy> meta = make_batch_strategy(config);
+			Batch_Workload opponent{ Workload_Config::parse(workload) };
+			Batch_Game batch{ *meta, opponent, num_games, num_rounds };
+			auto start = std::chrono::steady_clock::now();
+			batch.play();
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			Round_Stats total = batch.total();
+			std::cout << config << "," << workload << "," << total.rate(1) << "," << total.rate(2) << "," << total.rate(0) << "," << (double)total.get_rounds() / std::max(seconds, 1e-9) << "\n";
+		}
+	}
+	return 0;
+}
+
+// warm_start_meta() loads profile of Meta Player meta's opponent (if there is one) and warm starts meta from it
+void warm_start_meta(Profile_Store& store, Opponent_Profile& profile, Meta_Player_Naive* meta, double trust) {
+	if (!store.load(profile.opponent, profile)) return;
+	profile.apply(*meta, trust);
+	std::cout << "\n\n" << meta->get_name() << " starts from its profile of " << profile.opponent << " (" << profile.games << " games, best so far: ";
+	std::cout << profile.best_strategy << " rotated by " << profile.best_rotation << ")";
+}
+
+// learn_profile() updates and saves what Meta Player meta learned about opponent in the game just played; score: {draws, meta wins, opponent wins}
+void learn_profile(Profile_Store& store, Opponent_Profile& profile, Meta_Player_Naive* meta, const long long score[3]) {
+	try {
+		profile.learn(*meta, score);
+		store.save(profile);
+	}
+	catch (std::exception& e) {
+		std::cout << "\nError: " << e.what() << " (profile not saved)\n";
+	}
+}
+
+// print_tool_usage() lists available tools and their arguments
+void print_tool_usage() {
+	std::cout << "Usage: Konsolenprogramm [tool key=value ...]\n\n";
+	std::cout << "Without arguments the interactive console game starts. Tools:\n\n";
+	std::cout << "  evolve   population=100000 generations=100 rounds=20 mutation=0.001 selection=1 seed=1 threads=0 print_every=10 out=<csv path>\n";
+	std::cout << "  query    dir=Game_saves by=player|opponent|scoring|pairing player=<name filter> threads=0 curves=<csv path>\n";
+	std::cout << "  batch    p1=Meta p2=Random(1) games=10000 rounds=1000   (strategies: Fixed(R), Rotation(1), Frequency, Anti_Rotation, Random(seed), Meta)\n";
+	std::cout << "  backtest corpus=Game_saves side=2 candidates=\"Meta Frequency ...\" threads=0 out=<csv path>   (corpus: directory, csv or archive)\n";
+	std::cout << "  sweep    strategies=\"Meta Frequency ...\" games=1000 rounds=1000 unit=256 workers=0 crash=-1   (all pairs, worker processes\n";
+	std::cout << "           with a shared-memory result table; crash=<unit> lets a worker die on that unit to test re-issuing)\n";
+	std::cout << "  multiplex games=1000 rounds=100 delay=10 threads=1 human=0 seed=1   (concurrent games on a few threads; human=1 adds an interactive game)\n";
+	std::cout << "  markov   p1=Meta_Player_Rand_Strat p2=Fixed(R) rounds=100 max_states=1048576   (exact expectations; Fixed, Rotation, Frequency,\n";
+	std::cout << "           Anti_Rotation, Random, Meta_Player_Rand_Strat; Frequency and Meta_Player_Rand_Strat only against opponents whose\n";
+	std::cout << "           moves don't vary at random)\n";
+	std::cout << "  perf     rounds=10000 sample=1 seed=1   (hardware counters per get_move() of every bot strategy; Linux)\n";
+	std::cout << "  adversary configs=\"Meta ...\" depth=100 beam=4096 top=3 threads=0   (worst opponent sequences against Meta Player scoring\n";
+	std::cout << "           configurations found by parallel beam search; exploitability 1: opponent wins every round)\n";
+	std::cout << "  workload configs=\"Meta ...\" workloads=\"Workload(dwell=1-21,mix=1;1;1;1,rotations=1;1;1,noise=0,burst=0;5,seed=0) ...\" games=1000 rounds=1000\n";
+	std::cout << "           (Meta Player configurations against regime-switching opponents with noise and adversarial bursts)\n";
+	std::cout << "  cyclic   shapes=5 p1=Meta p2=Rotation(1) rounds=1000   (Rock-Paper-Scissors-Lizard-Spock and other odd numbers of shapes up to 11;\n";
+	std::cout << "           Fixed(<shape>), Rotation(n), Frequency, Anti_Rotation, Random(seed), Meta)\n";
+	std::cout << "  archive  file=<archive path> [game=<id> out=<csv path>]   (lists archived games or extracts one game)\n";
+}
+
+// write_trace() writes recorded timeline (see RPS_Trace.h) to path
+void write_trace(Trace_Recorder& recorder, std::string path) {
+	if (recorder.write(path)) std::cout << "\nTimeline with " << recorder.size() << " spans written to " << path << "\n";
+	else std::cout << "\nError: unable to write timeline " << path << "\n";
+}
+
+// run_tool() dispatches command line tools; returns process exit code
+int run_tool(int argc, char* argv[]) {
+	std::string tool{ argv[1] };
+	try {
+		std::map<std::string, std::string> args = parse_tool_args(argc, argv);
+		if (tool == "evolve") return run_evolution(args);
+		if (tool == "archive") return run_archive(args);
+		if (tool == "query") return run_query(args);
+		if (tool == "multiplex") return run_multiplex(args);
+		if (tool == "batch") return run_batch(args);
+		if (tool == "backtest") return run_backtest_tool(args);
+		if (tool == "sweep") return run_sweep(args);
+		if (tool == "perf") return run_perf(args);
+		if (tool == "markov") return run_markov(args);
+		if (tool == "cyclic") return run_cyclic_tool(args);
+		if (tool == "adversary") return run_adversary(args);
+		if (tool == "workload") return run_workload(args);
+	}
+	catch (std::exception& e) {
+		std::cout << "\nError: " << e.what() << "\n";
+		return 1;
+	}
+	print_tool_usage();
+	return 1;
+}
+
+
+//// Main
+int main(int argc, char* argv[]) {
+
+	// Setting environment variable RPS_TRACE to a file path records a timeline of games and tool tasks (Chrome trace-event JSON, see RPS_Trace.h)
+	const char* trace_path = std::getenv("RPS_TRACE");
+	Trace_Recorder trace_recorder{};
+	if (trace_path) active_trace = &trace_recorder;
+
+	if (argc > 1) {
+		int exit_code = run_tool(argc, argv);
+		if (trace_path) write_trace(trace_recorder, trace_path);
+		return exit_code;
+	}
+
+	std::cout << "==================================================\n";
+	std::cout << "== Welcome to Rock-Paper-Scissors engine v.1.0! ==\n";
+	std::cout << "==================================================\n\n\n";
+
+	// Load strategy plugins; plugin directory can be changed with environment variable RPS_PLUGIN_DIR
+	if (const char* env_plugin_dir = std::getenv("RPS_PLUGIN_DIR")) plugin_dir = env_plugin_dir;
+	plugins = load_plugins(plugin_dir);
+	if (!plugins.empty()) std::cout << "Loaded " << plugins.size() << " strategy plugin(s) from " << plugin_dir << "\n\n";
+
+	// Load strategy scripts; script directory can be changed with environment variable RPS_STRATEGY_DIR
+	if (const char* env_script_dir = std::getenv("RPS_STRATEGY_DIR")) script_dir = env_script_dir;
+	scripts = load_scripts(script_dir);
+	if (!scripts.empty()) std::cout << "Loaded " << scripts.size() << " strategy script(s) from " << script_dir << "\n\n";
+	const int max_strategy = num_builtin_strategies + (int)plugins.size() + (int)scripts.size() - 1; // highest selectable strategy number
+
+	// Result cache directory can be changed with environment variable RPS_CACHE_DIR
+	if (const char* env_cache_dir = std::getenv("RPS_CACHE_DIR")) cache_dir = env_cache_dir;
+	Result_Cache result_cache{ cache_dir };
+
+	// Setting environment variable RPS_PERF (e.g. RPS_PERF=1) profiles every played game with hardware counters (see RPS_Perf.h)
+	const bool profile_games{ std::getenv("RPS_PERF") != nullptr };
+
+	// Setting environment variable RPS_ALLOC (e.g. RPS_ALLOC=1) counts heap allocations per round and phase of every played game (see RPS_Alloc.h)
+	const bool count_allocations{ std::getenv("RPS_ALLOC") != nullptr };
+
+	// Setting environment variable RPS_PROFILE_DIR to a directory warm starts Meta Players from opponent profiles learned in earlier games
+	// (see RPS_Profile.h); RPS_PROFILE_TRUST (0-1, default 0.8) is the weight of the learned scores
+	std::unique_ptr<Profile_Store> profile_store{};
+	if (const char* env_profile_dir = std::getenv("RPS_PROFILE_DIR")) profile_store = std::make_unique<Profile_Store>(env_profile_dir);
+	const double profile_trust{ std::getenv("RPS_PROFILE_TRUST") ? std::atof(std::getenv("RPS_PROFILE_TRUST")) : 0.8 };
+
+	// Setting environment variable RPS_MOVE_BUDGET to a number of microseconds limits the time of every move (see Game::set_move_budget())
+	const std::chrono::microseconds move_budget{ std::getenv("RPS_MOVE_BUDGET") ? std::atoll(std::getenv("RPS_MOVE_BUDGET")) : 0 };
+
+	while (true) {
+
+		Player* player1{}, * player2{};
+
+		while (true) {
+			std::cout << "\n\nFirst, you need to choose two players to play against each other from the following selection:\n\n";
+			std::cout << "(0) Fixed Player: Always plays the same move (Rock, Paper or Scissors)\n";
+			std::cout << "(1) Rotation Player: Rotates last opponent Move by set amount \n     (Rotation is clockwise for positive and counter clockwise for negative rotation values)\n";
+			std::cout << "(2) Frequency Player: Plays winning move against most frequently played\n     opponent move; always beats fixed player\n";
+			std::cout << "(3) Anti Rotation Player: Assuming opponent is a rotation player,\n     figures out opponent rotation and plays winning move against it\n";
+			std::cout << "(4) Human Player: Plays whatever you tell it to; your chance to prove\n     our carbon-based superiority!\n";
+			std::cout << "(5) Random Player: Plays uniformly distributed random moves;\n     unpredictable (except if you know the seed)!\n";
+			std::cout << "(6) Meta Player: Smart player that chooses the best strategy\n     against its opponent; will win against Players 1-3 and 7\n";
+			std::cout << "(7) Random Strategy Player: Chooses between strategies 0-3 and applies\n     a rotation between 0 and 2; frequently switches strategy and rotation\n";
+			for (int i{}; i < (int)plugins.size(); i += 1) {
+				std::cout << "(" << num_builtin_strategies + i << ") " << plugins[i]->get_name() << ": Strategy plugin loaded from\n     " << plugins[i]->get_path() << "\n";
+			}
+			for (int i{}; i < (int)scripts.size(); i += 1) {
+				std::cout << "(" << num_builtin_strategies + (int)plugins.size() + i << ") " << scripts[i]->name << ": Strategy script compiled from\n     " << scripts[i]->path << "\n";
+			}
+			std::cout << "\nChoose Strategy (0-" << max_strategy << "): ";
+
+			while (true) { // Choose Player 1
+				try {
+					p1 = input_exception_handler<int>();
+					if (p1 < 0 or p1 > max_strategy) throw std::domain_error{ "You have to choose between Strategy 0 and " + std::to_string(max_strategy) + "!" };
+				}
+				catch (std::exception& e) {
+					std::cout << "\nError: " << e.what() << "\n\n";
+					continue;
+				}
+				break;
+			}
+
+			// Depending on player type, different initialization variables are needed, so call configure_player(), then setup_player()
+			configure_player(p1);
+			player1 = setup_player(p1);
+
+			while (true) { // Choose Player 2
+				std::cout << "\n\nChoose Player 2 (0-" << max_strategy << "): ";
+				try {
+					p2 = input_exception_handler<int>();
+					if (p2 > max_strategy or p2 < 0) throw std::range_error{ "You have to choose between Strategy 0 and " + std::to_string(max_strategy) + "!" };
+				}
+				catch (std::exception& e) {
+					std::cout << "\nError: " << e.what() << "\n\n";
+					continue;
+				}
+				break;
+			}
+
+			configure_player(p2);
+			player2 = setup_player(p2);
+
+
+			while (true) { // Set number of game rounds
+				std::cout << "\n\nChoose number of rounds to play: ";
+				try {
+					rounds = input_exception_handler<long long>();
+					if (rounds < 0) throw std::domain_error{ "Number of rounds has to be larger than 0!" };
+				}
+				catch (std::exception& e) {
+					std::cout << "\nError: " << e.what() << "\n\n";
+					continue;
+				}
+				break;
+			}
+
+			// Print final setup
+			std::cout << "\n\n----------------\n\n";
+			std::cout << "Your game set up:\n\n\n";
+			print_setup(p1, 1, player1);
+			std::cout << "\n\n            vs            \n\n";
+			print_setup(p2, 2, player2);
+			std::cout << "\n\n\nPlaying " << rounds << " rounds";
+			std::cout << "\n\n----------------\n\n";
+			std::cout << "Do you want to continue with this setup or reconfigure your settings (0: reconfigure, 1: continue)? ";
+
+			// Choice to reconfigure or play
+			user_flag = input_exception_handler<bool>();
+
+			if (!user_flag) {
+				delete player1, player2;
+				continue;
+			}
+			else break;
+		}
+
+		std::cout << "\n\nBefore starting the game, you can set a delay in milliseconds between \ngame rounds";
+		std::cout << " (not recommended for large number of rounds; set to 0 for no extra delay): ";
+
+		while (true) { // Set delay
+			try {
+				round_delay = input_exception_handler<int>();
+				if (round_delay < 0) throw std::domain_error{ "Delay has to be larger than 0!" };
+			}
+			catch (std::exception& e) {
+				std::cout << "Error: " << e.what() << std::endl;
+				continue;
+			}
+			break;
+		}
+
+		Game this_game{ *player1, *player2, rounds , round_delay }; // Init Game
+		this_game.set_move_budget(move_budget);
+
+		// Meta Players start from their profile of the opponent (identities are taken before warm starting, a warm started Meta Player has no config)
+		Opponent_Profile profile_p1{ Profile_Store::identity(*player2) }, profile_p2{ Profile_Store::identity(*player1) };
+		if (profile_store and p1 == 6) warm_start_meta(*profile_store, profile_p1, (Meta_Player_Naive*)player1, profile_trust);
+		if (profile_store and p2 == 6) warm_start_meta(*profile_store, profile_p2, (Meta_Player_Naive*)player2, profile_trust);
+
+		// Deterministic matchups end up repeating themselves; Game can then skip the remaining rounds (see Game::fast_forward())
+		std::uint64_t fingerprint{};
+		bool cycle_detection{};
+		if (!move_budget.count() and player1->get_fingerprint(empty_vec, empty_vec, History_Summary{}, fingerprint) and player2->get_fingerprint(empty_vec, empty_vec, History_Summary{}, fingerprint)) {
+			std::cout << "\n\nBoth players are deterministic. Fast-forward the game once it repeats itself (only the rounds played until then\n";
+			std::cout << "are printed and saved; game stats cover all rounds) (1=yes, 0=no)? ";
+			cycle_detection = input_exception_handler<bool>();
+			this_game.set_cycle_detection(cycle_detection);
+		}
+
+		// Printing every round is only practical for small games
+		bool print_rounds{ true };
+		if (rounds > 1000) {
+			std::cout << "\n\nPrint every round to the console (1=yes, 0=no)? ";
+			print_rounds = input_exception_handler<bool>();
+		}
+
+		// Players that only look at the last moves or move counts don't need full histories; without saving memory then stays constant (see Game::set_keep_histories())
+		if (rounds > 1000 and !cycle_detection and !player1->history_requirement().full and !player2->history_requirement().full) {
+			std::cout << "\n\nKeep full move histories (only needed to save the game to a file; otherwise memory stays constant) (1=yes, 0=no)? ";
+			this_game.set_keep_histories(input_exception_handler<bool>());
+		}
+
+		// Plot export: win rate series (and Meta Player scores) are recorded and downsampled while playing (see RPS_Plot.h)
+		std::cout << "\n\nExport plot-ready win rate series (CSV and SVG) after the game (1=yes, 0=no)? ";
+		bool plot_flag = input_exception_handler<bool>();
+		Plot_Recorder plot_recorder{ player1->get_name(), player2->get_name() };
+		if (plot_flag) {
+			if (p1 == 6) plot_recorder.track_meta((Meta_Player_Naive*)player1, "P1");
+			if (p2 == 6) plot_recorder.track_meta((Meta_Player_Naive*)player2, "P2");
+			this_game.add_observer(&plot_recorder);
+		}
+
+		// Game archive: moves are encoded while playing and appended to an indexed archive file after the game (see RPS_Archive.h)
+		std::cout << "\n\nAppend the game to a game archive (compressed move streams, many games per file) (1=yes, 0=no)? ";
+		bool archive_flag = input_exception_handler<bool>();
+		std::string archive_path{};
+		Archive_Recorder archive_recorder{};
+		if (archive_flag) {
+			std::cout << "\nArchive path without file extension (files <path>.rpsa and <path>.rpsi): ";
+			archive_path = input_exception_handler<std::string>();
+			this_game.add_observer(&archive_recorder);
+		}
+
+		// Reproducible configurations (no Human, only seeded Random Players, ...) are looked up in the result cache first; others bypass it
+		std::string game_config{};
+		Game_Result cached_result{};
+		bool cacheable = this_game.get_config(game_config) and !(profile_store and (p1 == 6 or p2 == 6)); // profiles learn from played games
+
+		if (cacheable and !plot_flag and result_cache.lookup(game_config, cached_result)) { // plots need the rounds to be played
+			std::cout << "\n\n----------------\n----------------\n\nThis game has been played before, loading result from " << cache_dir << "\n\n";
+			this_game.replay(cached_result);
+		}
+		else {
+			std::cout << "\n\n----------------\n----------------\n\nGame starts!\n\n";
+
+			std::unique_ptr<Perf_Profiler> profiler{};
+			if (profile_games) {
+				profiler = std::make_unique<Perf_Profiler>();
+				this_game.set_profiler(profiler.get());
+			}
+
+			std::unique_ptr<Alloc_Profiler> allocs{};
+			if (count_allocations) {
+				allocs = std::make_unique<Alloc_Profiler>(profiler.get());
+				this_game.set_profiler(allocs.get());
+			}
+
+			// timeline of at most about 10000 sampled rounds per game; hardware counters and allocations keep being measured every round
+			std::unique_ptr<Trace_Profiler> tracer{};
+			if (trace_path) {
+				Game_Profiler* next = (allocs ? (Game_Profiler*)allocs.get() : profiler.get());
+				tracer = std::make_unique<Trace_Profiler>(trace_recorder, player1->get_name(), player2->get_name(), std::max(rounds / 10000, 1ll), next);
+				this_game.set_profiler(tracer.get());
+			}
+
+			{
+				Trace_Span span{ "Game::play", "game" };
+				this_game.play(print_rounds); // Play
+			}
+			this_game.set_profiler(nullptr);
+			if (tracer) tracer->finish();
+
+			if (profiler) print_perf_report(profiler->rows(player1->get_name(), player2->get_name()), profiler->get_counters());
+			if (allocs) {
+				allocs->finish();
+				print_alloc_report(allocs->rows(player1->get_name(), player2->get_name()));
+				allocs.reset(); // stops counting
+			}
+
+			if (profile_store) {
+				const Round_Stats& played = this_game.get_stats();
+				const long long score_p1[3]{ (long long)played.get_score(0), (long long)played.get_score(1), (long long)played.get_score(2) };
+				const long long score_p2[3]{ score_p1[0], score_p1[2], score_p1[1] };
+				if (p1 == 6) learn_profile(*profile_store, profile_p1, (Meta_Player_Naive*)player1, score_p1);
+				if (p2 == 6) learn_profile(*profile_store, profile_p2, (Meta_Player_Naive*)player2, score_p2);
+			}
+
+			if (cacheable) {
+				try {
+					result_cache.store(game_config, this_game.get_result());
+				}
+				catch (std::exception& e) {
+					std::cout << "\nError: " << e.what() << " (result not cached)\n";
+				}
+			}
+		}
+
+		if (plot_flag) { // save plot data
+			std::cout << "\n\nSpecify a path to save plot data: ";
+			save_path = input_exception_handler<std::string>();
+			std::cout << "\nFile name prefix (files <prefix>_series.csv, <prefix>_win_rate.svg, ...): ";
+			f_name = input_exception_handler<std::string>();
+			if (plot_recorder.save(save_path, f_name)) std::cout << "\n\nSuccessfully saved plot data to " << save_path << std::endl;
+		}
+
+		if (archive_flag) { // append game to archive
+			try {
+				Game_Result result = this_game.get_result();
+				if (archive_recorder.moves_p1.size() == 0 and result.has_histories) archive_recorder.record_histories(result.move_history_p1, result.move_history_p2); // result from cache
+				if ((long long)archive_recorder.moves_p1.size() < result.num_rounds) throw std::runtime_error{ "fast-forwarded games can't be archived" };
+				std::uint64_t game_id{};
+				if (std::filesystem::exists(archive_path + ".rpsi")) game_id = Archive_Reader{ archive_path }.size();
+				Trace_Span span{ "archive append", "io" };
+				Archive_Writer{ archive_path }.append(game_id, player1->get_name(), player2->get_name(), archive_recorder);
+				std::cout << "\n\nSuccessfully archived game " << game_id << " in " << archive_path << ".rpsa" << std::endl;
+			}
+			catch (std::exception& e) {
+				std::cout << "\nError: " << e.what() << " (game not archived)\n";
+			}
+		}
+
+		// metadata saved next to the game data, used by the query tool to group saved games (see RPS_Query.h)
+		std::map<std::string, std::string> game_metadata{ { "player1", player1->get_name() }, { "player2", player2->get_name() }, { "rounds", std::to_string(rounds) } };
+		if (p1 == 6) game_metadata["scoring1"] = scoring_funcs[meta_scoring_func_1];
+		if (p2 == 6) game_metadata["scoring2"] = scoring_funcs[(p1 == 6 ? meta_scoring_func_2 : meta_scoring_func_1)];
+		if (cacheable) game_metadata["config"] = game_config;
+
+		delete player1, player2; // Delete dynamic player objects
+
+		// choice to save game data
+		user_flag = false;
+		if (this_game.has_full_histories()) {
+			std::cout << "\n\nDo you want to save the current win and move histories to a file (0=no, 1=yes)? ";
+			user_flag = input_exception_handler<bool>();
+		}
+		else std::cout << "\n\nOnly the most recent moves were kept, the game can't be saved to a file\n";
+
+		if (user_flag) { // Save game
+			while (true) {
+				try {
+					std::cout << "\n\nSpecify a path to save game data: ";
+					save_path = input_exception_handler<std::string>();
+					std::cout << "\nFile name (file extension .csv is automatic): ";
+					f_name = input_exception_handler<std::string>();
+
+					std::cout << save_path;
+					Trace_Span span{ "Game::save", "io" };
+					if (this_game.save(save_path, f_name)) {
+						if (!write_game_metadata(save_path, f_name, game_metadata)) std::cout << "\nError: unable to write game metadata (game data was saved)\n";
+						break;
+					}
+					else throw std::runtime_error{ "Something went wrong while saving your game data." };
+				}
+				catch (std::exception& e) {
+					std::cout << "\nAn Error occured while saving game data: " << e.what();
+					std::cout << "\nTry another path and make sure to only include alphanumeric characters or cancel (0: cancel, 1: try again): ";
+					user_flag = input_exception_handler<bool>();
+					if (user_flag) continue;
+					else break;
+				}
+				break;
+			}
+			std::cout << "\n\nSuccessfully saved game data to " << save_path + "\\" + f_name + ".csv" << std::endl;
+
+		}
+
+		if (trace_path) write_trace(trace_recorder, trace_path); // after every game, so the timeline is complete whenever the program ends
+
+		// Exit or continue with new game
+		std::cout << "\n\n----------------\n\nDo you want to set up another game or exit (0: exit; 1: new game)? ";
+
+		user_flag = input_exception_handler<bool>();
+
+		if (!user_flag) {
+			break;
+		}
+		else {
+			reset_config(); // reset control flags for next game
+			continue;
+		}
+	}
+
+	return 0;
+
 }
\ No newline at end of file
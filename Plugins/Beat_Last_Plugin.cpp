@@ -0,0 +1,43 @@
+// Example strategy plugin: plays the move that beats the opponent's last move
+// Build (Linux): g++ -std=c++20 -O2 -shared -fPIC -o beat_last.so Beat_Last_Plugin.cpp
+// and put the resulting library into the plugins directory next to the engine (see README.md)
+
+#include "../RPS_Plugin_ABI.h"
+
+// Per game state; this strategy only counts its rounds, but real plugins may keep whatever they need here
+struct Beat_Last_State {
+	uint64_t rounds{};
+};
+
+extern "C" {
+
+RPS_PLUGIN_EXPORT uint32_t rps_abi_version(void) {
+	return RPS_PLUGIN_ABI_VERSION;
+}
+
+RPS_PLUGIN_EXPORT const char* rps_name(void) {
+	return "Beat Last Plugin Player";
+}
+
+RPS_PLUGIN_EXPORT void* rps_create(void) {
+	return new Beat_Last_State{};
+}
+
+RPS_PLUGIN_EXPORT void rps_destroy(void* instance) {
+	delete (Beat_Last_State*)instance;
+}
+
+RPS_PLUGIN_EXPORT void rps_reset(void* instance) {
+	((Beat_Last_State*)instance)->rounds = 0;
+}
+
+RPS_PLUGIN_EXPORT void rps_get_moves(void* const* instances, const rps_history* histories, uint8_t* moves, uint64_t count) {
+	for (uint64_t i{}; i < count; i += 1) {
+		Beat_Last_State* state = (Beat_Last_State*)instances[i];
+		state->rounds += 1;
+		if (histories[i].length == 0) moves[i] = 0; // Rock in first round
+		else moves[i] = (uint8_t)((histories[i].other[histories[i].length - 1] + 1) % 3); // rotate opponent last move by 1
+	}
+}
+
+}
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "RPS_Header.h"
+#include "RPS_Batch.h"
+
+
+//// Adversarial search: opponent move sequences that Meta_Player_Naive (built-in oracles) handles worst
+
+// Meta Player's moves only depend on its score grid and a few features of the histories (its own move counts for Frequency, the last
+// moves for Anti_Rotation and Rotation), so it is modelled by a small copyable state (Meta_Model, played by Meta_Kernel like Batch_Meta). Beam search
+// over opponent moves keeps the beam_width sequences with the best result for the opponent (opponent wins - Meta Player wins) after every
+// round; children of the beam are expanded in parallel (Fork_Join_Pool) and children that reach the same Meta state (transpositions, e.g.
+// different orders of the same moves) are merged, keeping the better one, since their futures are identical. The exploitability of a
+// scoring configuration is the result of the best sequence per round (1: the opponent wins every round, 0: no better than random).
+// Rounds in which Meta Player falls back to a random move (all scores below 1) count as 0 (the opponent can't predict them); the model
+// then continues with a pseudo-random move derived from the state.
+
+// Meta_Model: state of Meta_Player_Naive with the four built-in oracles between two rounds
+struct Meta_Model {
+	double scores[12]{ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 }; // scores[rotation * 4 + oracle] (0 Frequency, 1 Anti_Rotation, 2 Rotation, 3 Fixed)
+	std::uint32_t self_counts[3]{}; // Meta Player's move counts minus their minimum (Frequency only compares them)
+	std::uint8_t predictions[4]{}; // oracle predictions of the opponent's next move
+	std::uint8_t last_self{}, last_other{}, prev_other{};
+	std::uint8_t rounds{}; // rounds played, saturated at 2 (Anti_Rotation needs two)
+
+	// decide() returns Meta Player's move this round; fallback: all scores are below 1 (Meta Player plays a random move)
+	short decide(bool& fallback) const {
+		fallback = false;
+		if (rounds == 0) return 0;
+		int best = Meta_Kernel::best([this](int k) { return scores[k]; });
+		if (best >= 0) return Meta_Kernel::move(best, predictions[best % 4]);
+		fallback = true;
+		return (short)(hash() % 3);
+	}
+
+	// observe() scores the predictions against the opponent's move of this round and predicts the next one
+	void observe(short self, short other, scoring_func_ptr scoring_func, double scoring_vector[6]) {
+		for (int k{}; k < 12; k += 1) scoring_func(scores[k], Meta_Kernel::outcome(k, predictions[k % 4], (std::uint8_t)other), scoring_vector);
+		self_counts[self] += 1;
+		std::uint32_t min = std::min({ self_counts[0], self_counts[1], self_counts[2] });
+		for (std::uint32_t& count : self_counts) count -= min;
+		prev_other = last_other;
+		last_self = (std::uint8_t)self;
+		last_other = (std::uint8_t)other;
+		rounds = (std::uint8_t)std::min(rounds + 1, 2);
+
+		Meta_Kernel::predict(self_counts[0], self_counts[1], self_counts[2], last_self, last_other, prev_other, rounds, predictions);
+	}
+
+	// hash() of the whole state (FNV-1a over its fields); equal states always have equal hashes
+	std::uint64_t hash() const {
+		std::uint64_t h{ 14695981039346656037ull };
+		auto add = [&h](const void* data, std::size_t size) {
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			for (std::size_t b{}; b < size; b += 1) {
+				h ^= bytes[b];
+				h *= 1099511628211ull;
+			}
+		};
+		add(scores, sizeof(scores));
+		add(self_counts, sizeof(self_counts));
+		add(predictions, sizeof(predictions));
+		std::uint8_t rest[4]{ last_self, last_other, prev_other, rounds };
+		add(rest, sizeof(rest));
+		return h;
+	}
+
+	bool operator==(const Meta_Model& other) const {
+		return std::memcmp(scores, other.scores, sizeof(scores)) == 0 and std::memcmp(self_counts, other.self_counts, sizeof(self_counts)) == 0 \
+			and std::memcmp(predictions, other.predictions, sizeof(predictions)) == 0 and last_self == other.last_self and last_other == other.last_other \
+			and prev_other == other.prev_other and rounds == other.rounds;
+	}
+};
+
+
+// Adversary_Sequence: opponent moves of one searched sequence; value: opponent wins - Meta Player wins (random fallback rounds count 0)
+struct Adversary_Sequence {
+	vector moves{};
+	long long value{};
+	long long fallback_rounds{};
+};
+
+// Adversary_Result: best sequences found against one scoring configuration
+struct Adversary_Result {
+	std::string config{};
+	std::vector<Adversary_Sequence> worst{}; // best sequences for the opponent, best first
+	double exploitability{}; // value of the best sequence per round
+	long long expanded{}; // search nodes expanded
+	long long transpositions{}; // children merged with an equal Meta state
+};
+
+
+struct Adversary_Search {
+
+	// config: Meta Player configuration (see parse_meta_config()); throws std::invalid_argument for other strategies
+	Adversary_Search(std::string config, std::size_t beam_width = 4096) : config{ config }, beam_width{ std::max(beam_width, (std::size_t)1) } {
+		if (!parse_meta_config(config, scoring_func, scoring_vector)) throw std::invalid_argument{ config + " is no Meta Player configuration" };
+	}
+
+	// search() runs the beam search over depth rounds on pool and returns the top best sequences found
+	Adversary_Result search(long long depth, std::size_t top, Fork_Join_Pool& pool) {
+		Adversary_Result result{ config };
+		std::vector<Node> beam{ Node{} };
+		std::vector<std::vector<Step>> steps{}; // steps[round][node]: how a node of the beam after round was reached
+		std::vector<Node> children{};
+
+		for (long long round{}; round < depth; round += 1) {
+			// expand: every node of the beam with all three opponent moves (chunks of nodes are tasks)
+			children.assign(beam.size() * 3, Node{});
+			std::size_t chunk{ 256 }, chunks = (beam.size() + chunk - 1) / chunk;
+			pool.run(chunks, [&](std::size_t c) {
+				for (std::size_t n{ c * chunk }; n < std::min(beam.size(), (c + 1) * chunk); n += 1) expand(beam[n], n, &children[n * 3]);
+			});
+			result.expanded += (long long)beam.size();
+
+			// merge transpositions (equal states have equal hashes; ties keep the better value, then the earlier node)
+			std::sort(children.begin(), children.end(), [](const Node& a, const Node& b) {
+				if (a.hash != b.hash) return a.hash < b.hash;
+				if (a.value != b.value) return a.value > b.value;
+				return a.parent * 3 + a.move < b.parent * 3 + b.move;
+			});
+			std::size_t kept{};
+			for (std::size_t n{}; n < children.size(); n += 1) {
+				bool duplicate{};
+				for (std::size_t m{ kept }; m > 0 and children[m - 1].hash == children[n].hash and !duplicate; m -= 1) duplicate = (children[m - 1].state == children[n].state);
+				if (duplicate) {
+					result.transpositions += 1;
+					continue;
+				}
+				children[kept] = children[n];
+				kept += 1;
+			}
+			children.resize(kept);
+
+			// select: beam_width best children for the opponent (less confident Meta Player first on equal value)
+			auto better = [](const Node& a, const Node& b) {
+				if (a.value != b.value) return a.value > b.value;
+				if (a.confidence != b.confidence) return a.confidence < b.confidence;
+				return a.hash < b.hash;
+			};
+			if (children.size() > beam_width) {
+				std::nth_element(children.begin(), children.begin() + (std::ptrdiff_t)beam_width, children.end(), better);
+				children.resize(beam_width);
+			}
+			std::sort(children.begin(), children.end(), better);
+
+			steps.push_back({});
+			for (const Node& child : children) steps.back().push_back({ child.parent, child.move });
+			beam.swap(children);
+		}
+
+		// trace the best nodes back to their move sequences
+		for (std::size_t n{}; n < beam.size() and n < top; n += 1) {
+			Adversary_Sequence sequence{ vector(steps.size()), beam[n].value, beam[n].fallback_rounds };
+			std::size_t node{ n };
+			for (std::size_t round{ steps.size() }; round > 0; round -= 1) {
+				sequence.moves[round - 1] = steps[round - 1][node].move;
+				node = steps[round - 1][node].parent;
+			}
+			result.worst.push_back(sequence);
+		}
+		if (!result.worst.empty() and depth > 0) result.exploitability = (double)result.worst[0].value / (double)depth;
+		return result;
+	}
+
+	// replay() plays moves against a real Meta_Player_Naive of the searched configuration; returns {draws, Meta wins, opponent wins}
+	std::vector<long long> replay(const vector& moves) {
+		Meta_Player_Naive meta{ false, "", scoring_func, scoring_vector };
+		vector meta_history{}, opponent_history{};
+		std::vector<long long> score(3);
+		for (short move : moves) {
+			Move meta_move = meta.get_move(opponent_history, meta_history);
+			meta_history.push_back(meta_move.index);
+			opponent_history.push_back(move);
+			score[evaluate_round(meta_move, Move{ move })] += 1;
+		}
+		return score;
+	}
+
+private:
+	struct Node {
+		Meta_Model state{};
+		std::uint64_t hash{};
+		long long value{};
+		long long fallback_rounds{};
+		double confidence{}; // Meta Player's highest score
+		std::size_t parent{};
+		short move{};
+	};
+
+	struct Step {
+		std::size_t parent{};
+		short move{};
+	};
+
+	// expand() writes the three children of node (opponent plays Rock, Paper, Scissors against Meta Player's move of this round)
+	void expand(const Node& node, std::size_t index, Node* children) {
+		bool fallback{};
+		short meta_move = node.state.decide(fallback);
+		for (short move{}; move < 3; move += 1) {
+			Node& child = children[move];
+			child = node;
+			child.parent = index;
+			child.move = move;
+			short outcome = outcome_table[move][meta_move]; // 1: opponent wins
+			if (fallback) child.fallback_rounds += 1;
+			else child.value += (outcome == 1 ? 1 : (outcome == 2 ? -1 : 0));
+			child.state.observe(meta_move, move, scoring_func, scoring_vector);
+			child.hash = child.state.hash();
+			child.confidence = *std::max_element(child.state.scores, child.state.scores + 12);
+		}
+	}
+
+	std::string config{};
+	std::size_t beam_width{};
+	scoring_func_ptr scoring_func{};
+	double scoring_vector[6]{};
+};
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <new>
+
+#include "RPS_Header.h"
+
+
+//// Allocation tracking: heap allocations and allocated bytes per round, per strategy and per phase of a round
+
+// The program that wants allocations counted defines RPS_ALLOC_HOOK before including this header (in exactly one translation unit, like
+// the console program): operator new and delete are then replaced by versions that add up allocations, bytes and frees of the calling
+// thread (plugins loaded at runtime use the same operators, so their allocations are counted as well). Counting is off until
+// alloc_tracking is set, so the hook only costs a load and a branch per allocation otherwise. Over-aligned allocations
+// (operator new with std::align_val_t) keep the library's operators and aren't counted; freed bytes are only known for sized deletes,
+// so only allocated bytes are reported.
+// Alloc_Profiler is a Game_Profiler (see Game::set_profiler()) that attributes the counts to the phase of the round they happen in.
+
+// Alloc_Counts: allocations of one thread (or their difference over an interval)
+struct Alloc_Counts {
+	std::uint64_t allocations{};
+	std::uint64_t bytes{};
+	std::uint64_t frees{};
+};
+
+// thread_allocs: counts of the calling thread since it started
+inline thread_local Alloc_Counts thread_allocs{};
+
+// alloc_tracking: hooked operator new and delete only count while it is set; alloc_hook_installed: RPS_ALLOC_HOOK is defined in this program
+inline std::atomic<bool> alloc_tracking{};
+inline bool alloc_hook_installed{};
+
+// alloc_counts() returns the counts of the calling thread
+inline Alloc_Counts alloc_counts() {
+	return thread_allocs;
+}
+
+
+#ifdef RPS_ALLOC_HOOK
+
+namespace alloc_hook {
+	inline void* allocate(std::size_t size) {
+		if (alloc_tracking.load(std::memory_order_relaxed)) {
+			thread_allocs.allocations += 1;
+			thread_allocs.bytes += size;
+		}
+		while (true) {
+			if (void* p = std::malloc(size ? size : 1)) return p;
+			std::new_handler handler = std::get_new_handler();
+			if (!handler) throw std::bad_alloc{};
+			handler();
+		}
+	}
+
+	inline void* allocate(std::size_t size, const std::nothrow_t&) noexcept {
+		try {
+			return allocate(size);
+		}
+		catch (std::bad_alloc&) {
+			return nullptr;
+		}
+	}
+
+	inline void deallocate(void* p) noexcept {
+		if (!p) return;
+		if (alloc_tracking.load(std::memory_order_relaxed)) thread_allocs.frees += 1;
+		std::free(p);
+	}
+
+	// static initialization marks the hook as installed before main() runs
+	inline const bool installed = (alloc_hook_installed = true);
+}
+
+void* operator new(std::size_t size) { return alloc_hook::allocate(size); }
+void* operator new[](std::size_t size) { return alloc_hook::allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept { return alloc_hook::allocate(size, tag); }
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return alloc_hook::allocate(size, tag); }
+void operator delete(void* p) noexcept { alloc_hook::deallocate(p); }
+void operator delete[](void* p) noexcept { alloc_hook::deallocate(p); }
+void operator delete(void* p, std::size_t) noexcept { alloc_hook::deallocate(p); }
+void operator delete[](void* p, std::size_t) noexcept { alloc_hook::deallocate(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { alloc_hook::deallocate(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { alloc_hook::deallocate(p); }
+
+#endif
+
+
+// Alloc_Stats: counts added up over all measured calls of one phase (or all rounds)
+struct Alloc_Stats {
+	long long calls{};
+	Alloc_Counts counts{};
+
+	void add(const Alloc_Counts& begin, const Alloc_Counts& end) {
+		calls += 1;
+		counts.allocations += end.allocations - begin.allocations;
+		counts.bytes += end.bytes - begin.bytes;
+		counts.frees += end.frees - begin.frees;
+	}
+
+	void add(const Alloc_Stats& other) {
+		calls += other.calls;
+		counts.allocations += other.counts.allocations;
+		counts.bytes += other.counts.bytes;
+		counts.frees += other.counts.frees;
+	}
+};
+
+// Alloc_Row: one line of an allocation report (e.g. get_move() of one strategy)
+struct Alloc_Row {
+	std::string label{};
+	Alloc_Stats stats{};
+};
+
+
+// Alloc_Profiler: counts allocations of every round (from one round to the next, including everything Game does between the phases) and
+// of every phase; next: another profiler that gets all phases as well (e.g. Perf_Profiler), Alloc_Profiler doesn't take ownership.
+// The game has to run on the thread that creates the profiler; call finish() after the game to count the last round
+struct Alloc_Profiler : Game_Profiler {
+
+	Alloc_Profiler(Game_Profiler* next = nullptr) : next{ next } {
+		alloc_tracking.store(true, std::memory_order_relaxed);
+	}
+
+	~Alloc_Profiler() {
+		alloc_tracking.store(false, std::memory_order_relaxed);
+	}
+
+	Alloc_Profiler(const Alloc_Profiler&) = delete;
+	Alloc_Profiler& operator=(const Alloc_Profiler&) = delete;
+
+	// every round is counted; rounds sampled by next are reported to it as well
+	bool sample_round() override {
+		finish();
+		round_start = alloc_counts();
+		in_round = true;
+		next_sampled = (next and next->sample_round());
+		return true;
+	}
+
+	void begin_phase(Game_Phase phase) override {
+		starts[(int)phase] = alloc_counts();
+		if (next_sampled) next->begin_phase(phase);
+	}
+
+	void end_phase(Game_Phase phase) override {
+		if (next_sampled) next->end_phase(phase);
+		stats[(int)phase].add(starts[(int)phase], alloc_counts());
+	}
+
+	// finish() counts the last round
+	void finish() {
+		if (in_round) round_stats.add(round_start, alloc_counts());
+		in_round = false;
+	}
+
+	const Alloc_Stats& get_stats(Game_Phase phase) const {
+		return stats[(int)phase];
+	}
+
+	// get_round_stats(): whole rounds (calls: number of rounds)
+	const Alloc_Stats& get_round_stats() const {
+		return round_stats;
+	}
+
+	// rows() labels the phases with the names of the Players of the profiled game; the last row are whole rounds
+	std::vector<Alloc_Row> rows(std::string name_p1, std::string name_p2) const {
+		return {
+			{ "get_move " + name_p1 + " (P1)", get_stats(Game_Phase::move_p1) },
+			{ "get_move " + name_p2 + " (P2)", get_stats(Game_Phase::move_p2) },
+			{ "evaluate", get_stats(Game_Phase::evaluate) },
+			{ "output", get_stats(Game_Phase::output) },
+			{ "round", round_stats }
+		};
+	}
+
+private:
+	Game_Profiler* next{};
+	bool next_sampled{}, in_round{};
+	Alloc_Counts round_start{};
+	Alloc_Counts starts[4]{};
+	Alloc_Stats stats[4]{};
+	Alloc_Stats round_stats{};
+};
+
+
+// print_alloc_report() prints allocations, allocated bytes and frees per call of every row
+void print_alloc_report(const std::vector<Alloc_Row>& rows, std::ostream& os = std::cout) {
+	std::size_t width{ 8 };
+	for (const Alloc_Row& row : rows) width = std::max(width, row.label.size() + 2);
+
+	os << "\n----------------\n\nAllocations (averages per call)\n\n";
+	if (!alloc_hook_installed) os << "Allocation hook not installed (define RPS_ALLOC_HOOK), nothing counted\n\n";
+	os << std::left << std::setw((int)width) << "Phase" << std::right << std::setw(12) << "calls" << std::setw(14) << "allocations";
+	os << std::setw(14) << "bytes" << std::setw(14) << "frees" << "\n";
+
+	os << std::fixed << std::setprecision(3);
+	for (const Alloc_Row& row : rows) {
+		const Alloc_Stats& s = row.stats;
+		double calls = (double)std::max(s.calls, 1ll);
+		os << std::left << std::setw((int)width) << row.label << std::right << std::setw(12) << s.calls;
+		os << std::setw(14) << (double)s.counts.allocations / calls << std::setw(14) << (double)s.counts.bytes / calls;
+		os << std::setw(14) << (double)s.counts.frees / calls << "\n";
+	}
+	os << std::defaultfloat << std::setprecision(6) << "\n----------------" << std::endl;
+}
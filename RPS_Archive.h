@@ -0,0 +1,476 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <filesystem>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#endif
+
+#include "RPS_Header.h"
+
+
+//// Game archive: every game of a run in one indexed file with compressed move streams
+
+// Files of archive <path>:
+//   <path>.rpsa  data file: "RPSA1\n" followed by one block per game (appended in any order, e.g. by parallel workers)
+//   <path>.rpsi  index file: fixed size record per game id (block offset, block size, present flag), so game k is found in O(1)
+// Block layout (all integers little endian): "GAME", game id (u64), rounds (u64), score draws/p1 wins/p2 wins (3 x u64),
+// name p1 and name p2 (u64 length + bytes), then one move stream per player: encoding (u64), payload size (u64), payload.
+// Outcomes aren't stored, they follow from the moves (evaluate_round())
+
+// Move stream encodings; Move_Encoder keeps the packed stream, counts the sizes of the other two on the fly and stores the smallest
+//   packed:    4 moves (2 bit each) per byte
+//   rle:       runs of equal moves as varint ((run length - 1) << 2 | move); Fixed Players compress to a few bytes
+//   delta_rle: first move as one byte, then runs of equal differences to the previous move (same varint format);
+//              Rotation cycles (R, P, S, R, ...) compress like Fixed runs
+enum class Stream_Encoding : std::uint8_t { packed = 0, rle = 1, delta_rle = 2 };
+
+const char archive_magic[]{ "RPSA1\n" };
+const std::uint64_t archive_index_record{ 24 }; // bytes per index record
+
+
+// little endian integer and varint helpers
+namespace archive_io {
+	inline void put_u64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+		for (int i{}; i < 8; i += 1) out.push_back((std::uint8_t)(value >> (8 * i)));
+	}
+
+	inline std::uint64_t get_u64(const std::uint8_t* in) {
+		std::uint64_t value{};
+		for (int i{}; i < 8; i += 1) value |= (std::uint64_t)in[i] << (8 * i);
+		return value;
+	}
+
+	inline void put_varint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+		while (value >= 0x80) {
+			out.push_back((std::uint8_t)(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back((std::uint8_t)value);
+	}
+
+	inline std::uint64_t varint_size(std::uint64_t value) {
+		std::uint64_t size{ 1 };
+		for (; value >= 0x80; value >>= 7) size += 1;
+		return size;
+	}
+
+	inline std::uint64_t read_u64(std::istream& is) {
+		std::uint8_t bytes[8]{};
+		if (!is.read((char*)bytes, 8)) throw std::runtime_error{ "Unexpected end of archive" };
+		return get_u64(bytes);
+	}
+
+	inline std::string read_string(std::istream& is) {
+		std::string s(read_u64(is), '\0');
+		if (!is.read(s.data(), s.size())) throw std::runtime_error{ "Unexpected end of archive" };
+		return s;
+	}
+}
+
+
+// Run_Encoder: runs of equal symbols (0-3) as varints; only counts the encoded size unless it's given an output vector
+struct Run_Encoder {
+
+	Run_Encoder(std::vector<std::uint8_t>* out = nullptr) : out{ out } {}
+
+	void add(short next) {
+		if (run and symbol == next) {
+			run += 1;
+			return;
+		}
+		flush();
+		symbol = next;
+		run = 1;
+	}
+
+	// size() returns encoded size including the pending run
+	std::uint64_t size() const {
+		return bytes + (run ? archive_io::varint_size(value()) : 0);
+	}
+
+	// finish() writes the pending run
+	void finish() {
+		flush();
+		run = 0;
+	}
+
+private:
+	std::uint64_t value() const {
+		return ((run - 1) << 2) | (std::uint64_t)symbol;
+	}
+
+	void flush() {
+		if (!run) return;
+		bytes += archive_io::varint_size(value());
+		if (out) archive_io::put_varint(*out, value());
+	}
+
+	std::vector<std::uint8_t>* out{};
+	std::uint64_t bytes{};
+	short symbol{};
+	std::uint64_t run{};
+};
+
+
+// Move_Encoder: streaming encoder for one player's moves; memory is the packed stream (2 bit per move), rle and delta_rle are only
+// counted while the game is played and the chosen one is encoded in finish()
+struct Move_Encoder {
+
+	void add(short move) {
+		if (count % 4 == 0) packed.push_back(0);
+		packed.back() |= (std::uint8_t)(move << (2 * (count % 4)));
+
+		rle.add(move);
+		if (count == 0) first = move;
+		else delta.add(mod_euc(move - last, 3));
+
+		last = move;
+		count += 1;
+	}
+
+	std::uint64_t size() const {
+		return count;
+	}
+
+	// finish() writes smallest encoding to payload and returns which one it is
+	Stream_Encoding finish(std::vector<std::uint8_t>& payload) const {
+		std::uint64_t rle_size = rle.size();
+		std::uint64_t delta_size = (count ? 1 + delta.size() : 0);
+		payload.clear();
+		if (rle_size < packed.size() and rle_size <= delta_size) {
+			Run_Encoder encoder{ &payload };
+			for (std::uint64_t i{}; i < count; i += 1) encoder.add(move_at(i));
+			encoder.finish();
+			return Stream_Encoding::rle;
+		}
+		if (delta_size < packed.size()) {
+			payload.push_back((std::uint8_t)first);
+			Run_Encoder encoder{ &payload };
+			for (std::uint64_t i{ 1 }; i < count; i += 1) encoder.add(mod_euc(move_at(i) - move_at(i - 1), 3));
+			encoder.finish();
+			return Stream_Encoding::delta_rle;
+		}
+		payload = packed;
+		return Stream_Encoding::packed;
+	}
+
+private:
+	short move_at(std::uint64_t i) const {
+		return (short)((packed[i / 4] >> (2 * (i % 4))) & 3);
+	}
+
+	std::uint64_t count{};
+	short first{}, last{};
+	std::vector<std::uint8_t> packed{};
+	Run_Encoder rle{}, delta{};
+};
+
+
+// Archive_Recorder: Game_Observer that encodes both move streams while the game is played (no stored histories needed)
+struct Archive_Recorder : Game_Observer {
+
+	void on_round(long long round, const Move m1, const Move m2, short outcome) override {
+		moves_p1.add(m1.index);
+		moves_p2.add(m2.index);
+		score[outcome] += 1;
+	}
+
+	// record_histories() encodes already stored histories (e.g. from Game::get_result())
+	void record_histories(const vector& history_p1, const vector& history_p2) {
+		for (std::size_t i{}; i < history_p1.size() and i < history_p2.size(); i += 1) {
+			on_round((long long)i, Move{ history_p1[i] }, Move{ history_p2[i] }, evaluate_round(Move{ history_p1[i] }, Move{ history_p2[i] }));
+		}
+	}
+
+	Move_Encoder moves_p1{}, moves_p2{};
+	std::uint64_t score[3]{ 0, 0, 0 }; // {draws, p1 wins, p2 wins}
+};
+
+
+// Archive_File_Lock: exclusive OS level lock on an archive's data file while it's held, so Archive_Writers in other threads or processes
+// append one after another; throws std::runtime_error if the file can't be locked
+struct Archive_File_Lock {
+
+	Archive_File_Lock(const std::string& path) {
+#ifdef _WIN32
+		// Windows locks are mandatory, so a byte far behind the end of the file is locked instead of the file
+		handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (handle == INVALID_HANDLE_VALUE or !LockFileEx(handle, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &lock_range())) {
+			if (handle != INVALID_HANDLE_VALUE) CloseHandle(handle);
+			throw std::runtime_error{ "Unable to lock archive " + path };
+		}
+#else
+		fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0 or flock(fd, LOCK_EX) != 0) {
+			if (fd >= 0) close(fd);
+			throw std::runtime_error{ "Unable to lock archive " + path };
+		}
+#endif
+	}
+
+	~Archive_File_Lock() {
+#ifdef _WIN32
+		UnlockFileEx(handle, 0, 1, 0, &lock_range());
+		CloseHandle(handle);
+#else
+		flock(fd, LOCK_UN);
+		close(fd);
+#endif
+	}
+
+	Archive_File_Lock(const Archive_File_Lock&) = delete;
+	Archive_File_Lock& operator=(const Archive_File_Lock&) = delete;
+
+private:
+#ifdef _WIN32
+	OVERLAPPED& lock_range() {
+		overlapped = OVERLAPPED{};
+		overlapped.Offset = 0xFFFFFFFF;
+		overlapped.OffsetHigh = 0x7FFFFFFF;
+		return overlapped;
+	}
+
+	HANDLE handle{};
+	OVERLAPPED overlapped{};
+#else
+	int fd{ -1 };
+#endif
+};
+
+
+// Archive_Writer: appends games to an archive; append() may be called concurrently from parallel workers and from several writers
+// (in one or more processes) on the same archive
+struct Archive_Writer {
+
+	// opens existing archive for appending or creates a new one; throws std::runtime_error if files can't be opened
+	Archive_Writer(std::string path) : data_path{ path + ".rpsa" }, index_path{ path + ".rpsi" } {
+		data.open(data_path, std::ios::binary | std::ios::app);
+		if (!data.is_open()) throw std::runtime_error{ "Unable to open archive " + data_path };
+		{
+			Archive_File_Lock file_lock{ data_path };
+			if (std::filesystem::file_size(data_path) == 0) data.write(archive_magic, sizeof(archive_magic) - 1);
+			data.flush();
+		}
+
+		std::error_code ec{};
+		if (!std::filesystem::exists(index_path, ec)) std::ofstream{ index_path, std::ios::binary | std::ios::app }; // create empty index
+		index.open(index_path, std::ios::binary | std::ios::in | std::ios::out);
+		if (!index.is_open()) throw std::runtime_error{ "Unable to open archive index " + index_path };
+	}
+
+	// append() stores a recorded game under game_id (an existing game with the same id is replaced in the index)
+	void append(std::uint64_t game_id, std::string name_p1, std::string name_p2, const Archive_Recorder& recorder) {
+		// encoding happens outside of the lock, only the writes are serialized
+		std::vector<std::uint8_t> block{ 'G', 'A', 'M', 'E' };
+		archive_io::put_u64(block, game_id);
+		archive_io::put_u64(block, recorder.moves_p1.size());
+		for (std::uint64_t s : recorder.score) archive_io::put_u64(block, s);
+		for (const std::string& name : { name_p1, name_p2 }) {
+			archive_io::put_u64(block, name.size());
+			block.insert(block.end(), name.begin(), name.end());
+		}
+		for (const Move_Encoder* encoder : { &recorder.moves_p1, &recorder.moves_p2 }) {
+			std::vector<std::uint8_t> payload{};
+			Stream_Encoding encoding = encoder->finish(payload);
+			archive_io::put_u64(block, (std::uint64_t)encoding);
+			archive_io::put_u64(block, payload.size());
+			block.insert(block.end(), payload.begin(), payload.end());
+		}
+
+		// the block goes to the real end of the data file, which other writers may have moved since the last append
+		std::lock_guard<std::mutex> lock{ mutex };
+		Archive_File_Lock file_lock{ data_path };
+		std::vector<std::uint8_t> record{};
+		archive_io::put_u64(record, std::filesystem::file_size(data_path));
+		archive_io::put_u64(record, block.size());
+		archive_io::put_u64(record, 1);
+
+		data.write((const char*)block.data(), block.size());
+		data.flush();
+		if (!data) throw std::runtime_error{ "Error writing archive " + data_path };
+
+		index.seekp((std::streamoff)(game_id * archive_index_record)); // records of missing game ids stay zero (not present)
+		index.write((const char*)record.data(), record.size());
+		index.flush();
+		if (!index) throw std::runtime_error{ "Error writing archive index " + index_path };
+	}
+
+private:
+	std::string data_path{}, index_path{};
+	std::ofstream data{};
+	std::fstream index{};
+	std::mutex mutex{};
+};
+
+
+// Move_Stream: streaming decoder for one archived move stream; reads the payload in small chunks, so games of any length can be replayed
+struct Move_Stream {
+
+	Move_Stream(std::string data_path, std::uint64_t offset, std::uint64_t payload_size, Stream_Encoding encoding, std::uint64_t rounds) : \
+		ifs{ data_path, std::ios::binary }, remaining_bytes{ payload_size }, encoding{ encoding }, rounds{ rounds } {
+		if (!ifs.is_open()) throw std::runtime_error{ "Unable to open archive " + data_path };
+		ifs.seekg((std::streamoff)offset);
+	}
+
+	// next() writes next move to move and returns true; returns false after the last move
+	bool next(short& move) {
+		if (position == rounds) return false;
+		switch (encoding) {
+		case Stream_Encoding::packed:
+			if (position % 4 == 0) current = next_byte();
+			move = (short)((current >> (2 * (position % 4))) & 3);
+			break;
+		case Stream_Encoding::rle:
+			if (run == 0) next_run();
+			move = symbol;
+			run -= 1;
+			break;
+		case Stream_Encoding::delta_rle:
+			if (position == 0) move = (short)next_byte();
+			else {
+				if (run == 0) next_run();
+				move = mod_euc(last + symbol, 3);
+				run -= 1;
+			}
+			break;
+		}
+		last = move;
+		position += 1;
+		return true;
+	}
+
+private:
+	std::uint8_t next_byte() {
+		if (buffer_pos == buffer.size()) {
+			std::size_t chunk = (std::size_t)std::min<std::uint64_t>(remaining_bytes, 1 << 16);
+			if (chunk == 0) throw std::runtime_error{ "Archived move stream is truncated" };
+			buffer.resize(chunk);
+			if (!ifs.read((char*)buffer.data(), chunk)) throw std::runtime_error{ "Unexpected end of archive" };
+			remaining_bytes -= chunk;
+			buffer_pos = 0;
+		}
+		return buffer[buffer_pos++];
+	}
+
+	void next_run() {
+		std::uint64_t value{};
+		for (int shift{}; ; shift += 7) {
+			std::uint8_t byte = next_byte();
+			value |= (std::uint64_t)(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) break;
+		}
+		symbol = (short)(value & 3);
+		run = (value >> 2) + 1;
+	}
+
+	std::ifstream ifs;
+	std::uint64_t remaining_bytes{};
+	std::vector<std::uint8_t> buffer{};
+	std::size_t buffer_pos{};
+
+	Stream_Encoding encoding{};
+	std::uint64_t rounds{}, position{};
+	std::uint8_t current{};
+	short symbol{}, last{};
+	std::uint64_t run{};
+};
+
+
+// Archived_Game: header of an archived game
+struct Archived_Game {
+	std::uint64_t id{};
+	std::uint64_t rounds{};
+	std::uint64_t score[3]{ 0, 0, 0 }; // {draws, p1 wins, p2 wins}
+	std::string name_p1{}, name_p2{};
+	Stream_Encoding encoding[2]{};
+	std::uint64_t payload_offset[2]{}, payload_size[2]{};
+};
+
+
+// Archive_Reader: random access to archived games
+struct Archive_Reader {
+
+	Archive_Reader(std::string path) : data_path{ path + ".rpsa" }, index_path{ path + ".rpsi" } {
+		std::ifstream ifs(data_path, std::ios::binary);
+		char magic[sizeof(archive_magic) - 1]{};
+		if (!ifs.read(magic, sizeof(magic)) or !(std::string(magic, sizeof(magic)) == archive_magic)) throw std::runtime_error{ data_path + " is not a game archive" };
+		index.open(index_path, std::ios::binary);
+		if (!index.is_open()) throw std::runtime_error{ "Unable to open archive index " + index_path };
+		index.seekg(0, std::ios::end);
+		slots = (std::uint64_t)index.tellg() / archive_index_record;
+	}
+
+	// number of index slots (highest game id + 1); slots of games that weren't written are empty
+	std::uint64_t size() {
+		return slots;
+	}
+
+	bool has_game(std::uint64_t k) {
+		return k < slots and record(k)[2] == 1;
+	}
+
+	// read_game() reads header of game k (O(1): one index record, one block header); throws std::out_of_range if game k isn't archived
+	Archived_Game read_game(std::uint64_t k) {
+		if (!has_game(k)) throw std::out_of_range{ "Game " + std::to_string(k) + " is not in the archive" };
+		std::ifstream ifs(data_path, std::ios::binary);
+		ifs.seekg((std::streamoff)record(k)[0]);
+
+		char tag[4]{};
+		if (!ifs.read(tag, 4) or !(std::string(tag, 4) == "GAME")) throw std::runtime_error{ "Corrupt archive block for game " + std::to_string(k) };
+		Archived_Game game{};
+		game.id = archive_io::read_u64(ifs);
+		if (game.id != k) throw std::runtime_error{ "Archive index of game " + std::to_string(k) + " points to game " + std::to_string(game.id) };
+		game.rounds = archive_io::read_u64(ifs);
+		for (std::uint64_t& s : game.score) s = archive_io::read_u64(ifs);
+		game.name_p1 = archive_io::read_string(ifs);
+		game.name_p2 = archive_io::read_string(ifs);
+		for (int p{}; p < 2; p += 1) {
+			game.encoding[p] = (Stream_Encoding)archive_io::read_u64(ifs);
+			game.payload_size[p] = archive_io::read_u64(ifs);
+			game.payload_offset[p] = (std::uint64_t)ifs.tellg();
+			ifs.seekg((std::streamoff)game.payload_size[p], std::ios::cur);
+		}
+		return game;
+	}
+
+	// stream() returns decoder for moves of player (0 or 1) in given game
+	Move_Stream stream(const Archived_Game& game, int player) {
+		return Move_Stream{ data_path, game.payload_offset[player], game.payload_size[player], game.encoding[player], game.rounds };
+	}
+
+	// read_moves() decodes complete move history of player (0 or 1) in game k
+	vector read_moves(std::uint64_t k, int player) {
+		Archived_Game game = read_game(k);
+		Move_Stream moves = stream(game, player);
+		vector history{};
+		short move{};
+		while (moves.next(move)) history.push_back(move);
+		return history;
+	}
+
+private:
+	// index record of game k: {block offset, block size, present flag}
+	std::vector<std::uint64_t> record(std::uint64_t k) {
+		std::uint8_t bytes[archive_index_record]{};
+		index.clear();
+		index.seekg((std::streamoff)(k * archive_index_record));
+		index.read((char*)bytes, archive_index_record);
+		return { archive_io::get_u64(bytes), archive_io::get_u64(bytes + 8), archive_io::get_u64(bytes + 16) };
+	}
+
+	std::string data_path{}, index_path{};
+	std::ifstream index{};
+	std::uint64_t slots{};
+};
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+
+#include "RPS_Header.h"
+#include "RPS_Batch.h"
+#include "RPS_Trace.h"
+#include "RPS_Query.h"
+#include "RPS_Archive.h"
+
+
+//// Offline backtesting: how would other strategies have done against recorded opponent move sequences
+
+// The backtest is open loop: the recorded opponent plays exactly its recorded moves, no matter what the candidate plays (so adaptive
+// opponents are replayed, not simulated). Every candidate is a batched strategy (see make_batch_strategy()) playing all sequences of a chunk
+// at once; all candidates advance round by round together, so the corpus is read once for all candidates. Chunks run in parallel.
+
+// Backtest_Sequence: recorded opponent moves (one byte per move) and where they come from
+struct Backtest_Sequence {
+	std::string name{};
+	std::vector<std::uint8_t> moves{};
+};
+
+
+// load_saved_moves() reads move column of Player 1 (side = 1) or Player 2 (side = 2) from saved game csv (see Game::save());
+// returns false if the file isn't a saved game
+bool load_saved_moves(const std::filesystem::path& csv_path, int side, std::vector<std::uint8_t>& moves) {
+	Mapped_File file{ csv_path.string() };
+	const std::string header{ "Move History P1," };
+	if (file.size() < header.size() or !(std::string(file.data(), header.size()) == header)) return false;
+
+	const char* p = file.data();
+	const char* end = p + file.size();
+	while (p < end) {
+		const char* line_end = (const char*)std::memchr(p, '\n', (std::size_t)(end - p));
+		if (!line_end) line_end = end;
+		if (line_end - p >= 5 and *p >= '0' and *p <= '2' and p[1] == ',' and p[2] >= '0' and p[2] <= '2' and p[3] == ',') {
+			moves.push_back((std::uint8_t)((side == 1 ? p[0] : p[2]) - '0'));
+		}
+		p = line_end + 1;
+	}
+	return true;
+}
+
+// load_backtest_corpus() collects opponent sequences (moves of Player side = 1 or 2) from a directory of saved games (recursive),
+// a single saved game csv or a game archive (<path>.rpsa / <path>.rpsi, all archived games)
+std::vector<Backtest_Sequence> load_backtest_corpus(std::string path, int side) {
+	if (!(side == 1 or side == 2)) throw std::invalid_argument{ "Opponent side has to be 1 or 2" };
+	std::vector<Backtest_Sequence> corpus{};
+
+	if (std::filesystem::exists(path + ".rpsa")) {
+		Archive_Reader reader{ path };
+		for (std::uint64_t k{}; k < reader.size(); k += 1) {
+			if (!reader.has_game(k)) continue;
+			Archived_Game game = reader.read_game(k);
+			Move_Stream stream = reader.stream(game, side - 1);
+			Backtest_Sequence sequence{ path + "#" + std::to_string(k) };
+			short move{};
+			while (stream.next(move)) sequence.moves.push_back((std::uint8_t)move);
+			corpus.push_back(sequence);
+		}
+		return corpus;
+	}
+
+	std::vector<std::filesystem::path> files{};
+	if (std::filesystem::is_directory(path)) {
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
+			if (entry.is_regular_file() and entry.path().extension() == ".csv") files.push_back(entry.path());
+		}
+		std::sort(files.begin(), files.end());
+	}
+	else files.push_back(path);
+
+	for (const std::filesystem::path& file : files) {
+		Backtest_Sequence sequence{ file.string() };
+		if (load_saved_moves(file, side, sequence.moves) and !sequence.moves.empty()) corpus.push_back(sequence);
+	}
+	return corpus;
+}
+
+
+// Backtest_Result: candidate x corpus matrix of round stats (seen from the candidate: outcome 1 is a candidate win, 2 a loss)
+struct Backtest_Result {
+	std::vector<std::string> candidates{};
+	std::vector<std::string> sequences{};
+	std::vector<Round_Stats> stats{}; // stats[candidate * sequences.size() + sequence]
+
+	const Round_Stats& at(std::size_t candidate, std::size_t sequence) const {
+		return stats[candidate * sequences.size() + sequence];
+	}
+
+	// total() merges the stats of candidate over the whole corpus (in corpus order)
+	Round_Stats total(std::size_t candidate) const {
+		Round_Stats sum{};
+		for (std::size_t s{}; s < sequences.size(); s += 1) sum.merge(at(candidate, s));
+		return sum;
+	}
+
+	// save() writes win rate matrix: one row per candidate, first column is the win rate over the whole corpus
+	bool save(std::string path) const {
+		std::ofstream ofs(path, std::ofstream::out);
+		if (!ofs.is_open()) return false;
+		ofs << "Candidate,All";
+		for (const std::string& name : sequences) ofs << ",\"" << name << "\"";
+		ofs << "\n";
+		for (std::size_t c{}; c < candidates.size(); c += 1) {
+			ofs << "\"" << candidates[c] << "\"," << total(c).rate(1);
+			for (std::size_t s{}; s < sequences.size(); s += 1) ofs << "," << at(c, s).rate(1);
+			ofs << "\n";
+		}
+		return true;
+	}
+};
+
+
+// run_backtest() plays every candidate (configuration strings, see make_batch_strategy()) against every sequence of the corpus
+// chunk_size: sequences per batch; sequences are sorted by length, so games of a batch end at about the same round
+Backtest_Result run_backtest(const std::vector<std::string>& candidates, const std::vector<Backtest_Sequence>& corpus, unsigned threads = 0, std::size_t chunk_size = 256) {
+	Backtest_Result result{};
+	result.candidates = candidates;
+	for (const Backtest_Sequence& sequence : corpus) result.sequences.push_back(sequence.name);
+	result.stats.assign(candidates.size() * corpus.size(), Round_Stats{});
+	for (const std::string& config : candidates) make_batch_strategy(config); // invalid candidates throw here, before any work starts
+
+	std::vector<std::size_t> order(corpus.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&corpus](std::size_t a, std::size_t b) { return corpus[a].moves.size() > corpus[b].moves.size(); });
+
+	std::size_t num_chunks = (corpus.size() + chunk_size - 1) / chunk_size;
+	if (threads == 0) threads = std::max(std::thread::hardware_concurrency(), 1u);
+	threads = (unsigned)std::min<std::size_t>(threads, std::max<std::size_t>(num_chunks, 1));
+
+	// every sequence belongs to exactly one chunk, so workers write disjoint stats
+	std::atomic<std::size_t> next_chunk{ 0 };
+	auto work = [&]() {
+		for (std::size_t chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+			Trace_Span span{ "backtest chunk" };
+			std::size_t begin = chunk * chunk_size, n = std::min(corpus.size(), begin + chunk_size) - begin;
+			const std::size_t* members = order.data() + begin; // longest first
+
+			std::vector<std::unique_ptr<Batch_Strategy>> strategies{};
+			for (const std::string& config : candidates) {
+				strategies.push_back(make_batch_strategy(config));
+				strategies.back()->reset(n);
+			}
+
+			std::vector<std::uint8_t> opponent(n, 0), moves(n);
+			std::size_t active = n; // sequences still running (sorted by length, so always a prefix of the chunk)
+			for (long long r{}; active > 0; r += 1) {
+				while (active > 0 and corpus[members[active - 1]].moves.size() <= (std::size_t)r) active -= 1;
+				for (std::size_t g{}; g < active; g += 1) opponent[g] = corpus[members[g]].moves[(std::size_t)r];
+
+				for (std::size_t c{}; c < strategies.size(); c += 1) {
+					strategies[c]->get_moves(r, moves.data());
+					Round_Stats* stats = result.stats.data() + c * corpus.size();
+					for (std::size_t g{}; g < active; g += 1) stats[members[g]].add(outcome_table[moves[g]][opponent[g]]);
+					strategies[c]->observe(moves.data(), opponent.data());
+				}
+			}
+		}
+	};
+
+	std::vector<std::thread> workers{};
+	for (unsigned t{ 1 }; t < threads; t += 1) workers.emplace_back(work);
+	work();
+	for (std::thread& worker : workers) worker.join();
+	return result;
+}
@@ -0,0 +1,585 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include "RPS_Header.h"
+#include "RPS_Plugin.h"
+#include "RPS_Workload.h"
+
+
+//// Batched strategies: one strategy object plays the same side of N independent games in lockstep
+
+// Instead of one virtual Player::get_move() call per game and round, a Batch_Strategy returns the moves of all N games in one call.
+// Per game state lives in struct of arrays (one array per state variable, indexed by game), and moves of a round are passed as packed
+// columns (one byte per game), so the per round work of every strategy is a plain loop over games the compiler can vectorize.
+// Batch strategies play exactly like their Player counterparts (Batch_Meta: as long as its scores don't fall below 1, see below).
+
+// Batch_Strategy: interface of batched strategies; Batch_Game calls get_moves() and observe() once per round
+struct Batch_Strategy {
+
+	// reset() prepares state for num_games new games
+	virtual void reset(std::size_t num_games) = 0;
+
+	// get_moves() writes next move of every game to moves (num_games entries); round is the number of rounds played so far
+	virtual void get_moves(long long round, std::uint8_t* moves) = 0;
+
+	// observe() gets the moves of the round just played: self (own moves) and other (opponent moves), one entry per game
+	virtual void observe(const std::uint8_t* self, const std::uint8_t* other) {}
+
+	// set_first_game() numbers the games of the next reset() from first on: seeded strategies play game g like game first + g of one
+	// large batch, so a batch can be split into ranges (e.g. over worker processes, see RPS_Workers.h) with the same results
+	virtual void set_first_game(std::size_t first) {}
+
+	virtual std::string get_name() = 0;
+
+	virtual ~Batch_Strategy() = default;
+};
+
+
+// Batch_Fixed: Fixed Player for N games
+struct Batch_Fixed : Batch_Strategy {
+
+	Batch_Fixed(char move) : fixed_move{ move } {}
+
+	void reset(std::size_t num_games) override {
+		games = num_games;
+	}
+
+	void get_moves(long long round, std::uint8_t* moves) override {
+		std::fill(moves, moves + games, fixed_move.index);
+	}
+
+	std::string get_name() override {
+		return std::string{ "Fixed Player (" } + fixed_move.shape() + ")";
+	}
+
+private:
+	Move fixed_move{};
+	std::size_t games{};
+};
+
+
+// Batch_Rotation: Rotation Player for N games (state: last opponent move)
+struct Batch_Rotation : Batch_Strategy {
+
+	Batch_Rotation(short by = 0) : rotation_by{ mod_euc(by, 3) } {}
+
+	void reset(std::size_t num_games) override {
+		last_other.assign(num_games, 0);
+	}
+
+	void get_moves(long long round, std::uint8_t* moves) override {
+		if (round == 0) {
+			std::fill(moves, moves + last_other.size(), (std::uint8_t)0);
+			return;
+		}
+		const std::uint8_t* other = last_other.data();
+		for (std::size_t g{}; g < last_other.size(); g += 1) moves[g] = rotation_table[other[g]][rotation_by];
+	}
+
+	void observe(const std::uint8_t* self, const std::uint8_t* other) override {
+		std::copy(other, other + last_other.size(), last_other.begin());
+	}
+
+	std::string get_name() override {
+		return "Rotation Player (" + std::to_string(rotation_by) + ")";
+	}
+
+private:
+	short rotation_by{};
+	std::vector<std::uint8_t> last_other{};
+};
+
+
+// Batch_Frequency: Frequency Player for N games (state: opponent move counts, one array per shape)
+struct Batch_Frequency : Batch_Strategy {
+
+	void reset(std::size_t num_games) override {
+		for (std::vector<std::uint32_t>& count : counts) count.assign(num_games, 0);
+	}
+
+	void get_moves(long long round, std::uint8_t* moves) override {
+		const std::uint32_t* c0 = counts[0].data(), * c1 = counts[1].data(), * c2 = counts[2].data();
+		for (std::size_t g{}; g < counts[0].size(); g += 1) {
+			// most frequent opponent move, first one wins ties (same as Frequency::get_move()); empty history gives Rock
+			std::uint8_t index = (c1[g] > c0[g] ? 1 : 0);
+			index = (c2[g] > std::max(c0[g], c1[g]) ? 2 : index);
+			moves[g] = (round == 0 ? 0 : rotation_table[index][1]);
+		}
+	}
+
+	void observe(const std::uint8_t* self, const std::uint8_t* other) override {
+		std::uint32_t* c0 = counts[0].data(), * c1 = counts[1].data(), * c2 = counts[2].data();
+		for (std::size_t g{}; g < counts[0].size(); g += 1) {
+			c0[g] += (other[g] == 0);
+			c1[g] += (other[g] == 1);
+			c2[g] += (other[g] == 2);
+		}
+	}
+
+	std::string get_name() override {
+		return "Frequency Player";
+	}
+
+private:
+	std::vector<std::uint32_t> counts[3]{};
+};
+
+
+// Batch_Anti_Rotation: Anti_Rotation Player for N games (state: last two own moves, last opponent move)
+struct Batch_Anti_Rotation : Batch_Strategy {
+
+	void reset(std::size_t num_games) override {
+		prev_self.assign(num_games, 0);
+		last_self.assign(num_games, 0);
+		last_other.assign(num_games, 0);
+	}
+
+	void get_moves(long long round, std::uint8_t* moves) override {
+		if (round < 2) {
+			std::fill(moves, moves + last_self.size(), (std::uint8_t)0);
+			return;
+		}
+		for (std::size_t g{}; g < last_self.size(); g += 1) {
+			moves[g] = rotation_table[last_self[g]][rotation_table[outcome_table[last_other[g]][prev_self[g]]][1]];
+		}
+	}
+
+	void observe(const std::uint8_t* self, const std::uint8_t* other) override {
+		prev_self.swap(last_self);
+		std::copy(self, self + last_self.size(), last_self.begin());
+		std::copy(other, other + last_other.size(), last_other.begin());
+	}
+
+	std::string get_name() override {
+		return "Anti Rotation Player";
+	}
+
+private:
+	std::vector<std::uint8_t> prev_self{}, last_self{}, last_other{};
+};
+
+
+// Batch_Random: seeded Random Player for N games; game g plays like Random{ seed + first game + g }
+struct Batch_Random : Batch_Strategy {
+
+	Batch_Random(int seed) : seed{ seed } {}
+
+	void reset(std::size_t num_games) override {
+		engines.clear();
+		for (std::size_t g{}; g < num_games; g += 1) engines.emplace_back(seed + (int)(first_game + g));
+	}
+
+	void set_first_game(std::size_t first) override {
+		first_game = first;
+	}
+
+	void get_moves(long long round, std::uint8_t* moves) override {
+		for (std::size_t g{}; g < engines.size(); g += 1) moves[g] = (std::uint8_t)mod_euc(distribution(engines[g]), 3);
+	}
+
+	std::string get_name() override {
+		return "Random Player";
+	}
+
+private:
+	int seed{};
+	std::size_t first_game{};
+	std::vector<std::mt19937> engines{};
+	std::uniform_int_distribution<int> distribution{};
+};
+
+
+// Meta_Kernel: one round of Meta_Player_Naive with its four built-in oracles on a condensed state, shared by Batch_Meta and the Meta Player
+// model of the adversarial search (Meta_Model in RPS_Adversary.h). Meta Player asks its oracles from the opponent's point of view (see
+// Meta_Player_Naive::get_move()), so they predict the opponent's next move from Meta Player's own move counts and last moves only.
+// Scores are indexed by rotation * 4 + oracle (0 Frequency, 1 Anti_Rotation, 2 Rotation, 3 Fixed)
+struct Meta_Kernel {
+
+	// predict() writes the oracle predictions after rounds rounds (c0-c2: Meta Player's move counts, only compared with each other)
+	static void predict(std::uint32_t c0, std::uint32_t c1, std::uint32_t c2, std::uint8_t last_self, std::uint8_t last_other, std::uint8_t prev_other, \
+		long long rounds, std::uint8_t predictions[4]) {
+		std::uint8_t index = (c1 > c0 ? 1 : 0);
+		index = (c2 > std::max(c0, c1) ? 2 : index);
+		predictions[0] = rotation_table[index][1]; // Frequency
+		predictions[1] = (rounds < 2 ? 0 : rotation_table[last_other][rotation_table[outcome_table[last_self][prev_other]][1]]); // Anti_Rotation
+		predictions[2] = last_self; // Rotation by 0
+		predictions[3] = 0; // Fixed (R)
+	}
+
+	// move() of score k: prediction of its oracle rotated by k / 4
+	static std::uint8_t move(int k, std::uint8_t prediction) {
+		return rotation_table[prediction][k / 4];
+	}
+
+	// outcome() of score k's move against the opponent's move (passed to the scoring function)
+	static short outcome(int k, std::uint8_t prediction, std::uint8_t other) {
+		return outcome_table[move(k, prediction)][other];
+	}
+
+	// best() returns the first maximum of the 12 scores (score(k)), or -1 if all of them are below 1 (Meta Player plays a random move)
+	template<typename Score>
+	static int best(Score score) {
+		double max{};
+		int best{ -1 };
+		for (int k{}; k < 12; k += 1) {
+			if (score(k) > max) {
+				max = score(k);
+				best = k;
+			}
+		}
+		return (max >= 1 ? best : -1);
+	}
+};
+
+
+// Batch_Meta: Meta_Player_Naive for N games with the four built-in oracles (see Meta_Kernel)
+// State per game: 12 scores (one array each), the oracle predictions made last round and what the oracles need to predict (Meta
+// Player's own move counts and last moves). The random fallback (all scores below 1) uses a seeded engine per game instead of Meta
+// Player's unseeded one, so it only matches Meta_Player_Naive if scores stay >= 1.
+struct Batch_Meta : Batch_Strategy {
+
+	Batch_Meta(scoring_func_ptr scoring_func, double scoring_vector[6], int seed = 0) : scoring_func{ scoring_func }, seed{ seed } {
+		for (int k{}; k < 6; k += 1) this->scoring_vector[k] = scoring_vector[k];
+	}
+
+	void reset(std::size_t num_games) override {
+		games = num_games;
+		for (std::vector<double>& score : scores) score.assign(num_games, 1);
+		for (std::vector<std::uint8_t>& prediction : predictions) prediction.assign(num_games, 0);
+		for (std::vector<std::uint32_t>& count : self_counts) count.assign(num_games, 0);
+		last_self.assign(num_games, 0);
+		last_other.assign(num_games, 0);
+		prev_other.assign(num_games, 0);
+		engines.clear();
+		for (std::size_t g{}; g < num_games; g += 1) engines.emplace_back(seed + (int)(first_game + g));
+	}
+
+	void set_first_game(std::size_t first) override {
+		first_game = first;
+	}
+
+	void get_moves(long long round, std::uint8_t* moves) override {
+		if (round == 0) {
+			std::fill(moves, moves + games, (std::uint8_t)0);
+			return;
+		}
+
+		// score last round's predictions (rotated by 0-2) against the opponent's last move
+		if (scoring_func == naive_score_mul) update_scores<naive_score_mul>();
+		else if (scoring_func == naive_score_add) update_scores<naive_score_add>();
+		else if (scoring_func == drop_switch_mul) update_scores<drop_switch_mul>();
+		else if (scoring_func == drop_switch_add) update_scores<drop_switch_add>();
+		else update_scores_generic();
+
+		predict(round);
+
+		// play prediction of best scoring oracle and rotation (first maximum wins, same order as Meta_Player_Naive)
+		for (std::size_t g{}; g < games; g += 1) {
+			int best = Meta_Kernel::best([&](int k) { return scores[k][g]; });
+			if (best < 0) moves[g] = (std::uint8_t)mod_euc(distribution(engines[g]), 3);
+			else moves[g] = Meta_Kernel::move(best, predictions[best % 4][g]);
+		}
+	}
+
+	void observe(const std::uint8_t* self, const std::uint8_t* other) override {
+		std::uint32_t* c0 = self_counts[0].data(), * c1 = self_counts[1].data(), * c2 = self_counts[2].data();
+		for (std::size_t g{}; g < games; g += 1) {
+			c0[g] += (self[g] == 0);
+			c1[g] += (self[g] == 1);
+			c2[g] += (self[g] == 2);
+		}
+		prev_other.swap(last_other);
+		std::copy(self, self + games, last_self.begin());
+		std::copy(other, other + games, last_other.begin());
+	}
+
+	// score of given rotation and oracle (0 Frequency, 1 Anti_Rotation, 2 Rotation, 3 Fixed) in game g
+	double get_score(std::size_t g, int rotation, int oracle) {
+		return scores[rotation * 4 + oracle][g];
+	}
+
+	std::string get_name() override {
+		return "Naive Meta Player";
+	}
+
+private:
+	// scores[rotation * 4 + oracle][g] += scoring function of outcome of rotated prediction against opponent's last move
+	template<scoring_func_ptr F>
+	void update_scores() {
+		for (int k{}; k < 12; k += 1) {
+			double* score = scores[k].data();
+			const std::uint8_t* prediction = predictions[k % 4].data();
+			for (std::size_t g{}; g < games; g += 1) F(score[g], Meta_Kernel::outcome(k, prediction[g], last_other[g]), scoring_vector);
+		}
+	}
+
+	void update_scores_generic() {
+		for (int k{}; k < 12; k += 1) {
+			for (std::size_t g{}; g < games; g += 1) {
+				scoring_func(scores[k][g], Meta_Kernel::outcome(k, predictions[k % 4][g], last_other[g]), scoring_vector);
+			}
+		}
+	}
+
+	// oracle predictions given histories of length round (oracles see Meta Player's moves as opponent moves)
+	void predict(long long round) {
+		const std::uint32_t* c0 = self_counts[0].data(), * c1 = self_counts[1].data(), * c2 = self_counts[2].data();
+		for (std::size_t g{}; g < games; g += 1) {
+			std::uint8_t next[4]{};
+			Meta_Kernel::predict(c0[g], c1[g], c2[g], last_self[g], last_other[g], prev_other[g], round, next);
+			for (int j{}; j < 4; j += 1) predictions[j][g] = next[j];
+		}
+	}
+
+	scoring_func_ptr scoring_func{};
+	double scoring_vector[6]{};
+	int seed{};
+	std::size_t first_game{};
+
+	std::size_t games{};
+	std::vector<double> scores[12]{};
+	std::vector<std::uint8_t> predictions[4]{};
+	std::vector<std::uint32_t> self_counts[3]{};
+	std::vector<std::uint8_t> last_self{}, last_other{}, prev_other{};
+	std::vector<std::mt19937> engines{};
+	std::uniform_int_distribution<int> distribution{};
+};
+
+
+// Batch_Plugin: plugin strategy for N games; all games are answered by one rps_get_moves call per round
+struct Batch_Plugin : Batch_Strategy {
+
+	Batch_Plugin(std::shared_ptr<Plugin_Library> library) : library{ library } {}
+
+	Batch_Plugin(const Batch_Plugin&) = delete;
+	Batch_Plugin& operator=(const Batch_Plugin&) = delete;
+
+	~Batch_Plugin() {
+		for (void* instance : instances) library->destroy(instance);
+	}
+
+	void reset(std::size_t num_games) override {
+		for (void* instance : instances) library->destroy(instance);
+		instances.clear();
+		for (std::size_t g{}; g < num_games; g += 1) instances.push_back(library->create());
+		packed_other.assign(num_games, {});
+		packed_self.assign(num_games, {});
+		histories.assign(num_games, rps_history{});
+	}
+
+	void get_moves(long long round, std::uint8_t* moves) override {
+		for (std::size_t g{}; g < instances.size(); g += 1) {
+			histories[g] = rps_history{ packed_other[g].data(), packed_self[g].data(), packed_self[g].size() };
+		}
+		library->get_moves(instances.data(), histories.data(), moves, instances.size());
+	}
+
+	void observe(const std::uint8_t* self, const std::uint8_t* other) override {
+		for (std::size_t g{}; g < instances.size(); g += 1) {
+			packed_self[g].push_back(self[g]);
+			packed_other[g].push_back(other[g]);
+		}
+	}
+
+	std::string get_name() override {
+		return library->get_name();
+	}
+
+private:
+	std::shared_ptr<Plugin_Library> library;
+	std::vector<void*> instances{};
+	std::vector<std::vector<std::uint8_t>> packed_other{}, packed_self{};
+	std::vector<rps_history> histories{};
+};
+
+
+// Batch_Workload: workload opponent (see RPS_Workload.h) for N games; game g plays like Workload_Player with seed + first game + g.
+// All four basic strategies play every game (one vectorizable loop each), the decisions of every game select one of their moves;
+// decisions are filled block_rounds rounds at a time per game
+struct Batch_Workload : Batch_Strategy {
+
+	Batch_Workload(const Workload_Config& config) : config{ config } {}
+
+	Batch_Workload(const Batch_Workload&) = delete; // basics point into the object
+	Batch_Workload& operator=(const Batch_Workload&) = delete;
+
+	void reset(std::size_t num_games) override {
+		games = num_games;
+		streams.clear();
+		for (std::size_t g{}; g < num_games; g += 1) streams.emplace_back(config, config.seed + first_game + g);
+		decisions.assign(num_games * block_rounds, 0);
+		for (std::vector<std::uint8_t>& column : basic_moves) column.assign(num_games, 0);
+		for (Batch_Strategy* basic : basics) basic->reset(num_games);
+	}
+
+	void set_first_game(std::size_t first) override {
+		first_game = first;
+	}
+
+	void get_moves(long long round, std::uint8_t* moves) override {
+		std::size_t r = (std::size_t)round % block_rounds;
+		if (r == 0) {
+			for (std::size_t g{}; g < games; g += 1) streams[g].fill(&decisions[g * block_rounds], block_rounds);
+		}
+		for (int k{}; k < 4; k += 1) basics[k]->get_moves(round, basic_moves[k].data());
+		for (std::size_t g{}; g < games; g += 1) {
+			std::uint8_t decision = decisions[g * block_rounds + r];
+			if (Workload_Stream::is_noise(decision)) moves[g] = (std::uint8_t)Workload_Stream::noise_move(decision);
+			else moves[g] = rotation_table[basic_moves[Workload_Stream::strategy_of(decision)][g]][Workload_Stream::rotation_of(decision)];
+		}
+	}
+
+	void observe(const std::uint8_t* self, const std::uint8_t* other) override {
+		for (Batch_Strategy* basic : basics) basic->observe(self, other);
+	}
+
+	std::string get_name() override {
+		return "Workload Player";
+	}
+
+	static constexpr std::size_t block_rounds{ 256 };
+
+private:
+	Workload_Config config{};
+	std::size_t games{}, first_game{};
+	std::vector<Workload_Stream> streams{};
+	std::vector<std::uint8_t> decisions{}; // decisions[game * block_rounds + round in block]
+	std::vector<std::uint8_t> basic_moves[4]{};
+
+	// same order as Workload_Player's strategies
+	Batch_Frequency frequency{};
+	Batch_Anti_Rotation anti_rotation{};
+	Batch_Rotation rotation{ 0 };
+	Batch_Fixed fixed{ 'R' };
+	Batch_Strategy* basics[4]{ &frequency, &anti_rotation, &rotation, &fixed };
+};
+
+
+// parse_meta_config() reads scoring function and vector of a Meta Player configuration (Meta_Player_Naive(<scoring function>,{<6 values
+// separated by ;>}), see Meta_Player_Naive::get_config(); plain Meta is the default scoring); returns false if config isn't a Meta Player.
+// Throws std::invalid_argument for unknown scoring functions or malformed scoring vectors
+bool parse_meta_config(std::string config, scoring_func_ptr& scoring_func, double scoring_vector[6]) {
+	static const double default_scoring_vector[6]{ 0.95, 1.1, 0.9, 1, 10, 1 };
+	std::string name = config.substr(0, config.find('('));
+	std::string arg{};
+	if (config.find('(') != std::string::npos) arg = config.substr(config.find('(') + 1, config.rfind(')') - config.find('(') - 1);
+	if (!(name == "Meta" or name == "Meta_Player_Naive")) return false;
+	if (arg.empty()) {
+		scoring_func = naive_score_mul;
+		for (int k{}; k < 6; k += 1) scoring_vector[k] = default_scoring_vector[k];
+		return true;
+	}
+
+	std::string func = arg.substr(0, arg.find(','));
+	if (func == "naive_score_mul") scoring_func = naive_score_mul;
+	else if (func == "naive_score_add") scoring_func = naive_score_add;
+	else if (func == "drop_switch_mul") scoring_func = drop_switch_mul;
+	else if (func == "drop_switch_add") scoring_func = drop_switch_add;
+	else throw std::invalid_argument{ "Unknown scoring function " + func };
+
+	std::size_t open = arg.find('{'), close = arg.find('}');
+	if (open == std::string::npos or close == std::string::npos) throw std::invalid_argument{ "Missing scoring vector in " + config };
+	std::istringstream iss{ arg.substr(open + 1, close - open - 1) };
+	std::string value{};
+	for (int k{}; k < 6; k += 1) {
+		if (!std::getline(iss, value, ';')) throw std::invalid_argument{ "Scoring vector needs 6 values in " + config };
+		scoring_vector[k] = std::stod(value);
+	}
+	return true;
+}
+
+// make_batch_strategy() creates batched strategy from its configuration string (same format as Player::get_config(): Fixed(R),
+// Rotation(1), Frequency, Anti_Rotation, Random(seed), Meta_Player_Naive(<scoring function>,{<6 values separated by ;>}), Workload(...)); plain
+// Meta uses the default scoring. Throws std::invalid_argument for unknown strategies
+std::unique_ptr<Batch_Strategy> make_batch_strategy(std::string config) {
+	std::string name = config.substr(0, config.find('('));
+	std::string arg{};
+	if (config.find('(') != std::string::npos) arg = config.substr(config.find('(') + 1, config.rfind(')') - config.find('(') - 1);
+
+	if (name == "Fixed" and arg.size() == 1) return std::make_unique<Batch_Fixed>(arg[0]);
+	if (name == "Rotation") return std::make_unique<Batch_Rotation>((short)std::stoi(arg.empty() ? "0" : arg));
+	if (name == "Frequency") return std::make_unique<Batch_Frequency>();
+	if (name == "Anti_Rotation") return std::make_unique<Batch_Anti_Rotation>();
+	if (name == "Random") return std::make_unique<Batch_Random>(std::stoi(arg.empty() ? "0" : arg));
+	if (name == "Workload") return std::make_unique<Batch_Workload>(Workload_Config::parse(config));
+	scoring_func_ptr scoring_func{};
+	double scoring_vector[6]{};
+	if (parse_meta_config(config, scoring_func, scoring_vector)) return std::make_unique<Batch_Meta>(scoring_func, scoring_vector);
+	throw std::invalid_argument{ "Unknown batch strategy " + config };
+}
+
+
+// Batch_Game: plays num_games independent games between two batched strategies in lockstep (one get_moves() call per side and round)
+struct Batch_Game {
+
+	// store_histories: keep move columns of every round (num_games bytes per player and round), needed for get_result() histories
+	Batch_Game(Batch_Strategy& s1, Batch_Strategy& s2, std::size_t num_games, long long num_rounds, bool store_histories = false) : \
+		s1{ s1 }, s2{ s2 }, num_games{ num_games }, num_rounds{ num_rounds }, store_histories{ store_histories } {}
+
+	void play() {
+		s1.reset(num_games);
+		s2.reset(num_games);
+		stats.assign(num_games, Round_Stats{});
+		history_p1.clear();
+		history_p2.clear();
+
+		std::vector<std::uint8_t> moves_p1(num_games), moves_p2(num_games);
+		for (long long r{}; r < num_rounds; r += 1) {
+			s1.get_moves(r, moves_p1.data());
+			s2.get_moves(r, moves_p2.data());
+			for (std::size_t g{}; g < num_games; g += 1) stats[g].add(outcome_table[moves_p1[g]][moves_p2[g]]);
+			s1.observe(moves_p1.data(), moves_p2.data());
+			s2.observe(moves_p2.data(), moves_p1.data());
+			if (store_histories) {
+				history_p1.insert(history_p1.end(), moves_p1.begin(), moves_p1.end());
+				history_p2.insert(history_p2.end(), moves_p2.begin(), moves_p2.end());
+			}
+		}
+	}
+
+	// get_result() returns result of game g (histories only if stored)
+	Game_Result get_result(std::size_t g) {
+		Game_Result result{ num_rounds };
+		for (int k{}; k < 3; k += 1) result.score[k] = (long long)stats[g].get_score((short)k);
+		result.has_histories = store_histories;
+		if (store_histories) {
+			for (long long r{}; r < num_rounds; r += 1) {
+				short m1 = history_p1[(std::size_t)r * num_games + g], m2 = history_p2[(std::size_t)r * num_games + g];
+				result.move_history_p1.push_back(m1);
+				result.move_history_p2.push_back(m2);
+				result.win_history.push_back(evaluate_round(Move{ m1 }, Move{ m2 }));
+			}
+		}
+		return result;
+	}
+
+	// get_stats() returns the stats of game g
+	const Round_Stats& get_stats(std::size_t g) const {
+		return stats[g];
+	}
+
+	// total() merges the stats of all games (in game order, as if they had been played one after the other)
+	Round_Stats total() const {
+		Round_Stats sum{};
+		for (const Round_Stats& game_stats : stats) sum.merge(game_stats);
+		return sum;
+	}
+
+private:
+	Batch_Strategy& s1;
+	Batch_Strategy& s2;
+	std::size_t num_games{};
+	long long num_rounds{};
+	bool store_histories{};
+
+	std::vector<Round_Stats> stats{}; // per game
+	std::vector<std::uint8_t> history_p1{}, history_p2{}; // round major move columns
+};
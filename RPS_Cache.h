@@ -0,0 +1,145 @@
+#pragma once
+
+#include <string>
+#include <map>
+#include <cstdint>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <stdexcept>
+
+#include "RPS_Header.h"
+
+
+//// Result cache: stores results of reproducible Games on disk, keyed by a hash of their canonical configuration (see Game::get_config())
+
+// Cache directory layout:
+//   index.txt        one line per stored result: <key hash> <rounds> <draws> <p1 wins> <p2 wins> <has histories> <configuration>
+//   <key hash>.csv   move and win histories of a result (only if histories were stored)
+// The full configuration is stored next to its hash, so hash collisions are detected instead of returning a wrong result
+struct Result_Cache {
+
+	// store_histories: also store move and win histories of games with up to max_history_rounds rounds (larger cache, but cached games
+	// can be saved like played ones); longer games are cached without histories, their CSV files would grow with the rounds
+	Result_Cache(std::string dir, bool store_histories = true, long long max_history_rounds = 10000) : \
+		dir{ dir }, store_histories{ store_histories }, max_history_rounds{ max_history_rounds } {
+		load_index();
+	}
+
+	// lookup() writes stored result for given configuration to result and returns true; returns false if configuration isn't cached
+	bool lookup(const std::string& config, Game_Result& result) {
+		auto entry = index.find(hash(config));
+		if (entry == index.end() or !(entry->second.config == config)) return false;
+
+		result = Game_Result{ entry->second.num_rounds };
+		for (int k{}; k < 3; k += 1) result.score[k] = entry->second.score[k];
+		if (entry->second.has_histories) result.has_histories = load_histories(entry->first, result);
+		return true;
+	}
+
+	// store() adds result to cache (appends to index file); throws std::runtime_error if cache directory isn't writable
+	void store(const std::string& config, const Game_Result& result) {
+		std::error_code ec{};
+		std::filesystem::create_directories(dir, ec);
+
+		bool with_histories = store_histories and result.has_histories and result.num_rounds <= max_history_rounds;
+		Entry entry{ config, result.num_rounds, { result.score[0], result.score[1], result.score[2] }, with_histories };
+		std::uint64_t key = hash(config);
+		if (entry.has_histories) save_histories(key, result);
+
+		std::ofstream ofs(index_path(), std::ofstream::app);
+		if (!ofs.is_open()) throw std::runtime_error{ "Unable to write result cache index " + index_path() };
+		ofs << to_hex(key) << " " << entry.num_rounds << " " << entry.score[0] << " " << entry.score[1] << " " << entry.score[2] << " " \
+			<< entry.has_histories << " " << config << "\n";
+		index[key] = entry; // later lines overwrite earlier ones when loading, same as here
+	}
+
+	std::size_t size() {
+		return index.size();
+	}
+
+	// FNV-1a hash of canonical configuration string
+	static std::uint64_t hash(const std::string& config) {
+		std::uint64_t h{ 14695981039346656037ull };
+		for (unsigned char c : config) {
+			h ^= c;
+			h *= 1099511628211ull;
+		}
+		return h;
+	}
+
+private:
+	struct Entry {
+		std::string config{};
+		long long num_rounds{};
+		long long score[3]{ 0, 0, 0 };
+		bool has_histories{};
+	};
+
+	std::string index_path() {
+		return (std::filesystem::path{ dir } / "index.txt").string();
+	}
+
+	std::string histories_path(std::uint64_t key) {
+		return (std::filesystem::path{ dir } / (to_hex(key) + ".csv")).string();
+	}
+
+	static std::string to_hex(std::uint64_t key) {
+		std::ostringstream oss{};
+		oss << std::hex << key;
+		return oss.str();
+	}
+
+	// missing index file is an empty cache; malformed lines are skipped
+	void load_index() {
+		std::ifstream ifs(index_path());
+		std::string line{};
+		while (std::getline(ifs, line)) {
+			std::istringstream iss{ line };
+			std::string key_hex{};
+			Entry entry{};
+			if (!(iss >> key_hex >> entry.num_rounds >> entry.score[0] >> entry.score[1] >> entry.score[2] >> entry.has_histories)) continue;
+			std::uint64_t key{};
+			auto [end, ec] = std::from_chars(key_hex.data(), key_hex.data() + key_hex.size(), key, 16);
+			if (ec != std::errc{} or end != key_hex.data() + key_hex.size()) continue;
+			iss.get(); // skip separator
+			std::getline(iss, entry.config);
+			index[key] = entry;
+		}
+	}
+
+	void save_histories(std::uint64_t key, const Game_Result& result) {
+		std::ofstream ofs(histories_path(key), std::ofstream::out);
+		if (!ofs.is_open()) throw std::runtime_error{ "Unable to write result cache file " + histories_path(key) };
+		ofs << "Move History P1,Move History P2,Win History\n";
+		for (std::size_t i{}; i < result.win_history.size(); i += 1) {
+			ofs << result.move_history_p1[i] << "," << result.move_history_p2[i] << "," << result.win_history[i] << "\n";
+		}
+	}
+
+	// returns false if histories file is missing or incomplete (result is then used without histories)
+	bool load_histories(std::uint64_t key, Game_Result& result) {
+		std::ifstream ifs(histories_path(key));
+		std::string line{};
+		if (!std::getline(ifs, line)) return false; // header
+		short m1{}, m2{}, outcome{};
+		char sep{};
+		while (ifs >> m1 >> sep >> m2 >> sep >> outcome) {
+			result.move_history_p1.push_back(m1);
+			result.move_history_p2.push_back(m2);
+			result.win_history.push_back(outcome);
+		}
+		if ((long long)result.win_history.size() == result.num_rounds) return true;
+
+		result.move_history_p1 = {};
+		result.move_history_p2 = {};
+		result.win_history = {};
+		return false;
+	}
+
+	std::string dir{};
+	bool store_histories{};
+	long long max_history_rounds{};
+	std::map<std::uint64_t, Entry> index{};
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <stdexcept>
+
+#include "RPS_Header.h"
+
+
+//// Cyclic games with K shapes: Rock-Paper-Scissors-Lizard-Spock (K = 5) and larger odd K, specialized at compile time
+
+// The engine in RPS_Header.h is templated on the number of shapes (see Cyclic_Rules): Cyclic_Game<K> with the strategies Cyclic_Fixed<K>,
+// Cyclic_Rotation<K>, Cyclic_Frequency<K>, Cyclic_Anti_Rotation<K>, Cyclic_Random<K> and Cyclic_Meta_Player_Naive<K> is the same code as
+// Game with Fixed, Rotation, ... (the K = 3 instantiations), so cyclic games have bounded histories, cycle detection, move budgets and
+// Meta Player's oracle pool, warm start and additional oracles as well. Tables are generated at compile time and loops over shapes have a
+// constant trip count, so every K gets its own code.
+
+// make_cyclic_player() creates a strategy of a K shape game from its configuration string (Fixed(<shape>), Rotation(n), Frequency,
+// Anti_Rotation, Random(seed), Meta); throws std::invalid_argument for unknown strategies
+template<int K>
+std::unique_ptr<Cyclic_Player<K>> make_cyclic_player(std::string config) {
+	static double default_scoring_vector[6]{ 0.95, 1.1, 0.9, 1, 10, 1 };
+	std::string name = config.substr(0, config.find('('));
+	std::string arg{};
+	if (config.find('(') != std::string::npos) arg = config.substr(config.find('(') + 1, config.rfind(')') - config.find('(') - 1);
+
+	if (name == "Fixed" and arg.size() == 1 and Cyclic_Rules<K>::index(arg[0]) >= 0) return std::make_unique<Cyclic_Fixed<K>>(arg[0]);
+	if (name == "Rotation") {
+		short by = (short)std::stoi(arg.empty() ? "0" : arg);
+		return std::make_unique<Cyclic_Rotation<K>>(by, "(" + std::to_string(mod_euc(by, K)) + ")");
+	}
+	if (name == "Frequency") return std::make_unique<Cyclic_Frequency<K>>();
+	if (name == "Anti_Rotation") return std::make_unique<Cyclic_Anti_Rotation<K>>();
+	if (name == "Random") return std::make_unique<Cyclic_Random<K>>(std::stoi(arg.empty() ? "0" : arg));
+	if (name == "Meta" and arg.empty()) return std::make_unique<Cyclic_Meta_Player_Naive<K>>(false, "", naive_score_mul, default_scoring_vector);
+	throw std::invalid_argument{ "Unknown strategy " + config + " for " + std::to_string(K) + " shapes" };
+}
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <thread>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+
+#include "RPS_Header.h"
+#include "RPS_Trace.h"
+
+
+//// Evolutionary population simulator: replicator dynamics over the basic Player strategies
+
+// Agents are stored as struct of arrays (one genome byte and one fitness value per agent, no Player object per agent), so populations of
+// tens of millions of agents fit into memory. Match state only exists while two agents play each other and lives on the worker's stack.
+// Results are deterministic for given seed regardless of number of threads: every match and every offspring draws from its own
+// counter based random stream, and work is split into chunks whose boundaries don't depend on the number of threads.
+
+// Genome: one of the basic strategies with its parameter; index into genomes array is what agents store
+struct Genome {
+	enum Type : std::uint8_t { fixed, rotation, frequency, anti_rotation, random } type;
+	short param; // fixed move index or rotation
+	const char* name;
+};
+
+const Genome genomes[]{
+	{ Genome::fixed, 0, "Fixed(R)" }, { Genome::fixed, 1, "Fixed(P)" }, { Genome::fixed, 2, "Fixed(S)" },
+	{ Genome::rotation, 0, "Rotation(0)" }, { Genome::rotation, 1, "Rotation(1)" }, { Genome::rotation, 2, "Rotation(2)" },
+	{ Genome::frequency, 0, "Frequency" }, { Genome::anti_rotation, 0, "Anti_Rotation" }, { Genome::random, 0, "Random" }
+};
+const int num_genomes{ sizeof(genomes) / sizeof(Genome) };
+
+
+// splitmix64: counter based random stream used for pairing, matches and reproduction (cheap to seed per match / per agent)
+inline std::uint64_t splitmix64(std::uint64_t& state) {
+	std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+// mix_seed() derives an independent stream seed from simulation seed, generation and item index
+inline std::uint64_t mix_seed(std::uint64_t seed, std::uint64_t generation, std::uint64_t index) {
+	std::uint64_t state = seed ^ (generation * 0xD1B54A32D192ED03ull) ^ (index * 0x8CB92BA72F3D8DD7ull);
+	return splitmix64(state);
+}
+
+// uniform double in [0, 1) from random stream
+inline double uniform01(std::uint64_t& state) {
+	return (double)(splitmix64(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+// Agent_Match_State: everything one side of a match needs to play like the corresponding Player (see Player::get_move() implementations)
+struct Agent_Match_State {
+	std::uint64_t rng{};
+	std::uint32_t other_count[3]{ 0, 0, 0 }; // Frequency: opponent move counts
+	short last_self{}, prev_self{}, last_other{}; // Rotation / Anti_Rotation: last moves
+	long long rounds{};
+
+	// agent_move() mirrors Fixed, Rotation, Frequency, Anti_Rotation and Random Player decisions on compact state
+	short agent_move(const Genome& genome) noexcept {
+		switch (genome.type) {
+		case Genome::fixed:
+			return genome.param;
+		case Genome::rotation:
+			if (rounds == 0) return 0;
+			return rotation_table[last_other][genome.param];
+		case Genome::frequency: {
+			if (rounds == 0) return 0;
+			std::uint32_t max{};
+			short index{};
+			for (short i{}; i < 3; i += 1) {
+				if (other_count[i] > max) {
+					max = other_count[i];
+					index = i;
+				}
+			}
+			return rotation_table[index][1];
+		}
+		case Genome::anti_rotation:
+			if (rounds < 2) return 0;
+			return rotation_table[last_self][rotation_table[outcome_table[last_other][prev_self]][1]];
+		case Genome::random:
+			return (short)(splitmix64(rng) % 3);
+		}
+		return 0;
+	}
+
+	void observe(short self_move, short other_move) noexcept {
+		prev_self = last_self;
+		last_self = self_move;
+		last_other = other_move;
+		other_count[other_move] += 1;
+		rounds += 1;
+	}
+};
+
+// play_match() plays given number of rounds between two genomes; returns wins of first agent minus wins of second agent
+inline long long play_match(const Genome& g1, const Genome& g2, long long rounds, std::uint64_t match_seed) {
+	Agent_Match_State s1{ match_seed }, s2{ match_seed ^ 0x5851F42D4C957F2Dull };
+	long long balance{};
+	for (long long r{}; r < rounds; r += 1) {
+		short m1 = s1.agent_move(g1);
+		short m2 = s2.agent_move(g2);
+		short index_distance = outcome_table[m1][m2]; // same as evaluate_round()
+		if (index_distance == 1) balance += 1;
+		else if (index_distance == 2) balance -= 1;
+		s1.observe(m1, m2);
+		s2.observe(m2, m1);
+	}
+	return balance;
+}
+
+
+// Evolution_Config: simulation parameters
+struct Evolution_Config {
+	std::size_t population{ 100000 };
+	int generations{ 100 };
+	long long rounds_per_match{ 20 };
+	double mutation_rate{ 0.001 }; // probability that an offspring gets a uniformly random genome instead of its parent's
+	double selection{ 1 }; // selection strength w: fitness = 1 + w * (wins - losses) / rounds (clamped at 0)
+	std::uint64_t seed{ 1 };
+	unsigned threads{ 0 }; // 0: use all hardware threads
+	std::vector<double> initial_mix{}; // weight per genome for initial population (empty: uniform)
+};
+
+
+struct Evolution_Simulator {
+
+	Evolution_Simulator(Evolution_Config config) : config{ config } {
+		if (config.population < 2) throw std::domain_error{ "Population needs at least 2 agents" };
+		if (!config.initial_mix.empty() and config.initial_mix.size() != num_genomes) throw std::domain_error{ "Initial mix needs one weight per genome" };
+		if (this->config.threads == 0) this->config.threads = std::max(1u, std::thread::hardware_concurrency());
+
+		genome.resize(config.population);
+		next_genome.resize(config.population);
+		fitness.resize(config.population);
+		order.resize(config.population);
+		cumulative.resize(config.population);
+
+		// initial population: genome i gets its share of the population according to initial mix (uniform by default)
+		std::vector<double> mix = config.initial_mix;
+		if (mix.empty()) mix.assign(num_genomes, 1);
+		double total{};
+		for (double w : mix) total += w;
+		if (!(total > 0)) throw std::domain_error{ "Initial mix weights must add up to a positive value" };
+		for (std::size_t i{}; i < config.population; i += 1) {
+			std::uint64_t rng = mix_seed(config.seed, 0, i);
+			double u = uniform01(rng) * total;
+			std::uint8_t g{};
+			while (g + 1 < num_genomes and u >= mix[g]) {
+				u -= mix[g];
+				g += 1;
+			}
+			genome[i] = g;
+		}
+	}
+
+	// step() simulates one generation: random pairing, matches, fitness proportional reproduction with mutation
+	void step() {
+		generation += 1;
+		pair_agents();
+		parallel_chunks(config.population / 2, [this](std::size_t begin, std::size_t end) { play_matches(begin, end); });
+		if (config.population % 2) fitness[order.back()] = 1; // unpaired agent is neutral
+		reproduce();
+		genome.swap(next_genome);
+	}
+
+	// share of every genome in current population
+	std::vector<double> shares() {
+		std::vector<std::size_t> counts(num_genomes, 0);
+		for (std::uint8_t g : genome) counts[g] += 1;
+		std::vector<double> result{};
+		for (std::size_t count : counts) result.push_back((double)count / (double)config.population);
+		return result;
+	}
+
+	int get_generation() {
+		return generation;
+	}
+
+	// run() simulates all configured generations; prints genome shares every print_every generations and writes them to csv_path (if given)
+	void run(int print_every = 10, std::string csv_path = "") {
+		std::ofstream ofs{};
+		if (!(csv_path == "")) {
+			ofs.open(csv_path, std::ofstream::out);
+			if (!ofs.is_open()) throw std::runtime_error{ "This file path is invalid, unable to open file." };
+			ofs << "Generation";
+			for (const Genome& g : genomes) ofs << "," << g.name;
+			ofs << "\n";
+			write_shares(ofs);
+		}
+		print_shares();
+		while (generation < config.generations) {
+			step();
+			if (ofs.is_open()) write_shares(ofs);
+			if (print_every and (generation % print_every == 0 or generation == config.generations)) print_shares();
+		}
+	}
+
+	void print_shares() {
+		std::vector<double> s = shares();
+		std::cout << "Generation " << std::setw(5) << generation << ": ";
+		for (int g{}; g < num_genomes; g += 1) {
+			std::cout << genomes[g].name << " " << std::fixed << std::setprecision(3) << s[g] * 100 << "%  ";
+		}
+		std::cout << std::defaultfloat << "\n";
+	}
+
+private:
+	static constexpr std::size_t chunk_size{ 1 << 14 }; // work unit for threads; fixed so results don't depend on thread count
+
+	// parallel_chunks() calls work(begin, end) for fixed size chunks of [0, n), distributed over worker threads
+	template<typename F>
+	void parallel_chunks(std::size_t n, F work) {
+		std::size_t num_chunks = (n + chunk_size - 1) / chunk_size;
+		unsigned num_threads = (unsigned)std::min<std::size_t>(config.threads, std::max<std::size_t>(num_chunks, 1));
+		std::vector<std::thread> workers{};
+		for (unsigned t{}; t < num_threads; t += 1) {
+			workers.emplace_back([=]() {
+				for (std::size_t c{ t }; c < num_chunks; c += num_threads) {
+					Trace_Span span{ "evolution chunk" };
+					work(c * chunk_size, std::min(n, (c + 1) * chunk_size));
+				}
+			});
+		}
+		for (std::thread& worker : workers) worker.join();
+	}
+
+	// random pairing: shuffle agent order (Fisher-Yates); agents order[2k] and order[2k+1] play each other
+	void pair_agents() {
+		for (std::size_t i{}; i < order.size(); i += 1) order[i] = (std::uint32_t)i;
+		std::uint64_t rng = mix_seed(config.seed, generation, 0xFFFFFFFFull);
+		for (std::size_t i{ order.size() - 1 }; i > 0; i -= 1) {
+			std::size_t j = (std::size_t)(splitmix64(rng) % (i + 1));
+			std::swap(order[i], order[j]);
+		}
+	}
+
+	void play_matches(std::size_t begin, std::size_t end) {
+		double scale = config.selection / (double)std::max(config.rounds_per_match, 1ll);
+		for (std::size_t k{ begin }; k < end; k += 1) {
+			std::uint32_t a = order[2 * k], b = order[2 * k + 1];
+			long long balance = play_match(genomes[genome[a]], genomes[genome[b]], config.rounds_per_match, mix_seed(config.seed, generation, k));
+			fitness[a] = (float)std::max(0.0, 1 + scale * balance);
+			fitness[b] = (float)std::max(0.0, 1 - scale * balance);
+		}
+	}
+
+	// fitness proportional reproduction: prefix sums per chunk, chunk offsets, then every offspring samples its parent by binary search
+	void reproduce() {
+		std::size_t n = config.population;
+		std::size_t num_chunks = (n + chunk_size - 1) / chunk_size;
+		std::vector<double> chunk_total(num_chunks, 0);
+		parallel_chunks(n, [this, &chunk_total](std::size_t begin, std::size_t end) {
+			double sum{};
+			for (std::size_t i{ begin }; i < end; i += 1) {
+				sum += fitness[i];
+				cumulative[i] = sum;
+			}
+			chunk_total[begin / chunk_size] = sum;
+		});
+		std::vector<double> chunk_offset(num_chunks, 0);
+		for (std::size_t c{ 1 }; c < num_chunks; c += 1) chunk_offset[c] = chunk_offset[c - 1] + chunk_total[c - 1];
+		double total = chunk_offset.back() + chunk_total.back();
+
+		parallel_chunks(n, [this, &chunk_offset](std::size_t begin, std::size_t end) {
+			for (std::size_t i{ begin }; i < end; i += 1) {
+				cumulative[i] += chunk_offset[begin / chunk_size];
+			}
+		});
+
+		parallel_chunks(n, [this, total, n](std::size_t begin, std::size_t end) {
+			for (std::size_t i{ begin }; i < end; i += 1) {
+				std::uint64_t rng = mix_seed(config.seed, generation, n + i);
+				if (uniform01(rng) < config.mutation_rate or !(total > 0)) {
+					next_genome[i] = (std::uint8_t)(splitmix64(rng) % num_genomes);
+					continue;
+				}
+				double u = uniform01(rng) * total;
+				std::size_t parent = (std::size_t)(std::upper_bound(cumulative.begin(), cumulative.end(), u) - cumulative.begin());
+				next_genome[i] = genome[std::min(parent, n - 1)];
+			}
+		});
+	}
+
+	void write_shares(std::ofstream& ofs) {
+		ofs << generation;
+		for (double s : shares()) ofs << "," << s;
+		ofs << "\n";
+	}
+
+	Evolution_Config config;
+	int generation{};
+
+	// struct of arrays agent storage (index = agent)
+	std::vector<std::uint8_t> genome{}; // index into genomes
+	std::vector<std::uint8_t> next_genome{};
+	std::vector<float> fitness{};
+
+	// per generation scratch arrays
+	std::vector<std::uint32_t> order{};
+	std::vector<double> cumulative{};
+};
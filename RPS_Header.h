@@ -1,773 +1,2290 @@
-#include <iostream>
-#include <vector>
-#include <stdexcept>
-#include <limits>
-#include <time.h>
-#include <random>
-#include <fstream>
-#include <chrono>
-#include <thread>
-
-using namespace std::chrono_literals;
-using vector = std::vector<short>;
-
-// Global shapes array
-const char shapes[3]{ 'R', 'P', 'S' };
-const std::string shape_names[3]{ "Rock", "Paper", "Scissors" };
-
-// empty vector to pass to Player::get_move() if other history or self history is not important
-const vector empty_vec{};
-
-
-// Euclidian modulo for rotation (% operator uses non Euclidian remainder)
-template<typename T, typename F>
-requires std::is_integral<T>::value&& std::is_integral<F>::value
-T mod_euc(T a, F b) {
-	return ((a % b) + b) % b; // This returns modulus with sign of b, so will always be positive if called with positive b
-}
-
-
-//// Move definition
-
-// Move: R (Rock), P (Paper) or S (Scissors)
-struct Move {
-
-	// These attributes are public so they can be accessed and modified outside of Move
-	char shape{}; // represents shape of Move (Rock, Paper, Scissors as single char (R, P, S))
-	short index{}; // represents index of shape in global shapes array
-
-	// Can be initialized with int (shapes_index) or char (shape)
-	Move(short shapes_index) : shape{ shapes[shapes_index] }, index{ shapes_index } {};
-
-	// Also set index to corresponding index in shapes array if initialized with char
-	Move(char shape_char) : shape{ shape_char } {
-		for (short i{}; i < 3; i += 1) {
-			if (shapes[i] == shape_char) index = i;
-		}
-	};
-
-	Move() = default; // enables initialization without braces
-
-	// copy constructor (invoked when passed as function argument)
-	Move(const Move& other) : shape{ other.shape }, index{ other.index } {}
-
-	~Move() = default;
-
-	// Rotate method: Rotates Move shape/index by given value (positive -> clock wise; negative -> counter clock wise); returns lvalue copy
-	Move rotate_by(short by) {
-		// We use C-style casts throughout the code, usually to set an int argument to short
-		return Move{ (short)(mod_euc((index + by), 3)) };
-	}
-};
-
-
-
-//// Player strategies
-
-// Virtual base class for all player strategies
-struct Player {
-
-	// Every player needs a get_move Method
-	virtual Move get_move(const vector& other_history, const vector& self_history) = 0;
-
-	// get player name
-	virtual std::string get_name() = 0;
-
-	// Default destructor
-	virtual ~Player() = default;
-
-
-};
-
-
-
-// Frequency: Play winning move against most frequently played opponent move
-struct Frequency : Player {
-
-	// Every Player derived class at least takes a tag argument which is useful for player identification
-	// (e.g. when 2 players of same type play against each other, we can distinguish them by tag)
-	Frequency(std::string tag = "") {
-		if(not (tag == "")) name = name + " " + tag;
-	}
-
-	Move get_move(const vector& other_history, const vector& unused) override {
-		// Analyse opponent move history and play move that wins against most frequently played opponent move
-
-		if (other_history.empty()) return Move{ (short)0 }; // return default move if history is empty
-
-		// Set up score array to count opponent move frequency
-		int score[3]{ 0, 0, 0 };
-		for (short element : other_history) {
-			score[element] += 1; // add to score each occurence of corresponding element in history
-		}
-
-		// Find index of max element in score (which will be most frequently played opponent move)
-		int max{};
-		short index{};
-		for (int curr_index{}; int element : score) {
-			if (element > max) {
-				max = element;
-				index = curr_index; // index in global shapes array pointing to most frequently played opponent move shape
-			}
-			curr_index += 1;
-		}
-
-		// return most frequently played opponent move rotated by 1 (winning move)
-		return Move{ index }.rotate_by(1);
-	}
-
-	// get_name is used for printing to console
-	std::string get_name() override {
-		return name;
-	}
-
-	// Every Player derived class has a name attribute
-	std::string name = "Frequency Player";
-};
-
-
-
-// Fixed: Always play the same move
-struct Fixed : Player {
-
-	Fixed(char move, std::string tag = "") : fixed_move{ move } {
-		if (not (tag == "")) name = name + "(" + move + ")" + tag;
-		else name = name + " (" + move + ")";
-	};
-
-	Move get_move(const vector& empty1, const vector& empty2) override {
-		// Always return the same move
-		return fixed_move;
-	}
-
-	std::string get_name() override {
-		return name;
-	}
-
-	std::string name = "Fixed Player";
-
-private:
-	Move fixed_move;
-};
-
-
-
-std::mt19937 init_engine; // initialization engine for Random Player; this is necessary because if we initialize two random players
-						  // without a seed argument in quick succession, we get the same seed from time(0) (which only changes every second)
-
-// Random: Always play random move
-struct Random : Player {
-
-	// Can supply seed for rng; otherwise pseudo random seed
-	Random(int s, std::string tag = "") {
-		engine.seed(s);
-		if (not (tag == "")) name = name + " " + tag;
-	};
-	Random(std::string tag = "") {
-		engine.seed(distribution(init_engine)+time(0)); // pseudo random seed from current calendar time in seconds and the contribution from our init engine
-		if (not (tag == "")) name = name + " " + tag;
-
-	};
-
-	// move history not important to Random Player; can pass empty vectors
-	Move get_move(const vector& empty1, const vector& empty2) override {
-		short randn{};
-		randn = mod_euc(distribution(engine), 3); // distribution returns uniformly distributed shorts; Euclidian modulo with 3 returns our final pseudo-random init value between 0 and 2
-		return Move{ randn };
-	}
-
-	std::string get_name() override {
-		return name;
-	}
-
-	std::string name = "Random Player";
-
-private:
-	// use mersenne twister random engine (Matsumoto and Nishimura); distribution returns short based on engine input
-	std::mt19937 engine;
-	std::uniform_int_distribution<int> distribution;
-
-};
-
-
-
-// Rotation: Play opponent move rotated by x
-struct Rotation : Player {
-
-	Rotation(short by = 0, std::string tag = "") : rotation_by{ by } {
-		if (not (tag == "")) name = name + " " + tag;
-	};
-
-	Move get_move(const vector& other_history, const vector& self_history) override {
-		if (other_history.empty()) return Move{ (short)0 };
-
-		// get last element of opponent move history vector (last opponent move)
-		short last = other_history.back();
-
-		// rotate last opponent move by rotation_by and return
-		return Move{ last }.rotate_by(rotation_by);
-	}
-
-	std::string get_name() override {
-		return name;
-	}
-
-	std::string name = "Rotation Player";
-
-private:
-	short rotation_by{};
-};
-
-
-
-// Anti_Rotation: Figure out opponent rotation and play winning move against it
-struct Anti_Rotation : Player {
-
-	// Verbose argument is used whenever a Player derived class has an internal state than may be interesting; in this case, the internal state
-	// is the opponent rotation Anti_Rotation has figured out; if true, will print internal state to console 
-	Anti_Rotation(bool verbose = false, std::string tag = "") : verbose{verbose} {
-		if (not (tag == "")) name = name + " " + tag;
-	}
-
-	Move get_move(const vector& other_history, const vector& self_history) {
-		// Assume opponent uses a rotation strategy; look at history and figure out by how much;
-		// play winning strategy (which is expected opponent move rotated by 1)
-
-		if (self_history.size() < 2) { // Anti_Rotation needs exactly two entries in opponent and self history in order to figure out opponent Rotation; 
-			return Move{ (short)0 };   // so return default Move if self_history size (which is always equal to other history size) is less than 2
-		}
-
-		short last_self = self_history[self_history.size() - 2]; // second to last self move
-		short other_response = other_history.back(); // last opponent move (opponent response to second to last self move)
-		short index_diff = other_response - last_self; // index difference between second to last self move and opponent response
-		short rotate = mod_euc(index_diff, 3); // Euclidian modulo of index difference and 3 is opponent rotation
-
-		// print internal state to console if verbose is true
-		if (verbose) {
-			std::cout << "\nrotation used by other: " << rotate;
-			std::cout << "\npredicted other move: " << shapes[mod_euc(self_history.back() + rotate, 3)] << "\n";
-		}
-
-		return Move{ self_history.back() }.rotate_by(rotate + 1); // If opponent rotation is known, all we need to do in order to win is rotate last self move by that rotation + 1
-	}
-
-
-	std::string get_name() override {
-		return name;
-	}
-
-	std::string name = "Anti Rotation Player";
-	bool verbose{};
-};
-
-
-
-// Human: Player that prompts for human input for move decision
-struct Human : Player {
-
-	Human(std::string tag = "") {
-		if (not (tag == "")) name = name + " " + tag;
-	}
-
-	// Move history is not important to human player; if played on console, move history will be accessible by Game::evaluate_round()
-	Move get_move(const vector& empty1, const vector& empty2) override {
-
-		// shape variable stores user input
-		short shape{};
-
-		while (true) {
-			try {
-				std::cout << name << ", Input Move shape (0 (Rock), 1 (Paper), 2 (Scissors)): ";
-				std::cin >> shape;
-
-				// throw errors if unser input is out of range or invalid type (cin will be in bad state and cin=0)
-				if (shape > 2 or shape < 0) throw std::range_error{ "Move shape must be 0 (Rock), 1 (Paper) or 2 (Scissors)." };
-				if (!std::cin) throw std::runtime_error{ "Invalid input." };
-				break;
-			}
-			catch (std::range_error& e) {
-				// if invalid input: clear last bit in stream buffer and ignore rest of stream buffer until '\n'
-				std::cout << "Error: " << e.what() << std::endl;
-				std::cin.clear();
-				std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-				continue;
-			}
-			catch (std::runtime_error& e) {
-				std::cout << "Error: " << e.what() << std::endl;
-				std::cin.clear();
-				std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-				continue;
-			}
-
-		}
-
-		return Move{ shape };
-
-	}
-
-	std::string get_name() override {
-		return name;
-	}
-
-	std::string name = "Pathetic Human Player";
-};
-
-
-//// Meta Players: Can access and play with all previously defined Player strategies 
-
-// evaluate_round() will return index distance between given Moves, which is =0 if Moves are equal, =1 if m1 wins against m2 and =2 if m2 wins against m1
-// evaluate round is not a member of any class, because it needs to be called by Meta Players (in order to evaluate strategy performance) and by Game (in order to evaluate current round)
-short evaluate_round(const Move m1, const Move m2) {
-	// this uses the same principle Anti_Rotation uses in order to figure out opponent rotation, but is applied to current Moves
-	short index_diff{};
-	index_diff = m1.index - m2.index;
-	short index_distance = mod_euc(index_diff, 3);
-	return index_distance;
-}
-
-
-// Scoring functions: Used by Meta Player in order to modify internal scores representing different strategies based on previous strategy performance
-// Every scoring function applies different operations on given score (e.g. ..._add() adds/subtracts a constant value from score depending on win/loss of respective strategy)
-
-// naive_score_mul() multiplies score by given constants in scoring_vector
-// score vector : {draw multiplier, win multiplier, loss multiplier, floor, ceiling, decay constant}
-void naive_score_mul(double& score, short index_distance, double score_vector[6]) {
-
-	// scoring_vector is a caller supplied array which contains the constants used by the respective scoring function to modify scores
-	// index distance determines whether strategy loses, wins or results in a draw; is supplied by evaluate_round() called by Meta_Player::get_move()
-	switch (index_distance) {
-	case 0: // draw
-		score *= score_vector[0];
-		break;
-	case 1: // win
-		score *= score_vector[1];
-		break;
-	case 2: // loss
-		score *= score_vector[2];
-		break;
-	}
-	if (score < score_vector[3]) score = score_vector[3]; // score_vector[3] is floor: if score is less than floor after scoring function operation, set score equal to floor
-														// --> scores will never be smaller than floor; prevents scores from diminishing without bound
-	if (score > score_vector[4]) score = score_vector[4]; // score_vector[4] is ceiling: if score is larger than ceiling after scoring function operation, set score equal to ceiling
-														// --> scores will never be larger than ceiling; prevents boundless growth
-	if (!(score_vector[5] == 1)) score *= score_vector[5]; // score_vector[5] is decay constant: multiply score by decay constant
-														// --> every score will continually diminish (decay < 1) or grow (decay > 1) regardless of outcome
-}
-
-// naive_score_add() adds to score given constants in scoring_vector
-// score vector : {draw constant, win constant, loss constant, floor, ceiling, decay constant}
-void naive_score_add(double& score, short index_distance, double score_vector[6]) {
-	switch (index_distance) {
-	case 0: // draw
-		score += score_vector[0];
-		break;
-	case 1:// win
-		score += score_vector[1];
-		break;
-	case 2: // loss
-		score += score_vector[2];
-		break;
-	}
-	if (score < score_vector[3]) score = score_vector[3];
-	if (score > score_vector[4]) score = score_vector[4];
-	if (!(score_vector[5] == 1)) score *= score_vector[5];
-}
-
-// drop_switch_mul() multilies score by constants in scoring_vector in case of win or draw, but sets score back to scoring_vector[2] in case of loss
-// score vector : {draw multiplier, win multiplier, loss value, floor, ceiling, decay constant}
-void drop_switch_mul(double& score, short index_distance, double score_vector[6]) {
-	switch (index_distance) {
-	case 0: // draw
-		score *= score_vector[0];
-		break;
-	case 1: // win
-		score *= score_vector[1];
-		break;
-	case 2: // loss
-		score = score_vector[2]; // set score back to value (-> drop)
-		break;
-	}
-	if (score < score_vector[3]) score = score_vector[3];
-	if (score > score_vector[4]) score = score_vector[4];
-	if (!(score_vector[5] == 1)) score *= score_vector[5];
-}
-
-// drop_switch_add() adds to score constants in scoring_vector in case of win or draw, buts sets score back to scoring_vector[3] in case of loss
-// score vector : {draw constant, win constant, loss value, floor, ceiling, decay constant}
-void drop_switch_add(double& score, short index_distance, double score_vector[6]) {
-	switch (index_distance) {
-	case 0: // draw
-		score += score_vector[0];
-		break;
-	case 1: // win
-		score += score_vector[1];
-		break;
-	case 2: // loss
-		score = score_vector[2]; // set score back to value (-> drop)
-		break;
-	}
-	if (score < score_vector[3]) score = score_vector[3];
-	if (score > score_vector[4]) score = score_vector[4];
-	if (!(score_vector[5] == 1)) score *= score_vector[5];
-}
-
-
-// Type alias for scoring function pointer used to initialize Meta Player
-using scoring_func_ptr = void (*)(double& score, short index_distance, double score_vector[6]);
-
-
-// Meta_Player_Naive has access to all strategies defined above (except Human Player of course) and plays strategy with highest score; keeps internal array of scores
-// and modifies these according to previous strategy performance
-struct Meta_Player_Naive : Player {
-
-	// Meta Player is initialized with a scoring function pointer and a scoring vector used by the pointed to scoring function
-	Meta_Player_Naive(bool verbose = false, std::string tag = "", scoring_func_ptr scoring_func = naive_score_mul, double scoring_vector[] = {}) : \
-		verbose{ verbose }, scoring_func{ scoring_func }, scoring_vector{ scoring_vector } {
-		if (not (tag == "")) name = name + " " + tag;
-	}
-
-
-	Move get_move(const vector& other_history, const vector& self_history) override {
-		if (other_history.size() < 1) return Move{ (short)0 };
-
-		// i is rotation applied to every strategy
-		for (int i{}; i < 3; i += 1) {
-			// j is index of respective strategy in strategies vector; i and j are used to access the respective score in scores array
-			for (int j{}; Player * strat_ptr : strategies) { // loop through every player pointer in strategies array
-
-				// next Move within each iteration is player strategy (Player.get_move(history)) rotated by i (0, 1 or 2)
-				// we pass to Player::get_move() the entire move history (notice self_history is first argument -> puts itself in shoes of opponent)
-				// except for the last Move pair (vector slice from beginning to end-1); will return Move that would be played against self last Move in current round
-				Move next = strat_ptr->get_move(vector(self_history.begin(), self_history.end() - 1), vector(other_history.begin(), other_history.end() - 1)).rotate_by(i);
-
-				// evaluate whether this Move rotated by 1 would win against current opponent last Move
-				short index_dist = evaluate_round(next, Move{ other_history[other_history.size() - 1] });
-
-				// call scoring function based on index distance (0=draw, 1=win, 2=loss)
-				scoring_func(scores[i][j], index_dist, scoring_vector);
-
-				j += 1; // increment j after scores access; would lead to out of bounds access if incremented any sooner
-			}
-		}
-
-		// After every possible strategy has been evaluated, find the best perfroming strategy (corresponds to largest value in scores array)
-		max_index_i = 0; max_index_j = 0;
-		double max{};
-		for (int curr_index_i{}; std::vector<double> element : scores) {
-			for (int curr_index_j{};  double score : element) {
-				if (score > max) {
-					max = score;
-					max_index_i = curr_index_i;
-					max_index_j = curr_index_j;
-				}
-				curr_index_j += 1;
-			}
-			curr_index_i += 1;
-		}
-
-		if (verbose) get_current_state();
-		
-		if (max < 1) return teller_rand.get_move(other_history, self_history); // return random Move if no strategy perfroms reasonably well
-																			   // --> failsafe: win rate will never drop far below 50% on average if random moves are played
-
-		// return move played by best performing strategy (strategy is always basic strategy (rotation, frequency, ...) and a rotation between 0 and 2)
-		return strategies[max_index_j]->get_move(self_history, other_history).rotate_by(max_index_i);
-	}
-
-	// print internal state (scores, current best performing strategy) to cosnole
-	void get_current_state() {
-		std::cout << "\n\n\n----------------\nMeta Player " << name << " current scores:\n\n";
-		std::cout << "[{freq, anti_rot, rot, fix}Rot0, {...}Rot1, {...}Rot2}]\n";
-		for (std::vector<double> element : scores) {
-			for (double score : element) {
-				std::cout << score << " ";
-			}
-			std::cout << "  ";
-		}
-		std::cout << "\n\nCurrent Strategy: " << strategies[max_index_j]->get_name() << " Rotated by " << max_index_i << \
-					"\n----------------\n\n\n";
-	}
-
-	// reset scores (in case of multiple Games)
-	void reset_scores() {
-		scores = { {1, 1, 1, 1}, {1, 1, 1, 1}, {1, 1, 1, 1} };
-	}
-
-	std::string get_name() override {
-		return name;
-	}
-
-private:
-	// Initalize "Oracle Players" Meta Player consults whenever a move decision has to be made; can be thought of as Meta Player's repertoire of strategies
-	Frequency teller_freq{};
-	Anti_Rotation teller_anti_rot{};
-	Rotation teller_rot{ 0 };
-	Random teller_rand{};
-	Fixed teller_fix{ 'R' };
-
-	// Putting the oracle Players (except Random which is called whenever scores fall below a certain threshold) into a Player pointer vector "strategies"
-	std::vector<Player*> strategies{ &teller_freq, &teller_anti_rot, &teller_rot, &teller_fix};
-
-	// 2d score array: corresponds to scores of all 4 main stratgies {Frequency, Anti_Rotation, Rotation, Fixed} rotated by 0 (first element in scores), by 1 (second element) or by 2 (third element)
-	std::vector<std::vector<double>> scores{ {1, 1, 1, 1}, {1, 1, 1, 1}, {1, 1, 1, 1} };
-
-	// scoring function pointer pointing to scoring function used for strategy performance evaluation
-	scoring_func_ptr scoring_func;
-
-	// scoring vector pointer passed to scoring function pointed to by scoring_func
-	double* scoring_vector = new double[3];
-
-	// these keep track of best performing strategy: used to index access highest score in scores 2d array
-	int max_index_i{}, max_index_j{};
-
-	bool verbose = false;
-	std::string name = "Naive Meta Player";
-};
-
-
-// Meta_Player_Rand_Strat plays one of four basic strategies rotated by 0, 1 or 2 for a number of rounds; this will be used to test Meta_Player_Naive performance against switching strategies
-struct Meta_Player_Rand_Strat : Player {
-	Meta_Player_Rand_Strat(bool verbose = false, std::string tag = "", int init_rounds=20, int init_strat=0, int init_rot = 0) : \
-		verbose{ verbose } {
-		if (not (tag == "")) name = name + " " + tag;
-	}
-
-	Move get_move(const vector& other_history, const vector& self_history) {
-		if (!curr_rounds) { // if curr_rounds reaches 0, generate a new strategy, rotation and rounds
-			curr_rounds = mod_euc(distribution(engine), 21); // will play random strategy for number of rounds between 0 and 20
-			curr_strat = mod_euc(distribution(engine), 4); // random basic strategy
-			curr_rot = mod_euc(distribution(engine), 3); // random rotation between 0 and 2
-		}
-		else if (curr_rounds) curr_rounds -= 1; // after every get_move() call, decrement curr_rounds by 1
-
-		return strategies[curr_strat]->get_move(other_history, self_history).rotate_by(curr_rot); // return current basic strategy rotated by current rotation
-	}
-
-	// print internal state (current basic strategy, current rotation) to console
-	void get_current_state() {
-		std::cout << "\n\n\n----------------\nMeta Player " << name << " current strategy:\n\n";
-		std::cout << "\n\nCurrent Strategy: " << strategies[curr_strat]->get_name() << "Rotated by " << curr_rot << \
-			"\n----------------\n\n\n";
-	}
-
-	std::string get_name() override {
-		return name;
-	}
-
-private:
-	// Random engine & distribution to randomly generate a strategy, rotation and number of rounds
-	std::mt19937 engine;
-	std::uniform_int_distribution<int> distribution;
-
-	// same strategy repertoire as Meta_Player_Naive
-	Frequency teller_freq{};
-	Anti_Rotation teller_anti_rot{};
-	Rotation teller_rot{ 0 };
-	Random teller_rand{};
-	Fixed teller_fix{ 'R' };
-	std::vector<Player*> strategies{ &teller_freq, &teller_anti_rot, &teller_rot, &teller_fix };
-
-	// curr_rounds is number of rounds the current basic strategy will be played for
-	int curr_rounds{};
-
-	// curr_strat is index of current basic strategy in strategies vector
-	int curr_strat{};
-
-	// curr_rot is rotation applied to current basic strategy
-	int curr_rot{};
-
-	bool verbose{};
-	std::string name{ "Random Strategy Meta Player" };
-};
-
-
-//// Game definition
-
-struct Game {
-
-	// Initialize a Game with Players (always 2) and number of rounds to be played
-	Game(Player& p1, Player& p2, int num_rounds, int sleep = 0) : p1{ p1 }, p2{ p2 }, num_rounds{ num_rounds }, sleep{ sleep } {};
-
-	~Game() {
-		delete[] game_history;
-	}
-
-	// Game::play() calls Players::get_move(), pushes back returned moves to respective move history array, and calls game::evaluate_game_round() for given number of rounds;
-	// calls Game::evaluate_game() after all rounds have been played
-	void play(bool verbose = true, bool is_1_v_1 = false) {
-		win_history = {}; // set win_history to empty array (in case Game::play() is called multiple times; we only care for current win_history, not for previous Games)
-		for (int i{}; i < num_rounds; i += 1) {
-
-			Move next_move_p1 = p1.get_move(move_history_p2, move_history_p1);
-			Move next_move_p2 = p2.get_move(move_history_p1, move_history_p2);
-
-			move_history_p1.push_back(next_move_p1.index);
-			move_history_p2.push_back(next_move_p2.index);
-
-			std::cout << "\n----------------\n\nRound " << i + 1 << ": \n\n";
-			if (verbose) print_last_move(); // if verbose = true; prints result of current round to console
-			evaluate_game_round(next_move_p1, next_move_p2, verbose);
-			std::cout << "\n----------------\n";
-			if (sleep) {
-				std::this_thread::sleep_for(sleep_ms);
-			}
-
-		}
-		evaluate_game(verbose);
-	}
-
-	// print result of current round to console
-	void print_last_move() {
-		std::cout << "Player 1 (" << p1.get_name() << ") played " << shape_names[move_history_p1.back()] << "\n";
-		std::cout << "Player 2 (" << p2.get_name() << ") played " << shape_names[move_history_p2.back()] << "\n\n";
-	}
-
-	// Game::evaluate_game_round() determines which Player wins current round and saves result in win_history array
-	short evaluate_game_round(const Move m1, const Move m2, bool verbose = false) {
-
-		short index_distance = evaluate_round(m1, m2); // get index distance with respect to m1
-
-		switch (index_distance) {
-		case 0: // draw
-			win_history.push_back(0);
-			if (verbose) {
-				std::cout << "Draw!\n\n" << std::endl;
-			}
-			break;
-		case 1: // p1 win
-			win_history.push_back(1);
-			if (verbose) {
-				std::cout << p1.get_name() << " wins this round!\n\n" << std::endl;
-			}
-			break;
-		case 2: // p2 win
-			win_history.push_back(2);
-			if (verbose) {
-				std::cout << p2.get_name() << " wins this round!\n\n" << std::endl;
-			}
-			break;
-		}
-		return 0;
-	}
-
-	// After all rounds have been played, Game::evaluate_game() will determine the winner based on number of won rounds of each player in win_history array
-	void evaluate_game(bool verbose = false) {
-		// score{draws, p1_wins, p2_wins}
-
-		int score[]{ 0, 0, 0 }; // score{draws, wins p1, wins p2}
-
-		for (short element : win_history) { // add up wins of each player; draws are on win_history[0]
-			score[element] += 1;
-		}
-		if (score[1] > score[2]) { // p1 wins game
-			game_history[1] += 1;
-			if (verbose) {
-				std::cout << "\n\n" << p1.get_name() << " wins this game.\n";
-			}
-		}
-		else if (score[1] < score[2]) { // p2 wins game
-			game_history[2] += 1;
-			if (verbose) {
-				std::cout << "\n\n" << p2.get_name() << " wins this game.\n";
-			}
-		}
-		else {
-			game_history[0] += 1;
-			if (verbose) { // draw
-				std::cout << "\n\nThis game resulted in a draw!\n";
-			}
-		}
-
-		// Calculate and put out game stats: wl is win-loss ratio; wr is win rate
-		double wl1{}, wl2{}, wr1{}, wr2{};
-		constexpr double inf = std::numeric_limits<double>::infinity();
-
-		if (score[2] == 0) wl1 = inf;
-		else wl1 = (double)score[1] / (double)score[2];
-
-		if (score[1] == 0) wl2 = inf;
-		else wl2 = (double)score[2] / (double)score[1];
-
-		if (num_rounds == 0) wr1 = 0;
-		else wr1 = (double)score[1] / (double)num_rounds;
-
-		if (num_rounds == 0) wr2 = 0;
-		else wr2 = (double)score[2] / (double)num_rounds;
-
-		std::cout << "\n\n----------------\n\nGame Stats\n\n\n";
-		std::cout << "Player 1 (" << p1.get_name() << ") wins " << score[1] << "/" << num_rounds << " games\n";
-		std::cout << "Player 2 (" << p2.get_name() << ") wins " << score[2] << "/" << num_rounds << " games\n\n";
-		std::cout << "Win-Loss Ratio " << p1.get_name() << " : " << wl1 << "\n";
-		std::cout << "Win-Loss Ratio " << p2.get_name() << " : " << wl2 << "\n\n";
-		std::cout << "Win Rate " << p1.get_name() << " : " << wr1*100 << "%" << "\n";
-		std::cout << "Win Rate " << p2.get_name() << " : " << wr2*100 << "%" << "\n\n";
-		std::cout << "With " << score[0] << " Draws" << "\n\n----------------" << std::endl;
-	}
-
-	// Save current game state to .csv-file for Analysis 
-	bool save(std::string path, std::string id_tag = "") {
-		try {
-			path = path +  "\\" + id_tag + ".csv";
-			std::ofstream ofs(path, std::ofstream::out);
-			if (!ofs.is_open()) throw std::runtime_error{ "This file path is invalid, unable to open file." };
-
-			ofs << "Move History P1,Move History P2,Win History,Game History" << "\n"; // Header
-			for (int i{}; i < num_rounds+2; i += 1) {
-				if (i < num_rounds) {
-					ofs << move_history_p1[i] << "," << move_history_p2[i] << "," << win_history[i];
-				} 
-
-				// game_history has only 3 entries
-				if (i < 3) {
-					if (num_rounds <= i) ofs << ",,";
-					ofs << "," << game_history[i];
-				}
-				ofs << "\n";
-			}
-			ofs.close();
-		}
-
-		catch (std::exception& e) {
-			std::cout << "Error saving game data: " << e.what() << std::endl;
-			return false;
-		}
-		return true;
-	}
-
-	// reset internal state
-	void reset() {
-		move_history_p1 = {};
-		move_history_p2 = {};
-		win_history = {};
-		game_history[0] = 0;
-		game_history[1] = 0;
-		game_history[2] = 0;
-	}
-
-	// setter method to change number of game rounds with same Players
-	void set_rounds(int rounds) {
-		num_rounds = rounds;
-	}
-
-private:
-	// game_history is only important when playing multiple games (calling Game::play() repeatedly): score{draws, player1 wins, player2 wins}
-	int *game_history = new int[3]{ 0, 0, 0 };
-
-	// Game Players (can be any Player derived class); Player base class serves as common interface
-	Player& p1;
-	Player& p2;
-
-	// number of game rounds
-	int num_rounds;
-
-	// move histories for both players
-	vector move_history_p1{};
-	vector move_history_p2{};
-
-	// win history: 0:draw  1:p1 win  2:p2 win
-	vector win_history{};
-
-	// sleep duration between rounds in ms
-	int sleep{};
-	std::chrono::milliseconds sleep_ms{ sleep };
-};
\ No newline at end of file
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <limits>
+#include <time.h>
+#include <random>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <memory>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <cstdint>
+#include <type_traits>
+#include <sstream>
+#include <filesystem>
+#include <cmath>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+#if defined(__x86_64__) or defined(_M_X64) or defined(__i386__)
+#include <immintrin.h>
+#endif
+
+using namespace std::chrono_literals;
+using vector = std::vector<short>;
+
+// Global shapes array
+constexpr char shapes[3]{ 'R', 'P', 'S' };
+const std::string shape_names[3]{ "Rock", "Paper", "Scissors" };
+
+// empty vector to pass to Player::get_move() if other history or self history is not important
+const vector empty_vec{};
+
+// Engine version: part of every result cache key (see RPS_Cache.h); increment whenever a change alters game results
+const int engine_version{ 1 };
+
+
+// Euclidian modulo for rotation (% operator uses non Euclidian remainder)
+template<typename T, typename F>
+requires std::is_integral<T>::value&& std::is_integral<F>::value
+constexpr T mod_euc(T a, F b) {
+	return ((a % b) + b) % b; // This returns modulus with sign of b, so will always be positive if called with positive b
+}
+
+
+//// Shapes of cyclic games
+
+// The engine is templated on the number of shapes K of a cyclic game: with an odd number K of shapes every shape beats the (K - 1) / 2
+// shapes before it and loses against the (K - 1) / 2 shapes after it (index distance mod K), so rotations, "winning move" (rotate by 1)
+// and the basic strategies generalize directly. Rock-Paper-Scissors is K = 3: Move, Player, the strategies and Game below are the K = 3
+// instantiations of Cyclic_Move, Cyclic_Player, ... and Cyclic_Game (see RPS_Cyclic.h for Rock-Paper-Scissors-Lizard-Spock and larger K)
+
+// Cyclic_Rules<K>: lookup tables for the per round core (replace mod_euc's two divisions by one table load), generated at compile time
+// outcome[i][j]: 0 draw, 1 i wins, 2 j wins (see evaluate_round()), difference[i][j] = mod_euc(i - j, K): index distance of Move i to Move j
+// (same as outcome for K = 3), rotation[i][by] = mod_euc(i + by, K): Move i rotated by 0 to K - 1 (see Cyclic_Move::rotate_by())
+template<int K>
+struct Cyclic_Rules {
+	static_assert(K >= 3 and K % 2 == 1 and K < 256, "Cyclic games need an odd number of shapes (3 to 255)");
+
+	using Table = std::array<std::array<std::uint8_t, K>, K>;
+
+	static constexpr Table make_table(int kind) {
+		Table table{};
+		for (int i{}; i < K; i += 1) {
+			for (int j{}; j < K; j += 1) {
+				int difference = mod_euc(i - j, K);
+				if (kind == 0) table[i][j] = (std::uint8_t)difference;
+				else if (kind == 1) table[i][j] = (std::uint8_t)(difference == 0 ? 0 : (difference <= (K - 1) / 2 ? 1 : 2));
+				else table[i][j] = (std::uint8_t)mod_euc(i + j, K);
+			}
+		}
+		return table;
+	}
+
+	static constexpr Table difference{ make_table(0) };
+	static constexpr Table outcome{ make_table(1) };
+	static constexpr Table rotation{ make_table(2) };
+
+	// shape() returns the shape character of index: R, P, S for K = 3, R, K (Spock), P, L, S for K = 5 (each shape beats the two before it),
+	// letters from A on for other K
+	static constexpr char shape(int index) {
+		if constexpr (K == 3) return shapes[index];
+		else if constexpr (K == 5) return "RKPLS"[index];
+		else return (char)(index < 26 ? 'A' + index : '?');
+	}
+
+	static std::string shape_name(int index) {
+		if constexpr (K == 3) return shape_names[index];
+		else if constexpr (K == 5) return std::array<std::string, 5>{ "Rock", "Spock", "Paper", "Lizard", "Scissors" } [index] ;
+		else return std::string{ "Shape " } + shape(index);
+	}
+
+	// index() returns index of shape character (-1 if it isn't one)
+	static constexpr int index(char shape_char) {
+		for (int i{}; i < K; i += 1) if (shape(i) == shape_char) return i;
+		return -1;
+	}
+};
+
+// outcome_table and rotation_table: tables of Rock-Paper-Scissors (used directly by the batched strategies and tools that only play K = 3)
+constexpr const auto& outcome_table = Cyclic_Rules<3>::outcome;
+constexpr const auto& rotation_table = Cyclic_Rules<3>::rotation;
+
+static_assert(outcome_table[1][0] == 1 and outcome_table[0][1] == 2 and Cyclic_Rules<3>::difference == outcome_table, "K = 3 has to be Rock-Paper-Scissors");
+
+
+//// Move definition
+
+// Cyclic_Move<K>: a shape of a K shape game; Move (K = 3): R (Rock), P (Paper) or S (Scissors)
+// Move only stores its index (one byte, trivially copyable), so Moves are passed and stored like plain integers; shape() is a table lookup
+template<int K>
+struct Cyclic_Move {
+
+	// Public so it can be accessed and modified outside of Move
+	std::uint8_t index{}; // represents index of shape (see Cyclic_Rules::shape())
+
+	// Can be initialized with int (shapes_index) or char (shape)
+	constexpr Cyclic_Move(short shapes_index) noexcept : index{ (std::uint8_t)shapes_index } {}
+
+	// Also set index to corresponding shape index if initialized with char (other chars are the first shape, Rock)
+	constexpr Cyclic_Move(char shape_char) noexcept : index{ (std::uint8_t)std::max(Cyclic_Rules<K>::index(shape_char), 0) } {}
+
+	Cyclic_Move() = default; // enables initialization without braces
+
+	// represents shape of Move (Rock, Paper, Scissors as single char (R, P, S))
+	constexpr char shape() const noexcept {
+		return Cyclic_Rules<K>::shape(index);
+	}
+
+	// Rotate method: Rotates Move shape/index by given value (positive -> towards the shapes that beat this one, rotate_by(1) is a
+	// winning move; negative -> the other way); returns lvalue copy
+	constexpr Cyclic_Move rotate_by(short by) const noexcept {
+		if (by < 0 or by >= K) by = mod_euc(by, K); // rotations outside 0 to K - 1 are rare (e.g. Rotation Player set up with -1)
+		return Cyclic_Move{ (short)Cyclic_Rules<K>::rotation[index][by] };
+	}
+};
+
+using Move = Cyclic_Move<3>;
+
+static_assert(sizeof(Move) == 1 and std::is_trivially_copyable_v<Move>, "Move has to stay a one byte trivially copyable value");
+
+
+
+//// Player strategies
+
+// Markov_Choice: one move a Player can make in a state of its Markov description (see Player::markov_choices())
+struct Markov_Choice {
+	double probability{};
+	short move{};
+	std::uint64_t after{}; // state after making this choice (before the round is observed)
+};
+
+// History_Requirement: part of the move histories a Player's moves depend on (see Player::history_requirement());
+// recent: number of most recent moves of both histories, counts: how often every move occurs in both histories, full: whole histories
+struct History_Requirement {
+	std::size_t recent{};
+	bool counts{};
+	bool full{ true };
+};
+
+// History_Summary: full histories condensed to what Game still knows if it only keeps the most recent moves (see Player::get_move_bounded())
+template<int K>
+struct Cyclic_History_Summary {
+	std::uint64_t rounds{}; // length of the full histories (last recent move is move rounds - 1)
+	std::uint64_t other_counts[K]{};
+	std::uint64_t self_counts[K]{};
+};
+
+using History_Summary = Cyclic_History_Summary<3>;
+
+// Virtual base class for all player strategies of a K shape game (Player: K = 3)
+template<int K>
+struct Cyclic_Player {
+
+	// Move and History_Summary of this game
+	using Move = Cyclic_Move<K>;
+	using History_Summary = Cyclic_History_Summary<K>;
+
+	// Every player needs a get_move Method
+	virtual Move get_move(const vector& other_history, const vector& self_history) = 0;
+
+	// history_requirement() declares which part of the histories get_move() depends on; if neither Player needs full histories (and Game
+	// doesn't have to keep them, see Game::set_keep_histories()) Game only keeps what both Players need, so memory doesn't grow with the rounds
+	virtual History_Requirement history_requirement() {
+		return History_Requirement{};
+	}
+
+	// get_move_bounded() is called instead of get_move() if Game only keeps bounded histories: histories hold at least the most recent
+	// moves declared by history_requirement() (all moves in the first rounds); Players that need move counts have to override it.
+	// Meta Player asks its oracles this way as well (with whole histories and their counts)
+	virtual Move get_move_bounded(const vector& other_recent, const vector& self_recent, const History_Summary& summary) {
+		return get_move(other_recent, self_recent);
+	}
+
+	// get_move_until() is called instead of get_move() if Game gives every move a time budget (see Game::set_move_budget()): anytime
+	// strategies refine their move until deadline and then return the best move so far; all others just answer (if they overrun the
+	// deadline anyway, Game plays a fallback move instead)
+	virtual Move get_move_until(const vector& other_history, const vector& self_history, std::chrono::steady_clock::time_point deadline) {
+		return get_move(other_history, self_history);
+	}
+
+	// get_move_bounded_until() is get_move_until() for bounded histories (see get_move_bounded()), i.e. called if Game gives every move a
+	// time budget and only keeps bounded histories
+	virtual Move get_move_bounded_until(const vector& other_recent, const vector& self_recent, const History_Summary& summary, std::chrono::steady_clock::time_point deadline) {
+		return get_move_bounded(other_recent, self_recent, summary);
+	}
+
+	// get player name
+	virtual std::string get_name() = 0;
+
+	// interactive() returns true for Players that wait for a person (Human); Game doesn't hold them to a move budget
+	virtual bool interactive() {
+		return false;
+	}
+
+	// reset internal state (in case of multiple Games); players without internal state don't need to override this
+	virtual void reset() {}
+
+	// get_fingerprint() writes a fingerprint of everything that determines the Player's future moves (given the opponent's future moves)
+	// and returns true; the fingerprint has to be unique for every reachable state (no hashing). Players without a finite deterministic
+	// state (Random, Human, ...) return false. Used by Game to detect cycles in deterministic matchups (see Game::play()); summary holds
+	// the move counts of the histories, which Game keeps anyway, so Players that depend on them don't recount the histories every round
+	virtual bool get_fingerprint(const vector& other_history, const vector& self_history, const History_Summary& summary, std::uint64_t& fingerprint) {
+		return false;
+	}
+
+	// confirm_period() is called by Game before fast-forwarding over a detected cycle of given period (last period moves in histories);
+	// Players that saturate internal state in their fingerprint (e.g. Frequency) have to check that repeating the period can't change their behaviour
+	virtual bool confirm_period(const vector& other_history, const vector& self_history, const History_Summary& summary, std::size_t period) {
+		return true;
+	}
+
+	// get_config() writes a canonical description of the Player's type and parameters (everything that determines its moves in a new game)
+	// and returns true; Players whose moves aren't reproducible (unseeded Random, Human, ...) return false. Used as result cache key
+	virtual bool get_config(std::string& config) {
+		return false;
+	}
+
+	// Markov description, used to compute expected results exactly instead of simulating (see RPS_Markov.h): the Player is a chain over
+	// Player-defined 64-bit states. markov_initial() writes the state before the first round and returns true; Players without such a
+	// description (Human, Meta_Player_Naive, ...) return false. markov_choices() lists every move the Player can make in state (with its
+	// probability and the state after the choice); markov_observe() returns the state for the next round after the round (self_move, other_move)
+	virtual bool markov_initial(std::uint64_t& state) {
+		return false;
+	}
+
+	virtual void markov_choices(std::uint64_t state, std::vector<Markov_Choice>& choices) {}
+
+	virtual std::uint64_t markov_observe(std::uint64_t after, short self_move, short other_move) {
+		return after;
+	}
+
+	// markov_random() returns true if the Player draws among several choices in some states; markov_counts_moves() returns true if its
+	// state keeps count differences of the opponent's moves, which wander without bound when those moves vary at random (Markov_Analyzer
+	// refuses such matchups); markov_exact() returns false for states that lump together histories the Player tells apart (results
+	// through them are approximate)
+	virtual bool markov_random() {
+		return false;
+	}
+
+	virtual bool markov_counts_moves() {
+		return false;
+	}
+
+	virtual bool markov_exact(std::uint64_t state) {
+		return true;
+	}
+
+	// Default destructor
+	virtual ~Cyclic_Player() = default;
+
+
+};
+
+using Player = Cyclic_Player<3>;
+
+
+
+// Frequency: Play winning move against most frequently played opponent move
+template<int K>
+struct Cyclic_Frequency : Cyclic_Player<K> {
+
+	using Move = Cyclic_Move<K>;
+	using History_Summary = Cyclic_History_Summary<K>;
+
+	// Every Player derived class at least takes a tag argument which is useful for player identification
+	// (e.g. when 2 players of same type play against each other, we can distinguish them by tag)
+	Cyclic_Frequency(std::string tag = "") {
+		if(not (tag == "")) name = name + " " + tag;
+	}
+
+	Move get_move(const vector& other_history, const vector& unused) override {
+		// Analyse opponent move history and play move that wins against most frequently played opponent move
+
+		if (other_history.empty()) return Move{ (short)0 }; // return default move if history is empty
+
+		// Set up score array to count opponent move frequency
+		std::uint64_t score[K]{};
+		for (short element : other_history) {
+			score[element] += 1; // add to score each occurence of corresponding element in history
+		}
+		return beat_most_frequent(score);
+	}
+
+	// only move counts matter
+	History_Requirement history_requirement() override {
+		return { 0, true, false };
+	}
+
+	// same as get_move() with the counts kept by Game
+	Move get_move_bounded(const vector& other_recent, const vector& self_recent, const History_Summary& summary) override {
+		if (summary.rounds == 0) return Move{ (short)0 };
+		return beat_most_frequent(summary.other_counts);
+	}
+
+	bool get_config(std::string& config) override {
+		config = "Frequency";
+		return true;
+	}
+
+	// Only count differences to the most frequent opponent move matter (counts normalized by their maximum); differences larger than
+	// cycle_gap_cap are saturated so matchups against e.g. Fixed Player (where one difference grows forever) still reach a repeating state
+	bool get_fingerprint(const vector& other_history, const vector& unused, const History_Summary& summary, std::uint64_t& fingerprint) override {
+		if (!gap_states_fit()) return false;
+		if (summary.rounds == 0) {
+			fingerprint = 0;
+			return true;
+		}
+		std::uint64_t gaps[K]{};
+		count_gaps(summary.other_counts, gaps);
+		fingerprint = 1;
+		for (std::uint64_t gap : gaps) {
+			fingerprint = fingerprint * (cycle_gap_cap + 2) + std::min(gap, cycle_gap_cap + 1);
+		}
+		return true;
+	}
+
+	// Markov state: 0 before the first round, otherwise 1 + gaps (count differences to the most frequent opponent move) in base
+	// cycle_gap_cap + 2; gaps saturate like in get_fingerprint() and a saturated move is assumed to never become most frequent again.
+	// That only holds if saturated differences keep growing (e.g. against Fixed Players), so states with a saturated gap aren't exact
+	bool markov_initial(std::uint64_t& state) override {
+		state = 0;
+		return gap_states_fit();
+	}
+
+	void markov_choices(std::uint64_t state, std::vector<Markov_Choice>& choices) override {
+		if (state == 0) {
+			choices.push_back({ 1, 0, state });
+			return;
+		}
+		std::uint64_t gaps[K]{};
+		decode_gaps(state, gaps);
+		short index{};
+		while (gaps[index] != 0) index += 1; // first most frequent move (same tie breaking as get_move())
+		choices.push_back({ 1, (short)Cyclic_Rules<K>::rotation[index][1], state });
+	}
+
+	std::uint64_t markov_observe(std::uint64_t after, short self_move, short other_move) override {
+		std::uint64_t gaps[K]{};
+		for (std::uint64_t& gap : gaps) gap = 1; // after the first opponent move all other moves are one behind
+		if (after == 0) gaps[other_move] = 0;
+		else {
+			decode_gaps(after, gaps);
+			if (gaps[other_move] == 0) { // most frequent move gets more frequent
+				for (short i{}; i < K; i += 1) gaps[i] = std::min(gaps[i] + 1, cycle_gap_cap + 1);
+				gaps[other_move] = 0;
+			}
+			else if (gaps[other_move] <= cycle_gap_cap) gaps[other_move] -= 1;
+		}
+		std::uint64_t state{};
+		for (int i{ K - 1 }; i >= 0; i -= 1) state = state * (cycle_gap_cap + 2) + gaps[i];
+		return 1 + state;
+	}
+
+	bool markov_counts_moves() override {
+		return true;
+	}
+
+	bool markov_exact(std::uint64_t state) override {
+		if (state == 0) return true;
+		std::uint64_t gaps[K]{};
+		decode_gaps(state, gaps);
+		return std::all_of(gaps, gaps + K, [](std::uint64_t gap) { return gap <= cycle_gap_cap; });
+	}
+
+	// A saturated move can only never become most frequent again if its count difference can't shrink within one period (> period)
+	// and doesn't shrink over a whole period either (opponent plays it at most as often as the most frequent move during the period)
+	bool confirm_period(const vector& other_history, const vector& unused, const History_Summary& summary, std::size_t period) override {
+		std::uint64_t gaps[K]{};
+		count_gaps(summary.other_counts, gaps);
+		std::uint64_t period_count[K]{};
+		for (std::size_t i{ other_history.size() - period }; i < other_history.size(); i += 1) {
+			period_count[other_history[i]] += 1;
+		}
+		short most_frequent{};
+		for (short i{}; i < K; i += 1) {
+			if (gaps[i] == 0) most_frequent = i;
+		}
+		for (short i{}; i < K; i += 1) {
+			if (gaps[i] > cycle_gap_cap and (gaps[i] <= period or period_count[i] > period_count[most_frequent])) return false;
+		}
+		return true;
+	}
+
+	// get_name is used for printing to console
+	std::string get_name() override {
+		return name;
+	}
+
+	// Every Player derived class has a name attribute
+	std::string name = "Frequency Player";
+
+private:
+	// beat_most_frequent() returns the move rotated by 1 (winning move) from the most frequent move of counts (first one if several are
+	// equally frequent)
+	static Move beat_most_frequent(const std::uint64_t counts[K]) {
+		std::uint64_t max{};
+		short index{};
+		for (short i{}; i < K; i += 1) {
+			if (counts[i] > max) {
+				max = counts[i];
+				index = i; // index of most frequently played opponent move shape
+			}
+		}
+		return Move{ index }.rotate_by(1);
+	}
+
+	// count_gaps() writes difference between count of most frequent opponent move and count of every opponent move to gaps
+	static void count_gaps(const std::uint64_t count[K], std::uint64_t gaps[K]) {
+		std::uint64_t max = *std::max_element(count, count + K);
+		for (int i{}; i < K; i += 1) gaps[i] = max - count[i];
+	}
+
+	static void decode_gaps(std::uint64_t state, std::uint64_t gaps[K]) {
+		state -= 1;
+		for (int i{}; i < K; i += 1) {
+			gaps[i] = state % (cycle_gap_cap + 2);
+			state /= (cycle_gap_cap + 2);
+		}
+	}
+
+	// count differences larger than this are equivalent in fingerprints (see confirm_period())
+	static constexpr std::uint64_t cycle_gap_cap{ 64 };
+
+	// gap_states_fit(): fingerprints and Markov states need (cycle_gap_cap + 2)^K + 1 values (up to K = 9); without them there are none
+	static constexpr bool gap_states_fit() {
+		std::uint64_t states{ 1 };
+		for (int i{}; i < K; i += 1) {
+			if (states > (std::numeric_limits<std::uint64_t>::max() - 1) / (cycle_gap_cap + 2)) return false;
+			states *= cycle_gap_cap + 2;
+		}
+		return true;
+	}
+};
+
+using Frequency = Cyclic_Frequency<3>;
+
+
+
+// Fixed: Always play the same move
+template<int K>
+struct Cyclic_Fixed : Cyclic_Player<K> {
+
+	using Move = Cyclic_Move<K>;
+	using History_Summary = Cyclic_History_Summary<K>;
+
+	Cyclic_Fixed(char move, std::string tag = "") : fixed_move{ move } {
+		if (not (tag == "")) name = name + "(" + move + ")" + tag;
+		else name = name + " (" + move + ")";
+	};
+
+	Move get_move(const vector& empty1, const vector& empty2) override {
+		// Always return the same move
+		return fixed_move;
+	}
+
+	History_Requirement history_requirement() override {
+		return { 0, false, false };
+	}
+
+	bool get_config(std::string& config) override {
+		config = std::string{ "Fixed(" } + fixed_move.shape() + ")";
+		return true;
+	}
+
+	// Fixed Player has no state at all
+	bool get_fingerprint(const vector& empty1, const vector& empty2, const History_Summary& unused, std::uint64_t& fingerprint) override {
+		fingerprint = 0;
+		return true;
+	}
+
+	bool markov_initial(std::uint64_t& state) override {
+		state = 0;
+		return true;
+	}
+
+	void markov_choices(std::uint64_t state, std::vector<Markov_Choice>& choices) override {
+		choices.push_back({ 1, fixed_move.index, 0 });
+	}
+
+	std::string get_name() override {
+		return name;
+	}
+
+	std::string name = "Fixed Player";
+
+private:
+	Move fixed_move;
+};
+
+using Fixed = Cyclic_Fixed<3>;
+
+
+
+std::mt19937 init_engine; // initialization engine for Random Player; this is necessary because if we initialize two random players
+						  // without a seed argument in quick succession, we get the same seed from time(0) (which only changes every second)
+
+// Random: Always play random move
+template<int K>
+struct Cyclic_Random : Cyclic_Player<K> {
+
+	using Move = Cyclic_Move<K>;
+
+	// Can supply seed for rng; otherwise pseudo random seed
+	Cyclic_Random(int s, std::string tag = "") : seed{ s }, seeded{ true } {
+		engine.seed(s);
+		if (not (tag == "")) name = name + " " + tag;
+	};
+	Cyclic_Random(std::string tag = "") {
+		engine.seed(distribution(init_engine)+time(0)); // pseudo random seed from current calendar time in seconds and the contribution from our init engine
+		if (not (tag == "")) name = name + " " + tag;
+
+	};
+
+	// move history not important to Random Player; can pass empty vectors
+	Move get_move(const vector& empty1, const vector& empty2) override {
+		short randn{};
+		randn = mod_euc(distribution(engine), K); // distribution returns uniformly distributed shorts; Euclidian modulo with K returns our final pseudo-random init value between 0 and K - 1
+		return Move{ randn };
+	}
+
+	History_Requirement history_requirement() override {
+		return { 0, false, false };
+	}
+
+	// only seeded Random Players are reproducible
+	bool get_config(std::string& config) override {
+		if (!seeded) return false;
+		config = "Random(" + std::to_string(seed) + ")";
+		return true;
+	}
+
+	// Markov description is the ideal Random Player: one state, every move with probability 1/K (independent of the seed)
+	bool markov_initial(std::uint64_t& state) override {
+		state = 0;
+		return true;
+	}
+
+	void markov_choices(std::uint64_t state, std::vector<Markov_Choice>& choices) override {
+		for (short move{}; move < K; move += 1) choices.push_back({ 1.0 / K, move, 0 });
+	}
+
+	bool markov_random() override {
+		return true;
+	}
+
+	std::string get_name() override {
+		return name;
+	}
+
+	std::string name = "Random Player";
+
+private:
+	// use mersenne twister random engine (Matsumoto and Nishimura); distribution returns short based on engine input
+	std::mt19937 engine;
+	std::uniform_int_distribution<int> distribution;
+
+	// seed is only meaningful if seeded is true (otherwise pseudo random seed)
+	int seed{};
+	bool seeded{};
+};
+
+using Random = Cyclic_Random<3>;
+
+
+
+// Rotation: Play opponent move rotated by x
+template<int K>
+struct Cyclic_Rotation : Cyclic_Player<K> {
+
+	using Move = Cyclic_Move<K>;
+	using History_Summary = Cyclic_History_Summary<K>;
+
+	Cyclic_Rotation(short by = 0, std::string tag = "") : rotation_by{ by } {
+		if (not (tag == "")) name = name + " " + tag;
+	};
+
+	Move get_move(const vector& other_history, const vector& self_history) override {
+		if (other_history.empty()) return Move{ (short)0 };
+
+		// get last element of opponent move history vector (last opponent move)
+		short last = other_history.back();
+
+		// rotate last opponent move by rotation_by and return
+		return Move{ last }.rotate_by(rotation_by);
+	}
+
+	// only last opponent move matters
+	History_Requirement history_requirement() override {
+		return { 1, false, false };
+	}
+
+	bool get_config(std::string& config) override {
+		config = "Rotation(" + std::to_string(mod_euc(rotation_by, K)) + ")"; // rotations are equivalent modulo K
+		return true;
+	}
+
+	// next move only depends on last opponent move (K if there is none yet)
+	bool get_fingerprint(const vector& other_history, const vector& self_history, const History_Summary& summary, std::uint64_t& fingerprint) override {
+		fingerprint = (other_history.empty() ? K : other_history.back());
+		return true;
+	}
+
+	// Markov state is the fingerprint
+	bool markov_initial(std::uint64_t& state) override {
+		state = K;
+		return true;
+	}
+
+	void markov_choices(std::uint64_t state, std::vector<Markov_Choice>& choices) override {
+		choices.push_back({ 1, (short)(state == K ? 0 : Move{ (short)state }.rotate_by(rotation_by).index), state });
+	}
+
+	std::uint64_t markov_observe(std::uint64_t after, short self_move, short other_move) override {
+		return (std::uint64_t)other_move;
+	}
+
+	std::string get_name() override {
+		return name;
+	}
+
+	std::string name = "Rotation Player";
+
+private:
+	short rotation_by{};
+};
+
+using Rotation = Cyclic_Rotation<3>;
+
+
+
+// Anti_Rotation: Figure out opponent rotation and play winning move against it
+template<int K>
+struct Cyclic_Anti_Rotation : Cyclic_Player<K> {
+
+	using Move = Cyclic_Move<K>;
+	using History_Summary = Cyclic_History_Summary<K>;
+	using Rules = Cyclic_Rules<K>;
+
+	// Verbose argument is used whenever a Player derived class has an internal state than may be interesting; in this case, the internal state
+	// is the opponent rotation Anti_Rotation has figured out; if true, will print internal state to console 
+	Cyclic_Anti_Rotation(bool verbose = false, std::string tag = "") : verbose{verbose} {
+		if (not (tag == "")) name = name + " " + tag;
+	}
+
+	Move get_move(const vector& other_history, const vector& self_history) {
+		// Assume opponent uses a rotation strategy; look at history and figure out by how much;
+		// play winning strategy (which is expected opponent move rotated by 1)
+
+		if (self_history.size() < 2) { // Anti_Rotation needs exactly two entries in opponent and self history in order to figure out opponent Rotation; 
+			return Move{ (short)0 };   // so return default Move if self_history size (which is always equal to other history size) is less than 2
+		}
+
+		short last_self = self_history[self_history.size() - 2]; // second to last self move
+		short other_response = other_history.back(); // last opponent move (opponent response to second to last self move)
+		short rotate = Rules::difference[other_response][last_self]; // index difference between second to last self move and opponent response (mod K) is opponent rotation
+
+		// print internal state to console if verbose is true
+		if (verbose) {
+			std::cout << "\nrotation used by other: " << rotate;
+			std::cout << "\npredicted other move: " << Rules::shape(Rules::rotation[self_history.back()][rotate]) << "\n";
+		}
+
+		return Move{ self_history.back() }.rotate_by(Rules::rotation[rotate][1]); // If opponent rotation is known, all we need to do in order to win is rotate last self move by that rotation + 1
+	}
+
+	// second to last and last self move, last opponent move
+	History_Requirement history_requirement() override {
+		return { 2, false, false };
+	}
+
+	bool get_config(std::string& config) override {
+		config = "Anti_Rotation";
+		return true;
+	}
+
+	// state is second to last and last self move plus last opponent move (or number of rounds played in the first two rounds)
+	bool get_fingerprint(const vector& other_history, const vector& self_history, const History_Summary& summary, std::uint64_t& fingerprint) override {
+		std::size_t n = self_history.size();
+		if (n < 2) fingerprint = n;
+		else fingerprint = 2 + (self_history[n - 2] * K + other_history.back()) * K + self_history.back();
+		return true;
+	}
+
+	// Markov state: 0 before the first round, 1 + first self move after it (needed once Anti_Rotation's own moves differ from Rock,
+	// e.g. as part of Meta_Player_Rand_Strat), then K + 1 + (second to last self move * K + last opponent move) * K + last self move
+	bool markov_initial(std::uint64_t& state) override {
+		state = 0;
+		return true;
+	}
+
+	void markov_choices(std::uint64_t state, std::vector<Markov_Choice>& choices) override {
+		if (state < K + 1) {
+			choices.push_back({ 1, 0, state });
+			return;
+		}
+		std::uint64_t moves = state - (K + 1);
+		short last_self = (short)(moves / (K * K)), other_response = (short)(moves / K % K), self_last = (short)(moves % K);
+		short rotate = Rules::difference[other_response][last_self];
+		choices.push_back({ 1, (short)Rules::rotation[self_last][Rules::rotation[rotate][1]], state });
+	}
+
+	std::uint64_t markov_observe(std::uint64_t after, short self_move, short other_move) override {
+		if (after == 0) return 1 + (std::uint64_t)self_move;
+		short previous_self = (short)(after < K + 1 ? after - 1 : (after - (K + 1)) % K);
+		return K + 1 + (std::uint64_t)((previous_self * K + other_move) * K + self_move);
+	}
+
+
+	std::string get_name() override {
+		return name;
+	}
+
+	std::string name = "Anti Rotation Player";
+	bool verbose{};
+};
+
+using Anti_Rotation = Cyclic_Anti_Rotation<3>;
+
+
+
+// Human: Player that prompts for human input for move decision
+struct Human : Player {
+
+	Human(std::string tag = "") {
+		if (not (tag == "")) name = name + " " + tag;
+	}
+
+	bool interactive() override {
+		return true;
+	}
+
+	// Move history is not important to human player; if played on console, move history will be accessible by Game::evaluate_round()
+	Move get_move(const vector& empty1, const vector& empty2) override {
+
+		// shape variable stores user input
+		short shape{};
+
+		while (true) {
+			try {
+				std::cout << name << ", Input Move shape (0 (Rock), 1 (Paper), 2 (Scissors)): ";
+				std::cin >> shape;
+
+				// throw errors if unser input is out of range or invalid type (cin will be in bad state and cin=0)
+				if (shape > 2 or shape < 0) throw std::range_error{ "Move shape must be 0 (Rock), 1 (Paper) or 2 (Scissors)." };
+				if (!std::cin) throw std::runtime_error{ "Invalid input." };
+				break;
+			}
+			catch (std::range_error& e) {
+				// if invalid input: clear last bit in stream buffer and ignore rest of stream buffer until '\n'
+				std::cout << "Error: " << e.what() << std::endl;
+				std::cin.clear();
+				std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+				continue;
+			}
+			catch (std::runtime_error& e) {
+				std::cout << "Error: " << e.what() << std::endl;
+				std::cin.clear();
+				std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+				continue;
+			}
+
+		}
+
+		return Move{ shape };
+
+	}
+
+	History_Requirement history_requirement() override {
+		return { 0, false, false };
+	}
+
+	std::string get_name() override {
+		return name;
+	}
+
+	std::string name = "Pathetic Human Player";
+};
+
+
+//// Meta Players: Can access and play with all previously defined Player strategies 
+
+// evaluate_round() will return index distance between given Moves, which is =0 if Moves are equal, =1 if m1 wins against m2 and =2 if m2 wins against m1
+// evaluate round is not a member of any class, because it needs to be called by Meta Players (in order to evaluate strategy performance) and by Game (in order to evaluate current round)
+// this uses the same principle Anti_Rotation uses in order to figure out opponent rotation, but is applied to current Moves (index difference mod K
+// decides the outcome, see Cyclic_Rules)
+template<int K>
+constexpr short evaluate_round(const Cyclic_Move<K> m1, const Cyclic_Move<K> m2) noexcept {
+	return Cyclic_Rules<K>::outcome[m1.index][m2.index];
+}
+
+
+// Scoring functions: Used by Meta Player in order to modify internal scores representing different strategies based on previous strategy performance
+// Every scoring function applies different operations on given score (e.g. ..._add() adds/subtracts a constant value from score depending on win/loss of respective strategy)
+
+// naive_score_mul() multiplies score by given constants in scoring_vector
+// score vector : {draw multiplier, win multiplier, loss multiplier, floor, ceiling, decay constant}
+void naive_score_mul(double& score, short index_distance, double score_vector[6]) {
+
+	// scoring_vector is a caller supplied array which contains the constants used by the respective scoring function to modify scores
+	// index distance determines whether strategy loses, wins or results in a draw; is supplied by evaluate_round() called by Meta_Player::get_move()
+	switch (index_distance) {
+	case 0: // draw
+		score *= score_vector[0];
+		break;
+	case 1: // win
+		score *= score_vector[1];
+		break;
+	case 2: // loss
+		score *= score_vector[2];
+		break;
+	}
+	if (score < score_vector[3]) score = score_vector[3]; // score_vector[3] is floor: if score is less than floor after scoring function operation, set score equal to floor
+														// --> scores will never be smaller than floor; prevents scores from diminishing without bound
+	if (score > score_vector[4]) score = score_vector[4]; // score_vector[4] is ceiling: if score is larger than ceiling after scoring function operation, set score equal to ceiling
+														// --> scores will never be larger than ceiling; prevents boundless growth
+	if (!(score_vector[5] == 1)) score *= score_vector[5]; // score_vector[5] is decay constant: multiply score by decay constant
+														// --> every score will continually diminish (decay < 1) or grow (decay > 1) regardless of outcome
+}
+
+// naive_score_add() adds to score given constants in scoring_vector
+// score vector : {draw constant, win constant, loss constant, floor, ceiling, decay constant}
+void naive_score_add(double& score, short index_distance, double score_vector[6]) {
+	switch (index_distance) {
+	case 0: // draw
+		score += score_vector[0];
+		break;
+	case 1:// win
+		score += score_vector[1];
+		break;
+	case 2: // loss
+		score += score_vector[2];
+		break;
+	}
+	if (score < score_vector[3]) score = score_vector[3];
+	if (score > score_vector[4]) score = score_vector[4];
+	if (!(score_vector[5] == 1)) score *= score_vector[5];
+}
+
+// drop_switch_mul() multilies score by constants in scoring_vector in case of win or draw, but sets score back to scoring_vector[2] in case of loss
+// score vector : {draw multiplier, win multiplier, loss value, floor, ceiling, decay constant}
+void drop_switch_mul(double& score, short index_distance, double score_vector[6]) {
+	switch (index_distance) {
+	case 0: // draw
+		score *= score_vector[0];
+		break;
+	case 1: // win
+		score *= score_vector[1];
+		break;
+	case 2: // loss
+		score = score_vector[2]; // set score back to value (-> drop)
+		break;
+	}
+	if (score < score_vector[3]) score = score_vector[3];
+	if (score > score_vector[4]) score = score_vector[4];
+	if (!(score_vector[5] == 1)) score *= score_vector[5];
+}
+
+// drop_switch_add() adds to score constants in scoring_vector in case of win or draw, buts sets score back to scoring_vector[3] in case of loss
+// score vector : {draw constant, win constant, loss value, floor, ceiling, decay constant}
+void drop_switch_add(double& score, short index_distance, double score_vector[6]) {
+	switch (index_distance) {
+	case 0: // draw
+		score += score_vector[0];
+		break;
+	case 1: // win
+		score += score_vector[1];
+		break;
+	case 2: // loss
+		score = score_vector[2]; // set score back to value (-> drop)
+		break;
+	}
+	if (score < score_vector[3]) score = score_vector[3];
+	if (score > score_vector[4]) score = score_vector[4];
+	if (!(score_vector[5] == 1)) score *= score_vector[5];
+}
+
+
+// Type alias for scoring function pointer used to initialize Meta Player
+using scoring_func_ptr = void (*)(double& score, short index_distance, double score_vector[6]);
+
+
+// Fork_Join_Pool: persistent worker threads for short parallel loops within a round (e.g. Meta Player's oracles, see
+// Meta_Player_Naive::set_oracle_pool()). A loop is published with a single atomic store: workers that are still spinning from the
+// last loop pick it up without a system call, workers only park on a condition variable after spin_limit idle checks (and are
+// woken by the next loop then). The calling thread works on the loop as well, so a pool of size() 1 has no worker threads at all.
+struct Fork_Join_Pool {
+
+	// threads: number of threads working on a loop including the calling thread (0: one per hardware thread)
+	Fork_Join_Pool(unsigned threads = 0) {
+		if (threads == 0) threads = std::max(std::thread::hardware_concurrency(), 1u);
+		for (unsigned t{ 1 }; t < threads; t += 1) workers.emplace_back([this]() { work(); });
+	}
+
+	~Fork_Join_Pool() {
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			stop = true;
+		}
+		wake.notify_all();
+		for (std::thread& worker : workers) worker.join();
+	}
+
+	Fork_Join_Pool(const Fork_Join_Pool&) = delete;
+	Fork_Join_Pool& operator=(const Fork_Join_Pool&) = delete;
+
+	unsigned size() const {
+		return (unsigned)workers.size() + 1;
+	}
+
+	// run() calls task(k) for every k in [0, n) and returns once all calls are done; the first exception thrown by a task is rethrown.
+	// Only one thread may call run() at a time (n < 2^20)
+	void run(std::size_t n, const std::function<void(std::size_t)>& task) {
+		if (n == 0) return;
+		if (n > index_mask) throw std::invalid_argument{ "Fork_Join_Pool::run(): too many tasks" };
+		loop_task = &task;
+		completed.store(0, std::memory_order_relaxed);
+		error = nullptr;
+		std::uint64_t generation = ((next.load(std::memory_order_relaxed) >> 40) + 1) & generation_mask;
+		{
+			std::lock_guard<std::mutex> lock{ mutex }; // parked workers check next under the lock (no lost wake-up)
+			next.store(generation << 40 | (std::uint64_t)n << 20, std::memory_order_release);
+		}
+		if (parked.load(std::memory_order_relaxed)) wake.notify_all();
+
+		help(generation);
+		for (int spin{}; completed.load(std::memory_order_acquire) < n; spin += 1) {
+			if (spin < spin_limit) pause();
+			else std::this_thread::yield();
+		}
+		if (error) std::rethrow_exception(error);
+	}
+
+	static constexpr int spin_limit{ 1 << 12 };
+
+private:
+	// next packs the current loop: generation (24 bits) | number of tasks (20 bits) | next unclaimed task (20 bits); tasks are claimed
+	// with a compare-and-swap of the whole word, so a late worker can't claim a task of a newer loop with stale loop data
+	static constexpr std::uint64_t index_mask{ (1u << 20) - 1 }, generation_mask{ (1u << 24) - 1 };
+
+	static void pause() {
+#if defined(__x86_64__) or defined(_M_X64) or defined(__i386__)
+		_mm_pause();
+#endif
+	}
+
+	// help() runs unclaimed tasks of loop generation until none is left
+	void help(std::uint64_t generation) {
+		std::uint64_t current = next.load(std::memory_order_acquire);
+		while ((current >> 40) == generation and (current & index_mask) < (current >> 20 & index_mask)) {
+			if (!next.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel)) continue;
+			try {
+				(*loop_task)(current & index_mask);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock{ mutex };
+				if (!error) error = std::current_exception();
+			}
+			completed.fetch_add(1, std::memory_order_release);
+			current = next.load(std::memory_order_acquire);
+		}
+	}
+
+	void work() {
+		std::uint64_t seen{};
+		while (true) {
+			std::uint64_t generation = next.load(std::memory_order_acquire) >> 40;
+			for (int spin{}; generation == seen and spin < spin_limit; spin += 1) {
+				pause();
+				generation = next.load(std::memory_order_acquire) >> 40;
+			}
+			if (generation == seen) {
+				std::unique_lock<std::mutex> lock{ mutex };
+				parked.fetch_add(1, std::memory_order_relaxed);
+				wake.wait(lock, [&]() { return stop or (next.load(std::memory_order_acquire) >> 40) != seen; });
+				parked.fetch_sub(1, std::memory_order_relaxed);
+				if (stop) return;
+				generation = next.load(std::memory_order_acquire) >> 40;
+			}
+			seen = generation;
+			help(generation);
+		}
+	}
+
+	std::vector<std::thread> workers{};
+	std::atomic<std::uint64_t> next{};
+	std::atomic<std::size_t> completed{};
+	std::atomic<unsigned> parked{};
+	const std::function<void(std::size_t)>* loop_task{};
+	std::exception_ptr error{};
+	std::mutex mutex{};
+	std::condition_variable wake{};
+	bool stop{};
+};
+
+
+// Meta_Player_Naive has access to all strategies defined above (except Human Player of course) and plays strategy with highest score; keeps internal array of scores
+// and modifies these according to previous strategy performance
+template<int K>
+struct Cyclic_Meta_Player_Naive : Cyclic_Player<K> {
+
+	using Move = Cyclic_Move<K>;
+	using Player = Cyclic_Player<K>;
+	using History_Summary = Cyclic_History_Summary<K>;
+
+	// Meta Player is initialized with a scoring function pointer and a scoring vector used by the pointed to scoring function
+	Cyclic_Meta_Player_Naive(bool verbose = false, std::string tag = "", scoring_func_ptr scoring_func = naive_score_mul, double scoring_vector[] = {}) : \
+		scoring_func{ scoring_func }, scoring_vector{ scoring_vector }, verbose{ verbose } {
+		if (not (tag == "")) name = name + " " + tag;
+	}
+
+
+	Move get_move(const vector& other_history, const vector& self_history) override {
+		if (other_history.size() < 1) return Move{ (short)0 };
+
+		// histories without the last Move pair (see below); kept between rounds and only extended by the new Moves
+		update_prefixes(other_history, self_history);
+		Move last_other{ other_history[other_history.size() - 1] };
+
+		// every measure_every-th round the time of consulting all oracles is measured; oracles are consulted in parallel
+		// (one task per oracle, see set_oracle_pool()) while this takes longer than parallel_threshold on average
+		bool measure = (oracle_pool and round_counter % measure_every == 0);
+		round_counter += 1;
+		auto start = (measure ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{});
+
+		if (oracle_pool and use_pool) {
+			oracle_pool->run(strategies.size(), [this, last_other](std::size_t j) { consult_oracle(j, last_other); });
+		}
+		else if (deadline != no_deadline) {
+			// anytime (see get_move_until()): the built-in oracles are always consulted, additional ones in order as long as they are
+			// expected to finish in time (last measured time per oracle, keeping enough time for the final move of the slowest oracle);
+			// scores of oracles that aren't consulted keep their value for this round
+			oracle_costs.resize(strategies.size());
+			std::chrono::nanoseconds reserve = *std::max_element(oracle_costs.begin(), oracle_costs.end()) / 3;
+			for (std::size_t j{}; j < strategies.size(); j += 1) {
+				auto now = std::chrono::steady_clock::now();
+				if (j >= 4 and now + oracle_costs[j] + reserve > deadline) {
+					skipped_oracles += 1;
+					continue;
+				}
+				consult_oracle(j, last_other);
+				oracle_costs[j] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - now);
+			}
+		}
+		else {
+			// i is rotation applied to every strategy
+			for (int i{}; i < K; i += 1) {
+				// j is index of respective strategy in strategies vector; i and j are used to access the respective score in scores array
+				for (int j{}; Player * strat_ptr : strategies) { // loop through every player pointer in strategies array
+
+					// next Move within each iteration is player strategy (Player.get_move(history)) rotated by i (0 to K - 1)
+					// we pass to Player::get_move_bounded() the entire move history (notice self_history is first argument -> puts itself in shoes of opponent)
+					// except for the last Move pair (vector slice from beginning to end-1) and its move counts (so e.g. Frequency doesn't count them
+					// every round); will return Move that would be played against self last Move in current round
+					Move next = strat_ptr->get_move_bounded(self_prefix, other_prefix, prefix_summary).rotate_by(i);
+
+					// evaluate whether this Move rotated by 1 would win against current opponent last Move
+					short index_dist = evaluate_round(next, last_other);
+
+					// call scoring function based on index distance (0=draw, 1=win, 2=loss)
+					scoring_func(scores[i][j], index_dist, scoring_vector);
+
+					j += 1; // increment j after scores access; would lead to out of bounds access if incremented any sooner
+				}
+			}
+		}
+
+		if (measure) {
+			std::chrono::nanoseconds elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+			if (use_pool) elapsed *= std::min((std::size_t)oracle_pool->size(), strategies.size()); // work, not wall time
+			oracle_time = (oracle_time * 3 + elapsed) / 4;
+			use_pool = (oracle_pool->size() > 1 and strategies.size() > 1 and oracle_time > parallel_threshold);
+		}
+
+		// After every possible strategy has been evaluated, find the best perfroming strategy (corresponds to largest value in scores array)
+		max_index_i = 0; max_index_j = 0;
+		double max{};
+		for (int curr_index_i{}; const std::vector<double>& element : scores) { // by reference: a copy would allocate every round
+			for (int curr_index_j{};  double score : element) {
+				if (score > max) {
+					max = score;
+					max_index_i = curr_index_i;
+					max_index_j = curr_index_j;
+				}
+				curr_index_j += 1;
+			}
+			curr_index_i += 1;
+		}
+
+		if (verbose) get_current_state();
+		
+		if (max < 1) return teller_rand.get_move(other_history, self_history); // return random Move if no strategy perfroms reasonably well
+																			   // --> failsafe: win rate will never drop far below 50% on average if random moves are played
+
+		// return move played by best performing strategy (strategy is always basic strategy (rotation, frequency, ...) and a rotation between 0 and K - 1)
+		History_Summary summary = prefix_summary; // whole histories are the prefixes plus the last Move pair
+		summary.rounds += 1;
+		summary.other_counts[self_history.back()] += 1;
+		summary.self_counts[other_history.back()] += 1;
+		return strategies[max_index_j]->get_move_bounded(self_history, other_history, summary).rotate_by(max_index_i);
+	}
+
+	// scores[rotation][strategy] as described above (e.g. for plotting score trajectories)
+	const std::vector<std::vector<double>>& get_scores() {
+		return scores;
+	}
+
+	// names of strategies in repertoire (order of second scores index)
+	std::vector<std::string> get_strategy_names() {
+		std::vector<std::string> names{};
+		for (Player* strat_ptr : strategies) names.push_back(strat_ptr->get_name());
+		return names;
+	}
+
+	// print internal state (scores, current best performing strategy) to cosnole
+	void get_current_state() {
+		std::cout << "\n\n\n----------------\nMeta Player " << name << " current scores:\n\n";
+		std::cout << "[{freq, anti_rot, rot, fix";
+		for (std::size_t j{ 4 }; j < strategies.size(); j += 1) std::cout << ", " << strategies[j]->get_name(); // additional oracles (if any)
+		std::cout << "}Rot0, {...}Rot1, {...}Rot" << K - 1 << "}]\n";
+		for (const std::vector<double>& element : scores) {
+			for (double score : element) {
+				std::cout << score << " ";
+			}
+			std::cout << "  ";
+		}
+		std::cout << "\n\nCurrent Strategy: " << strategies[max_index_j]->get_name() << " Rotated by " << max_index_i << \
+					"\n----------------\n\n\n";
+	}
+
+	// Meta Player is only reproducible if it never falls back to its (unseeded) random oracle, i.e. if no score can drop below 1:
+	// scores are clamped to floor and then multiplied by decay, so floor * decay has to be at least 1
+	bool get_config(std::string& config) override {
+		if (!scoring_vector or warm_started) return false;
+		double lowest_score = (scoring_vector[5] == 1 ? scoring_vector[3] : scoring_vector[3] * std::min(scoring_vector[5], 1.0));
+		if (lowest_score < 1) return false;
+
+		std::ostringstream oss{};
+		oss.precision(17); // exact round trip of scoring vector values
+		if (scoring_func == naive_score_mul) oss << "Meta_Player_Naive(naive_score_mul";
+		else if (scoring_func == naive_score_add) oss << "Meta_Player_Naive(naive_score_add";
+		else if (scoring_func == drop_switch_mul) oss << "Meta_Player_Naive(drop_switch_mul";
+		else if (scoring_func == drop_switch_add) oss << "Meta_Player_Naive(drop_switch_add";
+		else return false; // unknown scoring function can't be described
+		oss << ",{";
+		for (int i{}; i < 6; i += 1) oss << (i ? ";" : "") << scoring_vector[i];
+		oss << "}";
+		for (std::size_t j{ 4 }; j < strategies.size(); j += 1) { // additional oracles are part of Meta Player's configuration
+			std::string oracle_config{};
+			if (!strategies[j]->get_config(oracle_config)) return false;
+			oss << "," << oracle_config;
+		}
+		oss << ")";
+		config = oss.str();
+		return true;
+	}
+
+	// reset scores (in case of multiple Games); also works for extended repertoires (see add_oracle())
+	void reset_scores() {
+		for (std::vector<double>& element : scores) {
+			for (double& score : element) score = 1;
+		}
+		warm_started = false;
+	}
+
+	// warm_start() seeds scores with scores learned in earlier games against the same opponent (layout of get_scores(), columns
+	// matched to the repertoire by strategy name, see RPS_Profile.h): score = 1 + trust * (learned - 1), so trust 0 is a cold start and
+	// trust 1 continues where the last game ended; strategies without learned scores start at 1. Moves of a warm started Meta Player
+	// depend on the profile, so it has no config until reset_scores()
+	void warm_start(const std::vector<std::string>& names, const std::vector<std::vector<double>>& learned, double trust) {
+		reset_scores();
+		trust = std::clamp(trust, 0.0, 1.0);
+		for (std::size_t j{}; j < strategies.size(); j += 1) {
+			auto column = std::find(names.begin(), names.end(), strategies[j]->get_name());
+			if (column == names.end()) continue;
+			for (std::size_t i{}; i < scores.size() and i < learned.size(); i += 1) {
+				std::size_t k = (std::size_t)(column - names.begin());
+				if (k < learned[i].size()) scores[i][j] = 1 + trust * (learned[i][k] - 1);
+			}
+		}
+		warm_started = (trust > 0);
+	}
+
+	// reset scores and oracle Players
+	void reset() override {
+		reset_scores();
+		for (Player* strat_ptr : strategies) strat_ptr->reset();
+		other_prefix.clear();
+		self_prefix.clear();
+		prefix_summary = History_Summary{};
+	}
+
+	// set_oracle_pool() lets Meta Player consult its oracles in parallel on pool (not owned, nullptr: always sequential); every oracle is
+	// one task, so this only pays off for expensive oracles (plugins, scripts, long histories). Whether pool is used is decided
+	// automatically from the measured time of consulting all oracles: parallel while it takes longer than threshold per round.
+	// Moves don't depend on the path taken (every oracle is still consulted in the same order by one thread at a time)
+	void set_oracle_pool(Fork_Join_Pool* pool, std::chrono::nanoseconds threshold = 20us) {
+		oracle_pool = pool;
+		parallel_threshold = threshold;
+		use_pool = false;
+		round_counter = 0;
+		oracle_time = {};
+	}
+
+	// true if oracles were consulted in parallel in the last round
+	bool consults_in_parallel() const {
+		return oracle_pool and use_pool;
+	}
+
+	// Meta Player is an anytime strategy: with a deadline, additional oracles are only consulted while there is time left
+	Move get_move_until(const vector& other_history, const vector& self_history, std::chrono::steady_clock::time_point move_deadline) override {
+		deadline = move_deadline;
+		Move move = get_move(other_history, self_history);
+		deadline = no_deadline;
+		return move;
+	}
+
+	// number of oracle consultations skipped because a deadline had passed (see get_move_until())
+	long long get_skipped_oracles() const {
+		return skipped_oracles;
+	}
+
+	// add_oracle() extends Meta Player's repertoire by an additional strategy (e.g. a plugin strategy, see RPS_Plugin.h);
+	// Meta Player takes ownership of the oracle and adds a score column for it (rotated by 0 to K - 1 like every other strategy)
+	void add_oracle(Player* oracle) {
+		owned_oracles.emplace_back(oracle);
+		strategies.push_back(oracle);
+		for (std::vector<double>& element : scores) element.push_back(1);
+	}
+
+	std::string get_name() override {
+		return name;
+	}
+
+private:
+	// update_prefixes() keeps other_prefix and self_prefix equal to the histories without their last Move; histories of a Game only
+	// grow, so usually only the Moves of the previous round are appended (instead of copying both histories for every oracle).
+	// The shortcut needs histories that are strict extensions of the prefixes. The same history vectors as in the previous call, with
+	// unchanged storage, are taken to have only grown (a Game's histories are only appended to; clearing them is seen as a shorter
+	// history); any other histories (other vectors, or reallocated ones, which happens O(log n) times per game) are compared with the
+	// prefixes in full. Histories that don't extend them (e.g. a reused Meta Player without reset()) rebuild the prefixes.
+	// prefix_summary counts the prefixes along (from the oracles' point of view)
+	void update_prefixes(const vector& other_history, const vector& self_history) {
+		std::size_t length = other_history.size() - 1;
+		bool continues = (other_prefix.size() <= length and self_prefix.size() <= length and self_history.size() >= other_history.size());
+		bool same_storage = (&other_history == seen_other and &self_history == seen_self and other_history.data() == seen_other_data \
+			and self_history.data() == seen_self_data);
+		if (continues and !same_storage) {
+			continues = std::equal(other_prefix.begin(), other_prefix.end(), other_history.begin()) \
+				and std::equal(self_prefix.begin(), self_prefix.end(), self_history.begin());
+		}
+		seen_other = &other_history;
+		seen_self = &self_history;
+		seen_other_data = other_history.data();
+		seen_self_data = self_history.data();
+		if (!continues) {
+			other_prefix.clear();
+			self_prefix.clear();
+			prefix_summary = History_Summary{};
+		}
+		for (std::size_t k{ other_prefix.size() }; k < length; k += 1) {
+			prefix_summary.other_counts[self_history[k]] += 1;
+			prefix_summary.self_counts[other_history[k]] += 1;
+		}
+		prefix_summary.rounds = length;
+		other_prefix.insert(other_prefix.end(), other_history.begin() + other_prefix.size(), other_history.begin() + length);
+		self_prefix.insert(self_prefix.end(), self_history.begin() + self_prefix.size(), self_history.begin() + length);
+	}
+
+	// consult_oracle() scores oracle j rotated by 0 to K - 1 (one task of the parallel path; only touches column j of scores)
+	void consult_oracle(std::size_t j, Move last_other) {
+		for (int i{}; i < K; i += 1) {
+			Move next = strategies[j]->get_move_bounded(self_prefix, other_prefix, prefix_summary).rotate_by(i);
+			scoring_func(scores[i][j], evaluate_round(next, last_other), scoring_vector);
+		}
+	}
+
+	// Initalize "Oracle Players" Meta Player consults whenever a move decision has to be made; can be thought of as Meta Player's repertoire of strategies
+	Cyclic_Frequency<K> teller_freq{};
+	Cyclic_Anti_Rotation<K> teller_anti_rot{};
+	Cyclic_Rotation<K> teller_rot{ 0 };
+	Cyclic_Random<K> teller_rand{};
+	Cyclic_Fixed<K> teller_fix{ Cyclic_Rules<K>::shape(0) };
+
+	// Putting the oracle Players (except Random which is called whenever scores fall below a certain threshold) into a Player pointer vector "strategies"
+	std::vector<Player*> strategies{ &teller_freq, &teller_anti_rot, &teller_rot, &teller_fix};
+
+	// oracles added by add_oracle() are owned by Meta Player (the built-in oracles above are members)
+	std::vector<std::unique_ptr<Player>> owned_oracles{};
+
+	// 2d score array: corresponds to scores of all 4 main stratgies {Frequency, Anti_Rotation, Rotation, Fixed} rotated by 0 (first element in scores), by 1 (second element), ... or by K - 1 (last element)
+	std::vector<std::vector<double>> scores = std::vector<std::vector<double>>(K, std::vector<double>(4, 1));
+
+	// scoring function pointer pointing to scoring function used for strategy performance evaluation
+	scoring_func_ptr scoring_func;
+
+	// scoring vector pointer passed to scoring function pointed to by scoring_func
+	double* scoring_vector = new double[3];
+
+	// these keep track of best performing strategy: used to index access highest score in scores 2d array
+	int max_index_i{}, max_index_j{};
+
+	// histories without the last Move pair, as passed to the oracles, and their move counts; seen_*: histories of the last
+	// update_prefixes() call and their storage
+	vector other_prefix{}, self_prefix{};
+	History_Summary prefix_summary{};
+	const vector* seen_other{};
+	const vector* seen_self{};
+	const short* seen_other_data{};
+	const short* seen_self_data{};
+
+	// parallel oracle consultation (see set_oracle_pool())
+	static constexpr long long measure_every{ 16 };
+	Fork_Join_Pool* oracle_pool{};
+	std::chrono::nanoseconds parallel_threshold{};
+	std::chrono::nanoseconds oracle_time{};
+	long long round_counter{};
+	bool use_pool{};
+
+	// deadline of the current move (see get_move_until())
+	static constexpr std::chrono::steady_clock::time_point no_deadline{ std::chrono::steady_clock::time_point::max() };
+	std::chrono::steady_clock::time_point deadline{ no_deadline };
+	std::vector<std::chrono::nanoseconds> oracle_costs{}; // last time of consulting every oracle (three get_move() calls)
+	long long skipped_oracles{};
+
+	bool warm_started{}; // scores seeded by warm_start()
+
+	bool verbose = false;
+	std::string name = "Naive Meta Player";
+};
+
+using Meta_Player_Naive = Cyclic_Meta_Player_Naive<3>;
+
+
+// Meta_Player_Rand_Strat plays one of four basic strategies rotated by 0, 1 or 2 for a number of rounds; this will be used to test Meta_Player_Naive performance against switching strategies
+struct Meta_Player_Rand_Strat : Player {
+	// init_rounds (0-20), init_strat and init_rot: state before the first round, i.e. the first init_rounds + 1 moves are played by basic
+	// strategy init_strat rotated by init_rot; with init_rounds = 0 the first move already draws a new strategy (the default)
+	Meta_Player_Rand_Strat(bool verbose = false, std::string tag = "", int init_rounds = 0, int init_strat = 0, int init_rot = 0) : \
+		verbose{ verbose }, initial{ std::clamp(init_rounds, 0, 20), mod_euc(init_strat, 4), mod_euc(init_rot, 3) } {
+		if (not (tag == "")) name = name + " " + tag;
+		curr_rounds = initial[0];
+		curr_strat = initial[1];
+		curr_rot = initial[2];
+	}
+
+	Move get_move(const vector& other_history, const vector& self_history) {
+		next_strategy();
+		return strategies[curr_strat]->get_move(other_history, self_history).rotate_by(curr_rot); // return current basic strategy rotated by current rotation
+	}
+
+	// everything the basic strategies need
+	History_Requirement history_requirement() override {
+		return { 2, true, false };
+	}
+
+	Move get_move_bounded(const vector& other_recent, const vector& self_recent, const History_Summary& summary) override {
+		next_strategy();
+		return strategies[curr_strat]->get_move_bounded(other_recent, self_recent, summary).rotate_by(curr_rot);
+	}
+
+	// engine is default seeded, so Random Strategy Meta Player always plays the same sequence of strategies (given the initial state)
+	bool get_config(std::string& config) override {
+		config = "Meta_Player_Rand_Strat";
+		if (initial[0] or initial[1] or initial[2]) config += "(" + std::to_string(initial[0]) + "," + std::to_string(initial[1]) + "," + std::to_string(initial[2]) + ")";
+		return true;
+	}
+
+	// Markov state packs curr_rounds, curr_strat, curr_rot and the Markov states of the basic strategies (which keep following the game
+	// while they aren't played); strategy switches are modelled as uniformly distributed
+	bool markov_initial(std::uint64_t& state) override {
+		std::uint64_t sub[3]{};
+		teller_freq.markov_initial(sub[0]);
+		teller_anti_rot.markov_initial(sub[1]);
+		teller_rot.markov_initial(sub[2]);
+		state = pack_state(curr_rounds, curr_strat, curr_rot, sub);
+		return true;
+	}
+
+	void markov_choices(std::uint64_t state, std::vector<Markov_Choice>& choices) override {
+		std::uint64_t sub[3]{};
+		int rounds = (int)(state >> 26 & 31), strat = (int)(state >> 31 & 3), rot = (int)(state >> 33 & 3);
+		unpack_sub_states(state, sub);
+
+		short moves[4]{}; // next move of every basic strategy (all of them are deterministic)
+		std::vector<Markov_Choice> sub_choices{};
+		Player* sub_players[3]{ &teller_freq, &teller_anti_rot, &teller_rot };
+		for (int k{}; k < 3; k += 1) {
+			sub_choices.clear();
+			sub_players[k]->markov_choices(sub[k], sub_choices);
+			moves[k] = sub_choices[0].move;
+		}
+		moves[3] = Move{ 'R' }.index;
+
+		if (rounds) {
+			choices.push_back({ 1, (short)rotation_table[moves[strat]][rot], pack_state(rounds - 1, strat, rot, sub) });
+			return;
+		}
+		for (int new_rounds{}; new_rounds < 21; new_rounds += 1) {
+			for (int new_strat{}; new_strat < 4; new_strat += 1) {
+				for (int new_rot{}; new_rot < 3; new_rot += 1) {
+					choices.push_back({ 1.0 / (21 * 4 * 3), (short)rotation_table[moves[new_strat]][new_rot], pack_state(new_rounds, new_strat, new_rot, sub) });
+				}
+			}
+		}
+	}
+
+	std::uint64_t markov_observe(std::uint64_t after, short self_move, short other_move) override {
+		std::uint64_t sub[3]{};
+		unpack_sub_states(after, sub);
+		sub[0] = teller_freq.markov_observe(sub[0], self_move, other_move);
+		sub[1] = teller_anti_rot.markov_observe(sub[1], self_move, other_move);
+		sub[2] = teller_rot.markov_observe(sub[2], self_move, other_move);
+		return pack_state((int)(after >> 26 & 31), (int)(after >> 31 & 3), (int)(after >> 33 & 3), sub);
+	}
+
+	// draws strategy switches and counts opponent moves for its Frequency strategy, which is the only part of the state that may lump
+	bool markov_random() override {
+		return true;
+	}
+
+	bool markov_counts_moves() override {
+		return true;
+	}
+
+	bool markov_exact(std::uint64_t state) override {
+		std::uint64_t sub[3]{};
+		unpack_sub_states(state, sub);
+		return teller_freq.markov_exact(sub[0]);
+	}
+
+	// print internal state (current basic strategy, current rotation) to console
+	void get_current_state() {
+		std::cout << "\n\n\n----------------\nMeta Player " << name << " current strategy:\n\n";
+		std::cout << "\n\nCurrent Strategy: " << strategies[curr_strat]->get_name() << "Rotated by " << curr_rot << \
+			"\n----------------\n\n\n";
+	}
+
+	std::string get_name() override {
+		return name;
+	}
+
+private:
+	// next_strategy() counts down rounds of the current basic strategy (called once per get_move())
+	void next_strategy() {
+		if (!curr_rounds) { // if curr_rounds reaches 0, generate a new strategy, rotation and rounds
+			curr_rounds = mod_euc(distribution(engine), 21); // will play random strategy for number of rounds between 0 and 20
+			curr_strat = mod_euc(distribution(engine), 4); // random basic strategy
+			curr_rot = mod_euc(distribution(engine), 3); // random rotation between 0 and 2
+		}
+		else if (curr_rounds) curr_rounds -= 1; // after every get_move() call, decrement curr_rounds by 1
+	}
+
+	// Markov state bits: Frequency 0-18, Anti_Rotation 19-23, Rotation 24-25, curr_rounds 26-30, curr_strat 31-32, curr_rot 33-34
+	static std::uint64_t pack_state(int rounds, int strat, int rot, const std::uint64_t sub[3]) {
+		return sub[0] | sub[1] << 19 | sub[2] << 24 | (std::uint64_t)rounds << 26 | (std::uint64_t)strat << 31 | (std::uint64_t)rot << 33;
+	}
+
+	static void unpack_sub_states(std::uint64_t state, std::uint64_t sub[3]) {
+		sub[0] = state & ((1 << 19) - 1);
+		sub[1] = state >> 19 & 31;
+		sub[2] = state >> 24 & 3;
+	}
+
+	// Random engine & distribution to randomly generate a strategy, rotation and number of rounds
+	std::mt19937 engine;
+	std::uniform_int_distribution<int> distribution;
+
+	// same strategy repertoire as Meta_Player_Naive
+	Frequency teller_freq{};
+	Anti_Rotation teller_anti_rot{};
+	Rotation teller_rot{ 0 };
+	Random teller_rand{};
+	Fixed teller_fix{ 'R' };
+	std::vector<Player*> strategies{ &teller_freq, &teller_anti_rot, &teller_rot, &teller_fix };
+
+	// curr_rounds is number of rounds the current basic strategy will be played for
+	int curr_rounds{};
+
+	// curr_strat is index of current basic strategy in strategies vector
+	int curr_strat{};
+
+	// curr_rot is rotation applied to current basic strategy
+	int curr_rot{};
+
+	bool verbose{};
+
+	// initial: {curr_rounds, curr_strat, curr_rot} before the first round (constructor arguments)
+	int initial[3]{};
+
+	std::string name{ "Random Strategy Meta Player" };
+};
+
+
+//// Game definition
+
+// Game_Result: outcome of a played Game as stored by the result cache (see RPS_Cache.h); histories are only set if has_histories is true
+struct Game_Result {
+	long long num_rounds{};
+	long long score[3]{ 0, 0, 0 }; // score{draws, wins p1, wins p2}
+	bool has_histories{};
+	vector move_history_p1{};
+	vector move_history_p2{};
+	vector win_history{};
+};
+
+// Round_Stats: statistics of a sequence of round outcomes (0 draw, 1 p1 win, 2 p2 win) updated round by round in constant memory
+// (counts, longest streaks, rates of the last window rounds, mean and variance of p1 wins - p2 wins per round); no histories needed.
+// Stats of consecutive parts of a sequence (e.g. shards played in parallel) can be merged into the stats of the whole sequence
+// Round_Stats_Record: Round_Stats as trivially copyable record (e.g. in shared memory between processes, see RPS_Workers.h); holds
+// windows of up to max_window rounds
+struct Round_Stats_Record {
+	static constexpr std::size_t max_window{ 256 };
+	std::uint64_t rounds{};
+	std::uint64_t score[3]{};
+	std::uint64_t longest[3]{};
+	std::uint64_t first_run{}, last_run{};
+	short first_outcome{}, last_outcome{};
+	std::uint32_t window{}, window_rounds{};
+	std::uint8_t window_outcomes[max_window]{}; // last window_rounds outcomes in order
+};
+
+struct Round_Stats {
+
+	Round_Stats(std::size_t window = 100) : recent(std::max(window, (std::size_t)1)) {}
+
+	// Round_Stats from a record written by pack()
+	Round_Stats(const Round_Stats_Record& record) : recent(std::max((std::size_t)record.window, (std::size_t)1)) {
+		rounds = record.rounds;
+		for (int k{}; k < 3; k += 1) {
+			score[k] = record.score[k];
+			longest[k] = record.longest[k];
+		}
+		first_run = record.first_run;
+		last_run = record.last_run;
+		first_outcome = record.first_outcome;
+		last_outcome = record.last_outcome;
+		std::size_t n = std::min({ (std::size_t)record.window_rounds, recent.size(), Round_Stats_Record::max_window });
+		for (std::size_t i{}; i < n; i += 1) {
+			recent[i] = record.window_outcomes[i];
+			window_score[recent[i]] += 1;
+		}
+		next = (n == recent.size() ? 0 : n);
+	}
+
+	void add(short outcome) {
+		if (rounds == 0) first_outcome = outcome;
+		if (rounds == first_run and outcome == first_outcome) first_run += 1;
+		if (rounds != 0 and outcome == last_outcome) last_run += 1;
+		else {
+			last_outcome = outcome;
+			last_run = 1;
+		}
+		if (last_run > longest[outcome]) longest[outcome] = last_run;
+
+		if (rounds >= recent.size()) window_score[recent[next]] -= 1;
+		recent[next] = (std::uint8_t)outcome;
+		window_score[outcome] += 1;
+		next = (next + 1 == recent.size() ? 0 : next + 1);
+
+		score[outcome] += 1;
+		rounds += 1;
+	}
+
+	// merge() appends the stats of the rounds that followed this sequence (same window size); stats of independent games are merged
+	// as if they had been played one after the other. Throws std::invalid_argument if window sizes differ
+	void merge(const Round_Stats& later) {
+		if (later.recent.size() != recent.size()) throw std::invalid_argument{ "Round_Stats with different window sizes can't be merged" };
+		if (later.rounds == 0) return;
+		if (rounds == 0) {
+			*this = later;
+			return;
+		}
+
+		// streaks continue across the border
+		for (int k{}; k < 3; k += 1) longest[k] = std::max(longest[k], later.longest[k]);
+		if (last_outcome == later.first_outcome) longest[last_outcome] = std::max(longest[last_outcome], last_run + later.first_run);
+		if (first_run == rounds and first_outcome == later.first_outcome) first_run += later.first_run;
+		if (later.last_run == later.rounds and later.last_outcome == last_outcome) last_run += later.rounds;
+		else {
+			last_outcome = later.last_outcome;
+			last_run = later.last_run;
+		}
+
+		// window: last outcomes of this sequence followed by the last outcomes of later
+		std::vector<std::uint8_t> window_outcomes{};
+		append_window(window_outcomes);
+		later.append_window(window_outcomes);
+		std::size_t keep = std::min(window_outcomes.size(), recent.size());
+		for (int k{}; k < 3; k += 1) window_score[k] = 0;
+		for (std::size_t i{}; i < keep; i += 1) {
+			recent[i] = window_outcomes[window_outcomes.size() - keep + i];
+			window_score[recent[i]] += 1;
+		}
+		next = (keep == recent.size() ? 0 : keep);
+
+		for (int k{}; k < 3; k += 1) score[k] += later.score[k];
+		rounds += later.rounds;
+	}
+
+	// pack() writes the stats to record; throws std::invalid_argument if the window is larger than Round_Stats_Record::max_window
+	void pack(Round_Stats_Record& record) const {
+		if (recent.size() > Round_Stats_Record::max_window) throw std::invalid_argument{ "Round_Stats window too large for Round_Stats_Record" };
+		record.rounds = rounds;
+		for (int k{}; k < 3; k += 1) {
+			record.score[k] = score[k];
+			record.longest[k] = longest[k];
+		}
+		record.first_run = first_run;
+		record.last_run = last_run;
+		record.first_outcome = first_outcome;
+		record.last_outcome = last_outcome;
+		record.window = (std::uint32_t)recent.size();
+		std::vector<std::uint8_t> window_outcomes{};
+		append_window(window_outcomes);
+		record.window_rounds = (std::uint32_t)window_outcomes.size();
+		std::copy(window_outcomes.begin(), window_outcomes.end(), record.window_outcomes);
+	}
+
+	// swapped() returns the stats seen from Player 2 (p1 and p2 wins exchanged), e.g. to add up results per strategy over both sides
+	Round_Stats swapped() const {
+		constexpr short other[3]{ 0, 2, 1 };
+		Round_Stats result{ *this };
+		std::swap(result.score[1], result.score[2]);
+		std::swap(result.longest[1], result.longest[2]);
+		std::swap(result.window_score[1], result.window_score[2]);
+		result.first_outcome = other[first_outcome];
+		result.last_outcome = other[last_outcome];
+		for (std::uint8_t& outcome : result.recent) outcome = (std::uint8_t)other[outcome];
+		return result;
+	}
+
+	// repeated() returns the stats of this sequence played times times in a row (O(window * log(times)), e.g. for fast-forwarded cycles)
+	Round_Stats repeated(std::uint64_t times) const {
+		Round_Stats result{ recent.size() }, power{ *this };
+		while (times) {
+			if (times & 1) result.merge(power);
+			times >>= 1;
+			if (times) power.merge(Round_Stats{ power });
+		}
+		return result;
+	}
+
+	std::uint64_t get_rounds() const {
+		return rounds;
+	}
+
+	// get_score(): number of rounds with outcome (0 draws, 1 p1 wins, 2 p2 wins)
+	std::uint64_t get_score(short outcome) const {
+		return score[outcome];
+	}
+
+	double rate(short outcome) const {
+		return (rounds ? (double)score[outcome] / (double)rounds : 0);
+	}
+
+	// longest_streak(): most consecutive rounds with outcome (1: p1 winning streak = p2 losing streak)
+	std::uint64_t longest_streak(short outcome) const {
+		return longest[outcome];
+	}
+
+	// current_streak(): consecutive rounds with outcome at the end of the sequence
+	std::uint64_t current_streak(short outcome) const {
+		return (rounds and last_outcome == outcome ? last_run : 0);
+	}
+
+	// window_rate(): rate of outcome in the last get_window_rounds() rounds
+	double window_rate(short outcome) const {
+		std::size_t n = get_window_rounds();
+		return (n ? (double)window_score[outcome] / (double)n : 0);
+	}
+
+	std::size_t get_window_rounds() const {
+		return (std::size_t)std::min(rounds, (std::uint64_t)recent.size());
+	}
+
+	std::size_t get_window() const {
+		return recent.size();
+	}
+
+	// mean() and variance() of the per round result p1 wins - p2 wins (+1, 0 or -1); the result only takes three values, so both follow
+	// exactly from the counts (same result as Welford's running update, without a division per round and exactly mergeable)
+	double mean() const {
+		return (rounds ? ((double)score[1] - (double)score[2]) / (double)rounds : 0);
+	}
+
+	// sample variance (0 for less than two rounds)
+	double variance() const {
+		if (rounds < 2) return 0;
+		double n = (double)rounds, m = mean();
+		return std::max(((double)(score[1] + score[2]) - n * m * m) / (n - 1), 0.0);
+	}
+
+private:
+	// append_window() appends the last get_window_rounds() outcomes in order
+	void append_window(std::vector<std::uint8_t>& outcomes) const {
+		std::size_t n = get_window_rounds();
+		std::size_t start = (next + recent.size() - n) % recent.size();
+		for (std::size_t i{}; i < n; i += 1) outcomes.push_back(recent[(start + i) % recent.size()]);
+	}
+
+	std::uint64_t rounds{};
+	std::uint64_t score[3]{ 0, 0, 0 }; // {draws, p1 wins, p2 wins}
+
+	// streaks: longest run of every outcome, run at the start and run at the end of the sequence (for merging)
+	std::uint64_t longest[3]{ 0, 0, 0 };
+	std::uint64_t first_run{}, last_run{};
+	short first_outcome{}, last_outcome{};
+
+	// last window outcomes as ring buffer (next: oldest entry once full)
+	std::vector<std::uint8_t> recent{};
+	std::size_t next{};
+	std::uint64_t window_score[3]{ 0, 0, 0 };
+};
+
+// Game_Observer: gets every round played by Game::play() (e.g. plot recorder in RPS_Plot.h); register with Game::add_observer()
+// rounds skipped by cycle detection or restored from the result cache are not observed
+template<int K>
+struct Cyclic_Game_Observer {
+	// outcome: 0 draw, 1 p1 win, 2 p2 win (same as win_history)
+	virtual void on_round(long long round, const Cyclic_Move<K> m1, const Cyclic_Move<K> m2, short outcome) = 0;
+
+	virtual ~Cyclic_Game_Observer() = default;
+};
+
+using Game_Observer = Cyclic_Game_Observer<3>;
+
+// Game_Phase: parts of a round measured by a Game_Profiler (Player 1 / Player 2 get_move(), evaluation and cycle detection, console output and observers)
+enum class Game_Phase { move_p1, move_p2, evaluate, output };
+
+// Game_Profiler: gets begin and end of every phase of every sampled round (e.g. hardware counters in RPS_Perf.h); register with Game::set_profiler()
+// a phase may be entered more than once per round
+struct Game_Profiler {
+	// sample_round() is called before every round; phases of the round are only reported if it returns true (unsampled rounds cost nothing else)
+	virtual bool sample_round() {
+		return true;
+	}
+
+	virtual void begin_phase(Game_Phase phase) = 0;
+	virtual void end_phase(Game_Phase phase) = 0;
+
+	virtual ~Game_Profiler() = default;
+};
+
+template<int K>
+struct Cyclic_Game {
+
+	// Moves, Players and observers of this game
+	using Move = Cyclic_Move<K>;
+	using Player = Cyclic_Player<K>;
+	using History_Summary = Cyclic_History_Summary<K>;
+	using Game_Observer = Cyclic_Game_Observer<K>;
+
+	// Initialize a Game with Players (always 2) and number of rounds to be played
+	Cyclic_Game(Player& p1, Player& p2, long long num_rounds, int sleep = 0) : p1{ p1 }, p2{ p2 }, num_rounds{ num_rounds }, sleep{ sleep } {};
+
+	~Cyclic_Game() {
+		delete[] game_history;
+	}
+
+	// Game::play() calls Players::get_move(), pushes back returned moves to respective move history array, and calls game::evaluate_game_round() for given number of rounds;
+	// calls Game::evaluate_game() after all rounds have been played
+	// (Game::begin_play(), Game::next_move() and Game::play_round() are the single steps, so other game loops (e.g. the coroutine game loop in
+	// RPS_Scheduler.h) play exactly like Game::play())
+	void play(bool verbose = true, bool is_1_v_1 = false) {
+		begin_play();
+		for (long long i{}; i < num_rounds; i += 1) {
+
+			Move next_move_p1 = next_move(0);
+			Move next_move_p2 = next_move(1);
+
+			bool finished = play_round(i, next_move_p1, next_move_p2, verbose);
+			if (sleep) {
+				std::this_thread::sleep_for(sleep_ms);
+			}
+			if (finished) break;
+		}
+		evaluate_game(verbose);
+	}
+
+	// Game::begin_play() resets per play state (win history of previous play, cycle detection) and decides whether full histories are kept
+	void begin_play() {
+		win_history = {}; // set win_history to empty array (in case Game::play() is called multiple times; we only care for current win_history, not for previous Games)
+		skipped_rounds = 0;
+		for (long long& element : skipped_score) element = 0;
+		stats = Round_Stats{};
+		seen_states.clear();
+		overruns[0] = 0;
+		overruns[1] = 0;
+
+		// bounded histories: only the most recent moves both Players need (at least the last one, it's printed) plus move counts
+		History_Requirement need_p1 = p1.history_requirement(), need_p2 = p2.history_requirement();
+		if (keep_histories or detect_cycles or need_p1.full or need_p2.full) history_window = 0;
+		else {
+			history_window = std::max({ need_p1.recent, need_p2.recent, (std::size_t)1 });
+			trim_histories();
+		}
+	}
+
+	// Game::next_move() asks Player 1 (player = 0) or Player 2 (player = 1) for its next move
+	Move next_move(int player) {
+		if (player == 0) profile_round = (profiler and profiler->sample_round());
+		if (profile_round) return profiled_move(player);
+		return ask(player);
+	}
+
+	// Game::play_round() records and evaluates round i; returns true if the remaining rounds have been fast-forwarded (see Game::fast_forward())
+	bool play_round(long long i, const Move next_move_p1, const Move next_move_p2, bool verbose = false) {
+		if (profile_round) profiler->begin_phase(Game_Phase::evaluate);
+		move_history_p1.push_back(next_move_p1.index);
+		move_history_p2.push_back(next_move_p2.index);
+		move_counts[0][next_move_p1.index] += 1;
+		move_counts[1][next_move_p2.index] += 1;
+		stored_rounds += 1;
+		if (history_window and move_history_p1.size() >= history_window + std::max(history_window, history_slack)) trim_histories();
+		short outcome = evaluate_game_round(next_move_p1, next_move_p2);
+		if (profile_round) profiler->end_phase(Game_Phase::evaluate);
+
+		if (profile_round) profiler->begin_phase(Game_Phase::output);
+		if (verbose) {
+			std::cout << "\n----------------\n\nRound " << i + 1 << ": \n\n";
+			print_last_move(); // if verbose = true; prints result of current round to console
+			print_round_winner(outcome);
+			std::cout << "\n----------------\n";
+		}
+		for (Game_Observer* observer : observers) observer->on_round(i, next_move_p1, next_move_p2, outcome);
+		if (profile_round) profiler->end_phase(Game_Phase::output);
+
+		if (!detect_cycles or move_budget.count()) return false;
+		if (profile_round) profiler->begin_phase(Game_Phase::evaluate);
+		bool finished = fast_forward(i);
+		if (profile_round) profiler->end_phase(Game_Phase::evaluate);
+		return finished;
+	}
+
+	// Game::fast_forward() is called after round i if cycle detection is enabled: if both Players are in a joint state they have already been in
+	// after an earlier round, all remaining rounds repeat the rounds in between; their outcomes are then added to stats arithmetically
+	// (only the rounds played so far are stored in the histories). Returns true if the remaining rounds have been skipped
+	bool fast_forward(long long i) {
+		std::uint64_t fingerprint_p1{}, fingerprint_p2{};
+		History_Summary summary_p1 = summary_of(0), summary_p2 = summary_of(1);
+		if (!p1.get_fingerprint(move_history_p2, move_history_p1, summary_p1, fingerprint_p1) or !p2.get_fingerprint(move_history_p1, move_history_p2, summary_p2, fingerprint_p2)) {
+			seen_states.clear(); // rounds played in non-deterministic state can't be part of a cycle
+			return false;
+		}
+
+		auto [state, inserted] = seen_states.try_emplace({ fingerprint_p1, fingerprint_p2 }, i);
+		if (inserted) {
+			if (seen_states.size() > cycle_window) seen_states.clear(); // bound memory for matchups with very long (or no) cycles
+			return false;
+		}
+
+		std::size_t period = (std::size_t)(i - state->second);
+		if (!p1.confirm_period(move_history_p2, move_history_p1, summary_p1, period) or !p2.confirm_period(move_history_p1, move_history_p2, summary_p2, period)) {
+			state->second = i; // try again once the state repeats the next time
+			return false;
+		}
+
+		// outcomes of one period are the last period entries of win_history; remaining rounds consist of full periods plus a partial period
+		long long remaining = num_rounds - (i + 1);
+		long long full_periods = remaining / (long long)period;
+		std::size_t partial = (std::size_t)(remaining % (long long)period);
+		std::size_t period_start = win_history.size() - period;
+		Round_Stats period_stats{ stats.get_window() }, partial_stats{ stats.get_window() };
+		for (std::size_t k{}; k < period; k += 1) {
+			period_stats.add(win_history[period_start + k]);
+			if (k < partial) partial_stats.add(win_history[period_start + k]);
+		}
+		stats.merge(period_stats.repeated((std::uint64_t)full_periods));
+		stats.merge(partial_stats);
+		skipped_rounds = remaining;
+
+		std::cout << "\nGame state after round " << i + 1 << " repeats state after round " << state->second + 1 << " (cycle of " << period << " rounds)";
+		std::cout << "\nFast-forwarding remaining " << remaining << " rounds\n";
+		return true;
+	}
+
+	// print result of current round to console
+	void print_last_move() {
+		std::cout << "Player 1 (" << p1.get_name() << ") played " << Cyclic_Rules<K>::shape_name(move_history_p1.back()) << "\n";
+		std::cout << "Player 2 (" << p2.get_name() << ") played " << Cyclic_Rules<K>::shape_name(move_history_p2.back()) << "\n\n";
+	}
+
+	// Game::evaluate_game_round() determines which Player wins current round and saves result in win_history array (only if full histories
+	// are kept; the score is always counted); returns the outcome
+	short evaluate_game_round(const Move m1, const Move m2, bool verbose = false) {
+
+		short index_distance = evaluate_round(m1, m2); // get index distance with respect to m1 (0 draw, 1 p1 win, 2 p2 win, same as win_history)
+		if (!history_window) win_history.push_back(index_distance);
+		stats.add(index_distance);
+		if (verbose) print_round_winner(index_distance);
+		return index_distance;
+	}
+
+	// print winner of a round (outcome as in win_history) to console
+	void print_round_winner(short outcome) {
+		switch (outcome) {
+		case 0: // draw
+			std::cout << "Draw!\n\n" << std::endl;
+			break;
+		case 1: // p1 win
+			std::cout << p1.get_name() << " wins this round!\n\n" << std::endl;
+			break;
+		case 2: // p2 win
+			std::cout << p2.get_name() << " wins this round!\n\n" << std::endl;
+			break;
+		}
+	}
+
+	// After all rounds have been played, Game::evaluate_game() will determine the winner based on number of won rounds of each player in win_history array
+	void evaluate_game(bool verbose = false) {
+		// score{draws, p1_wins, p2_wins}
+
+		long long score[3]{}; // score{draws, wins p1, wins p2}
+		count_score(score);
+		if (score[1] > score[2]) { // p1 wins game
+			game_history[1] += 1;
+			if (verbose) {
+				std::cout << "\n\n" << p1.get_name() << " wins this game.\n";
+			}
+		}
+		else if (score[1] < score[2]) { // p2 wins game
+			game_history[2] += 1;
+			if (verbose) {
+				std::cout << "\n\n" << p2.get_name() << " wins this game.\n";
+			}
+		}
+		else {
+			game_history[0] += 1;
+			if (verbose) { // draw
+				std::cout << "\n\nThis game resulted in a draw!\n";
+			}
+		}
+
+		// Calculate and put out game stats: wl is win-loss ratio; wr is win rate
+		double wl1{}, wl2{}, wr1{}, wr2{};
+		constexpr double inf = std::numeric_limits<double>::infinity();
+
+		if (score[2] == 0) wl1 = inf;
+		else wl1 = (double)score[1] / (double)score[2];
+
+		if (score[1] == 0) wl2 = inf;
+		else wl2 = (double)score[2] / (double)score[1];
+
+		if (num_rounds == 0) wr1 = 0;
+		else wr1 = (double)score[1] / (double)num_rounds;
+
+		if (num_rounds == 0) wr2 = 0;
+		else wr2 = (double)score[2] / (double)num_rounds;
+
+		std::cout << "\n\n----------------\n\nGame Stats\n\n\n";
+		std::cout << "Player 1 (" << p1.get_name() << ") wins " << score[1] << "/" << num_rounds << " games\n";
+		std::cout << "Player 2 (" << p2.get_name() << ") wins " << score[2] << "/" << num_rounds << " games\n\n";
+		std::cout << "Win-Loss Ratio " << p1.get_name() << " : " << wl1 << "\n";
+		std::cout << "Win-Loss Ratio " << p2.get_name() << " : " << wl2 << "\n\n";
+		std::cout << "Win Rate " << p1.get_name() << " : " << wr1*100 << "%" << "\n";
+		std::cout << "Win Rate " << p2.get_name() << " : " << wr2*100 << "%" << "\n\n";
+		std::cout << "With " << score[0] << " Draws" << "\n\n";
+		if (stats.get_rounds() and (long long)stats.get_rounds() == score[0] + score[1] + score[2]) { // not for results restored without histories
+			std::cout << "Longest Winning Streak " << p1.get_name() << " : " << stats.longest_streak(1) << "\n";
+			std::cout << "Longest Winning Streak " << p2.get_name() << " : " << stats.longest_streak(2) << "\n";
+			std::cout << "Win Rate " << p1.get_name() << " (last " << stats.get_window_rounds() << " rounds) : " << stats.window_rate(1) * 100 << "%\n";
+			std::cout << "Win Rate " << p2.get_name() << " (last " << stats.get_window_rounds() << " rounds) : " << stats.window_rate(2) * 100 << "%\n";
+			std::cout << "Standard Deviation per Round (" << p1.get_name() << " wins - " << p2.get_name() << " wins) : " << std::sqrt(stats.variance()) << "\n\n";
+		}
+		if (move_budget.count()) {
+			std::cout << "Move Budget Overruns " << p1.get_name() << " : " << overruns[0] << " (budget " << move_budget.count() << " us per move)\n";
+			std::cout << "Move Budget Overruns " << p2.get_name() << " : " << overruns[1] << " (budget " << move_budget.count() << " us per move)\n\n";
+		}
+		if (skipped_rounds) std::cout << skipped_rounds << " of " << num_rounds << " rounds were not played one by one (cycle detection or result cache)\n\n";
+		std::cout << "----------------" << std::endl;
+	}
+
+	// Save current game state to .csv-file for Analysis 
+	bool save(std::string path, std::string id_tag = "") {
+		try {
+			if (history_window) throw std::runtime_error{ "Only the most recent moves have been kept (see Game::set_keep_histories())." };
+			path = (std::filesystem::path{ path } / (id_tag + ".csv")).string();
+			std::ofstream ofs(path, std::ofstream::out);
+			if (!ofs.is_open()) throw std::runtime_error{ "This file path is invalid, unable to open file." };
+
+			// only rounds that have actually been played are stored (rounds skipped by cycle detection aren't)
+			std::size_t stored_rounds = win_history.size();
+
+			ofs << "Move History P1,Move History P2,Win History,Game History" << "\n"; // Header
+			for (std::size_t i{}; i < stored_rounds + 2; i += 1) {
+				if (i < stored_rounds) {
+					ofs << move_history_p1[i] << "," << move_history_p2[i] << "," << win_history[i];
+				} 
+
+				// game_history has only 3 entries
+				if (i < 3) {
+					if (stored_rounds <= i) ofs << ",,";
+					ofs << "," << game_history[i];
+				}
+				ofs << "\n";
+			}
+			ofs.close();
+		}
+
+		catch (std::exception& e) {
+			std::cout << "Error saving game data: " << e.what() << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	// Game::get_config() writes canonical configuration of this Game (engine version, rounds, both Players, number of shapes unless it is
+	// Rock-Paper-Scissors) used as result cache key; returns false if the result isn't reproducible (non-deterministic Players or Players
+	// continuing a previous game)
+	bool get_config(std::string& config) {
+		if (!move_history_p1.empty() or move_budget.count()) return false; // moves depend on timing with a move budget
+		std::string config_p1{}, config_p2{};
+		if (!p1.get_config(config_p1) or !p2.get_config(config_p2)) return false;
+		config = "engine=" + std::to_string(engine_version) + (K == 3 ? "" : ";shapes=" + std::to_string(K));
+		config += ";rounds=" + std::to_string(num_rounds) + ";p1=" + config_p1 + ";p2=" + config_p2;
+		return true;
+	}
+
+	// Game::get_result() returns outcome of last Game::play(); histories are only complete if no rounds were fast-forwarded
+	Game_Result get_result() {
+		Game_Result result{ num_rounds };
+		count_score(result.score);
+		result.has_histories = (skipped_rounds == 0 and !history_window);
+		if (result.has_histories) {
+			result.move_history_p1 = move_history_p1;
+			result.move_history_p2 = move_history_p2;
+			result.win_history = win_history;
+		}
+		return result;
+	}
+
+	// Game::replay() restores a stored result instead of playing (e.g. from result cache) and evaluates it like Game::play() would;
+	// rounds without stored histories are counted like fast-forwarded rounds
+	void replay(const Game_Result& result, bool verbose = true) {
+		move_history_p1 = result.move_history_p1;
+		move_history_p2 = result.move_history_p2;
+		win_history = result.win_history;
+		count_moves();
+		stats = Round_Stats{};
+		for (int k{}; k < 3; k += 1) skipped_score[k] = result.score[k];
+		for (short element : win_history) {
+			skipped_score[element] -= 1;
+			stats.add(element);
+		}
+		skipped_rounds = num_rounds - (long long)win_history.size();
+		evaluate_game(verbose);
+	}
+
+	// reset internal state
+	void reset() {
+		move_history_p1 = {};
+		move_history_p2 = {};
+		win_history = {};
+		count_moves();
+		game_history[0] = 0;
+		game_history[1] = 0;
+		game_history[2] = 0;
+	}
+
+	// setter method to change number of game rounds with same Players
+	void set_rounds(long long rounds) {
+		num_rounds = rounds;
+	}
+
+	long long get_rounds() {
+		return num_rounds;
+	}
+
+	// sleep duration between rounds in ms
+	int get_delay() {
+		return sleep;
+	}
+
+	// Game::player() returns Player 1 (player = 0) or Player 2 (player = 1)
+	Player& player(int player) {
+		return (player == 0 ? p1 : p2);
+	}
+
+	// observers are notified after every played round; Game doesn't take ownership
+	void add_observer(Game_Observer* observer) {
+		observers.push_back(observer);
+	}
+
+	// enable/disable fast-forwarding of deterministic matchups once the game repeats itself (see Game::fast_forward())
+	void set_cycle_detection(bool enable) {
+		detect_cycles = enable;
+	}
+
+	// profiler gets the phases of every played round (nullptr: no profiling); Game doesn't take ownership
+	void set_profiler(Game_Profiler* game_profiler) {
+		profiler = game_profiler;
+		profile_round = false;
+	}
+
+	// keep = false: Game doesn't need full histories (no saving, no Game_Result histories), so if both Players declare bounded history
+	// requirements (see Player::history_requirement()) only the most recent moves are kept and memory doesn't grow with the rounds.
+	// Takes effect with the next Game::play(); cycle detection always needs full histories. Default: full histories are kept
+	void set_keep_histories(bool keep) {
+		keep_histories = keep;
+	}
+
+	// get_stats() returns streaming stats of the rounds of the last Game::play() (including fast-forwarded rounds)
+	const Round_Stats& get_stats() {
+		return stats;
+	}
+
+	// has_full_histories() returns false if the last Game::play() only kept bounded histories
+	bool has_full_histories() {
+		return history_window == 0;
+	}
+
+	// set_move_budget() gives every get_move() call a time budget (0: no budget, default). Players get the deadline (see
+	// Player::get_move_until()); if a Player still takes longer, its move is replaced by a random move (like Meta Player's random
+	// fallback) and counted as overrun (see get_overruns()); the first overrun of a Player in a Game::play() is reported on the console.
+	// Interactive Players (see Player::interactive()) have no budget. Moves then depend on timing, so Games with a budget have no config
+	// (no result cache) and aren't fast-forwarded
+	void set_move_budget(std::chrono::microseconds budget) {
+		move_budget = std::max(budget, std::chrono::microseconds{ 0 });
+		if (move_budget.count()) fallback_engine.seed((std::uint_fast32_t)std::chrono::steady_clock::now().time_since_epoch().count());
+	}
+
+	// get_overruns() returns number of moves of Player 1 (player = 0) or Player 2 (player = 1) replaced in the last Game::play()
+	long long get_overruns(int player) {
+		return overruns[player];
+	}
+
+private:
+	// ask() gets next move of Player 1 (player = 0) or Player 2 (player = 1), within the move budget if there is one
+	Move ask(int player) {
+		if (move_budget.count() and !(player == 0 ? p1 : p2).interactive()) return ask_within_budget(player);
+		return ask_player(player);
+	}
+
+	// ask_player() calls get_move() of the Player, or get_move_bounded() if only bounded histories are kept
+	Move ask_player(int player) {
+		if (!history_window) {
+			if (player == 0) return p1.get_move(move_history_p2, move_history_p1);
+			return p2.get_move(move_history_p1, move_history_p2);
+		}
+		History_Summary summary = summary_of(player);
+		if (player == 0) return p1.get_move_bounded(move_history_p2, move_history_p1, summary);
+		return p2.get_move_bounded(move_history_p1, move_history_p2, summary);
+	}
+
+	// summary_of() returns the move counts of the full histories from the point of view of player (0 or 1)
+	History_Summary summary_of(int player) {
+		History_Summary summary{ stored_rounds };
+		for (int k{}; k < K; k += 1) {
+			summary.other_counts[k] = move_counts[1 - player][k];
+			summary.self_counts[k] = move_counts[player][k];
+		}
+		return summary;
+	}
+
+	// ask_within_budget() is ask() with a deadline; a move that arrives after it is replaced by the fallback move
+	Move ask_within_budget(int player) {
+		auto deadline = std::chrono::steady_clock::now() + move_budget;
+		Move move{};
+		if (history_window) {
+			History_Summary summary = summary_of(player);
+			if (player == 0) move = p1.get_move_bounded_until(move_history_p2, move_history_p1, summary, deadline);
+			else move = p2.get_move_bounded_until(move_history_p1, move_history_p2, summary, deadline);
+		}
+		else if (player == 0) move = p1.get_move_until(move_history_p2, move_history_p1, deadline);
+		else move = p2.get_move_until(move_history_p1, move_history_p2, deadline);
+		auto now = std::chrono::steady_clock::now();
+		if (now <= deadline) return move;
+		overruns[player] += 1;
+		Move fallback{ (short)(fallback_engine() % K) };
+		if (overruns[player] == 1) {
+			std::cout << "\n" << (player == 0 ? p1 : p2).get_name() << " exceeded the move budget of " << move_budget.count() << " us (took ";
+			std::cout << std::chrono::duration_cast<std::chrono::microseconds>(now - deadline + move_budget).count() << " us); its late moves are replaced ";
+			std::cout << "by random moves (this one by " << fallback.shape() << ", see Move Budget Overruns in Game Stats)\n";
+		}
+		return fallback;
+	}
+
+	// profiled_move() is Game::next_move() wrapped in the get_move() phase of the player
+	Move profiled_move(int player) {
+		Game_Phase phase = (player == 0 ? Game_Phase::move_p1 : Game_Phase::move_p2);
+		profiler->begin_phase(phase);
+		Move move = ask(player);
+		profiler->end_phase(phase);
+		return move;
+	}
+
+	// count_score() adds up outcomes of played, fast-forwarded and restored rounds: score{draws, wins p1, wins p2}
+	void count_score(long long score[3]) {
+		for (int k{}; k < 3; k += 1) score[k] = skipped_score[k] + (long long)stats.get_score((short)k);
+	}
+
+	// count_moves() recounts move_counts and stored_rounds from the move histories (after they have been replaced)
+	void count_moves() {
+		for (int k{}; k < K; k += 1) {
+			move_counts[0][k] = 0;
+			move_counts[1][k] = 0;
+		}
+		for (short element : move_history_p1) move_counts[0][element] += 1;
+		for (short element : move_history_p2) move_counts[1][element] += 1;
+		stored_rounds = move_history_p1.size();
+	}
+
+	// trim_histories() drops all but the last history_window moves; called every history_slack rounds (at least every history_window rounds),
+	// so the histories stay contiguous vectors at constant amortized cost per round
+	void trim_histories() {
+		if (move_history_p1.size() <= history_window) return;
+		move_history_p1.erase(move_history_p1.begin(), move_history_p1.end() - (std::ptrdiff_t)history_window);
+		move_history_p2.erase(move_history_p2.begin(), move_history_p2.end() - (std::ptrdiff_t)history_window);
+	}
+
+	// game_history is only important when playing multiple games (calling Game::play() repeatedly): score{draws, player1 wins, player2 wins}
+	int *game_history = new int[3]{ 0, 0, 0 };
+
+	// Game Players (can be any Player derived class); Player base class serves as common interface
+	Player& p1;
+	Player& p2;
+
+	// number of game rounds
+	long long num_rounds;
+
+	std::vector<Game_Observer*> observers{};
+	Game_Profiler* profiler{};
+	bool profile_round{}; // profiler samples the current round
+
+	// cycle detection: number of rounds skipped by Game::fast_forward() (not stored in win_history, but in stats);
+	// skipped_score: outcomes of rounds restored by Game::replay() without histories (not in stats)
+	bool detect_cycles{};
+	long long skipped_rounds{};
+	long long skipped_score[3]{ 0, 0, 0 };
+	std::map<std::pair<std::uint64_t, std::uint64_t>, long long> seen_states{}; // joint Player fingerprint -> round after which it occured
+	static constexpr std::size_t cycle_window{ 1 << 16 }; // maximum number of joint states remembered
+
+	// move histories for both players
+	vector move_history_p1{};
+	vector move_history_p2{};
+
+	// win history: 0:draw  1:p1 win  2:p2 win
+	vector win_history{};
+
+	// outcomes of the rounds played (and fast-forwarded) in the current Game::play(); doesn't need win_history, which isn't kept with bounded histories
+	Round_Stats stats{};
+
+	// bounded histories (see Game::set_keep_histories()): history_window is the number of moves Players get (0: full histories are kept);
+	// move_counts{p1, p2} and stored_rounds describe the full histories
+	bool keep_histories{ true };
+	std::size_t history_window{};
+	std::uint64_t move_counts[2][K]{};
+	std::uint64_t stored_rounds{};
+	static constexpr std::size_t history_slack{ 1 << 12 };
+
+	// move budget (see Game::set_move_budget()): overruns{p1, p2} in the current Game::play(); fallback_engine draws the random moves
+	// replacing late ones (small engine, only seeded once a budget is set, so Games without budget don't touch init_engine)
+	std::chrono::microseconds move_budget{};
+	long long overruns[2]{ 0, 0 };
+	std::minstd_rand fallback_engine{};
+
+	// sleep duration between rounds in ms
+	int sleep{};
+	std::chrono::milliseconds sleep_ms{ sleep };
+};
+
+using Game = Cyclic_Game<3>;
\ No newline at end of file
@@ -0,0 +1,393 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <array>
+#include <memory>
+#include <cmath>
+#include <limits>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <unordered_map>
+#include <tuple>
+
+#include "RPS_Header.h"
+
+
+//// Exact matchup analysis: expected results from the joint Markov chain of both Players instead of simulated games
+
+// Both Players describe themselves as chains over their own states (see Player::markov_initial()); the joint state of a game is the pair
+// of Player states. Markov_Analyzer propagates the distribution over joint states round by round (finite horizon: expected numbers and
+// variances of draws and wins after n rounds) or explores all reachable joint states and solves for the long run (stationary rates and
+// variance per round). Cost depends on the number of joint states, not on rounds x games; Random Players are treated as ideal (every move 1/3).
+// Results are exact unless they are marked approximate (a Player's state lumped histories it tells apart, see Player::markov_exact()).
+
+// Markov_Horizon: results after a given number of rounds (order {draws, Player 1 wins, Player 2 wins} as in Game_Result::score)
+struct Markov_Horizon {
+	long long rounds{};
+	double expected[3]{};
+	double variance[3]{};
+	std::size_t max_states{}; // largest number of joint states in one round
+	bool approximate{};
+};
+
+// Markov_Stationary: long run results; variance_rate is lim Var(count after n rounds) / n, infinite if the game can settle into
+// closed classes with different rates (the count then spreads proportionally to n instead of sqrt(n))
+struct Markov_Stationary {
+	std::size_t states{}; // reachable joint states
+	std::size_t closed_classes{}; // closed communicating classes the game can end up in
+	double rate[3]{};
+	double variance_rate[3]{};
+	bool converged{};
+	bool approximate{};
+};
+
+
+struct Markov_Analyzer {
+
+	// max_states bounds the number of joint states (per round for finite horizons, in total for the stationary solution, which also
+	// stores up to 32 transitions per state on average); throws std::invalid_argument if a Player has no Markov description or if the
+	// joint chain can't stay small (see check_counted_moves())
+	Markov_Analyzer(Player& p1, Player& p2, std::size_t max_states = 1 << 20) : p1{ p1 }, p2{ p2 }, max_states{ max_states } {
+		if (!p1.markov_initial(initial.first)) throw std::invalid_argument{ p1.get_name() + " has no Markov description" };
+		if (!p2.markov_initial(initial.second)) throw std::invalid_argument{ p2.get_name() + " has no Markov description" };
+		check_counted_moves(p1, p2);
+		check_counted_moves(p2, p1);
+	}
+
+	// finite_horizon() computes exact expectations and variances of draws and wins over the first rounds of a game
+	Markov_Horizon finite_horizon(long long rounds) {
+		// Moments: probability of a joint state and the first and second moments of the win counts restricted to it
+		struct Moments {
+			double mass{};
+			double wins[2]{}; // E[W_k; state]
+			double squares[2]{}; // E[W_k^2; state]
+			double cross{}; // E[W_1 * W_2; state]
+		};
+		std::unordered_map<Joint_State, Moments, Joint_Hash> current{}, next{};
+		current[initial].mass = 1;
+
+		Markov_Horizon result{ rounds };
+		std::vector<Transition> step{};
+		for (long long r{}; r < rounds; r += 1) {
+			next.clear();
+			for (const auto& [state, m] : current) {
+				step.clear();
+				transitions(state, step);
+				for (const Transition& t : step) {
+					double x[2]{ (double)(t.outcome == 1), (double)(t.outcome == 2) };
+					Moments& n = next[t.to];
+					n.mass += t.probability * m.mass;
+					for (int k{}; k < 2; k += 1) {
+						n.wins[k] += t.probability * (m.wins[k] + x[k] * m.mass);
+						n.squares[k] += t.probability * (m.squares[k] + 2 * x[k] * m.wins[k] + x[k] * m.mass);
+					}
+					n.cross += t.probability * (m.cross + x[0] * m.wins[1] + x[1] * m.wins[0]); // a round has at most one winner
+				}
+			}
+			if (next.size() > max_states) throw std::length_error{ "More than " + std::to_string(max_states) + " joint states after round " + std::to_string(r + 1) };
+			result.max_states = std::max(result.max_states, next.size());
+			for (const auto& [state, m] : next) result.approximate = result.approximate or !exact(state);
+			current.swap(next);
+		}
+
+		double wins[2]{}, squares[2]{}, cross{};
+		for (const auto& [state, m] : current) {
+			for (int k{}; k < 2; k += 1) {
+				wins[k] += m.wins[k];
+				squares[k] += m.squares[k];
+			}
+			cross += m.cross;
+		}
+		for (int k{}; k < 2; k += 1) {
+			result.expected[1 + k] = wins[k];
+			result.variance[1 + k] = std::max(squares[k] - wins[k] * wins[k], 0.0);
+		}
+		result.expected[0] = (double)rounds - wins[0] - wins[1];
+		double covariance = cross - wins[0] * wins[1];
+		result.variance[0] = std::max(result.variance[1] + result.variance[2] + 2 * covariance, 0.0); // draws = rounds - W_1 - W_2
+		return result;
+	}
+
+	// stationary() explores all joint states reachable from the start of a game and solves for the long run rates and variances
+	// (iteratively on the lazy chain, which has the same limits but no periodicity; tolerance is the L1 change per iteration)
+	Markov_Stationary stationary(double tolerance = 1e-13, long long max_iterations = 1000000) {
+		explore();
+		std::size_t n = states.size();
+		Markov_Stationary result{ n };
+		for (const Joint_State& state : states) result.approximate = result.approximate or !exact(state);
+
+		// expected outcome of a round in every state
+		std::vector<std::array<double, 3>> reward(n, { 0, 0, 0 });
+		for (std::size_t s{}; s < n; s += 1) {
+			for (std::size_t e{ first_edge[s] }; e < first_edge[s + 1]; e += 1) reward[s][edges[e].outcome] += edges[e].probability;
+		}
+
+		// limit distribution: mass of every closed class times its stationary distribution
+		std::vector<double> mu(n, 0), step(n, 0);
+		mu[0] = 1;
+		result.converged = false;
+		for (long long it{}; it < max_iterations and !result.converged; it += 1) {
+			std::fill(step.begin(), step.end(), 0.0);
+			for (std::size_t s{}; s < n; s += 1) {
+				if (mu[s] == 0) continue;
+				for (std::size_t e{ first_edge[s] }; e < first_edge[s + 1]; e += 1) step[edges[e].to] += mu[s] * edges[e].probability;
+			}
+			double change{};
+			for (std::size_t s{}; s < n; s += 1) {
+				double lazy = (mu[s] + step[s]) / 2;
+				change += std::abs(lazy - mu[s]);
+				mu[s] = lazy;
+			}
+			result.converged = (change < tolerance);
+		}
+
+		// closed classes reached with positive probability, their mass and rates
+		std::vector<std::size_t> component = strongly_connected_components();
+		std::size_t num_components = (n ? *std::max_element(component.begin(), component.end()) + 1 : 0);
+		std::vector<bool> closed(num_components, true);
+		for (std::size_t s{}; s < n; s += 1) {
+			for (std::size_t e{ first_edge[s] }; e < first_edge[s + 1]; e += 1) {
+				if (component[edges[e].to] != component[s]) closed[component[s]] = false;
+			}
+		}
+		std::vector<double> class_mass(num_components, 0);
+		std::vector<std::array<double, 3>> class_rate(num_components, { 0, 0, 0 });
+		for (std::size_t s{}; s < n; s += 1) {
+			if (!closed[component[s]]) continue;
+			class_mass[component[s]] += mu[s];
+			for (int k{}; k < 3; k += 1) class_rate[component[s]][k] += mu[s] * reward[s][k];
+		}
+		std::vector<std::size_t> reached{};
+		for (std::size_t c{}; c < num_components; c += 1) {
+			if (!closed[c] or class_mass[c] <= tolerance) continue;
+			reached.push_back(c);
+			for (int k{}; k < 3; k += 1) {
+				result.rate[k] += class_rate[c][k];
+				class_rate[c][k] /= class_mass[c];
+			}
+		}
+		result.closed_classes = reached.size();
+
+		// variance rate per class from the solution g of the Poisson equation (I - P) g = reward - rate (iterated on the lazy chain):
+		// sigma^2 = E_pi[(outcome - rate + g(next) - g(state))^2]
+		std::vector<bool> recurrent(n, false);
+		for (std::size_t s{}; s < n; s += 1) recurrent[s] = (closed[component[s]] and class_mass[component[s]] > tolerance);
+		for (int k{}; k < 3; k += 1) {
+			bool settles_differently{};
+			for (std::size_t c : reached) settles_differently = settles_differently or std::abs(class_rate[c][k] - class_rate[reached[0]][k]) > 1e-12;
+			if (settles_differently) {
+				result.variance_rate[k] = std::numeric_limits<double>::infinity();
+				continue;
+			}
+
+			std::vector<double> g(n, 0), g_next(n, 0);
+			for (long long it{}; it < max_iterations; it += 1) {
+				double change{};
+				for (std::size_t s{}; s < n; s += 1) {
+					if (!recurrent[s]) continue;
+					double expected_next{};
+					for (std::size_t e{ first_edge[s] }; e < first_edge[s + 1]; e += 1) expected_next += edges[e].probability * g[edges[e].to];
+					g_next[s] = (reward[s][k] - class_rate[component[s]][k]) / 2 + (g[s] + expected_next) / 2;
+					change = std::max(change, std::abs(g_next[s] - g[s]));
+				}
+				g.swap(g_next);
+				if (change < tolerance) break;
+			}
+
+			double variance{};
+			for (std::size_t s{}; s < n; s += 1) {
+				if (!recurrent[s] or mu[s] == 0) continue;
+				for (std::size_t e{ first_edge[s] }; e < first_edge[s + 1]; e += 1) {
+					double d = (edges[e].outcome == k) - class_rate[component[s]][k] + g[edges[e].to] - g[s];
+					variance += mu[s] * edges[e].probability * d * d;
+				}
+			}
+			result.variance_rate[k] = variance;
+		}
+		return result;
+	}
+
+private:
+	using Joint_State = std::pair<std::uint64_t, std::uint64_t>;
+
+	struct Joint_Hash {
+		std::size_t operator()(const Joint_State& state) const {
+			std::uint64_t h = state.first * 0x9E3779B97F4A7C15ull ^ (state.second + 0x632BE59BD9B4E019ull + (state.first << 6) + (state.first >> 2));
+			return (std::size_t)(h ^ h >> 29);
+		}
+	};
+
+	struct Transition {
+		Joint_State to{};
+		double probability{};
+		std::uint8_t outcome{};
+	};
+
+	// check_counted_moves() throws std::invalid_argument if counting keeps count differences of the other Player's moves (Frequency,
+	// Meta_Player_Rand_Strat) and those moves vary at random, because the other Player draws them or reacts to moves counting draws:
+	// the differences then wander like a random walk and the joint chain grows with every round (past max_states within a few dozen
+	// rounds if a switching Meta_Player_Rand_Strat is involved)
+	static void check_counted_moves(Player& counting, Player& other) {
+		if (!counting.markov_counts_moves()) return;
+		History_Requirement needs = other.history_requirement();
+		bool reacts = (needs.recent or needs.counts or needs.full);
+		if (other.markov_random() or (reacts and counting.markov_random())) {
+			throw std::invalid_argument{ counting.get_name() + " counts the moves of " + other.get_name() + ", which vary at random; the joint chain of " + \
+				"this matchup grows with every round" };
+		}
+	}
+
+	bool exact(const Joint_State& state) {
+		return p1.markov_exact(state.first) and p2.markov_exact(state.second);
+	}
+
+	// transitions() lists every joint state after one round from state with probability and outcome (equal transitions merged)
+	void transitions(const Joint_State& state, std::vector<Transition>& out) {
+		const std::vector<Markov_Choice>& choices_p1 = choices(p1, cache_p1, state.first);
+		const std::vector<Markov_Choice>& choices_p2 = choices(p2, cache_p2, state.second);
+		std::size_t begin = out.size();
+		for (const Markov_Choice& c1 : choices_p1) {
+			for (const Markov_Choice& c2 : choices_p2) {
+				Joint_State to{ p1.markov_observe(c1.after, c1.move, c2.move), p2.markov_observe(c2.after, c2.move, c1.move) };
+				out.push_back({ to, c1.probability * c2.probability, outcome_table[c1.move][c2.move] });
+			}
+		}
+		if (out.size() - begin < 2) return;
+		auto key = [](const Transition& t) { return std::tuple{ t.to.first, t.to.second, t.outcome }; };
+		std::sort(out.begin() + begin, out.end(), [&key](const Transition& a, const Transition& b) { return key(a) < key(b); });
+		std::size_t last = begin;
+		for (std::size_t i{ begin + 1 }; i < out.size(); i += 1) {
+			if (key(out[i]) == key(out[last])) out[last].probability += out[i].probability;
+			else out[++last] = out[i];
+		}
+		out.resize(last + 1);
+	}
+
+	// choices of a Player state are cached (Players enumerate them, e.g. 252 for Meta_Player_Rand_Strat switching strategy)
+	static const std::vector<Markov_Choice>& choices(Player& player, std::unordered_map<std::uint64_t, std::vector<Markov_Choice>>& cache, std::uint64_t state) {
+		auto [it, inserted] = cache.try_emplace(state);
+		if (inserted) {
+			player.markov_choices(state, it->second);
+			if (it->second.empty()) throw std::logic_error{ player.get_name() + " has no move in Markov state " + std::to_string(state) };
+		}
+		return it->second;
+	}
+
+	// explore() numbers all joint states reachable from the start of a game (breadth first, start is state 0) and stores their
+	// transitions as compressed rows (edges of state s are edges[first_edge[s]] to edges[first_edge[s + 1] - 1])
+	void explore() {
+		if (!states.empty()) return;
+		std::unordered_map<Joint_State, std::uint32_t, Joint_Hash> index{};
+		index[initial] = 0;
+		states.push_back(initial);
+		first_edge.push_back(0);
+		std::vector<Transition> step{};
+		for (std::size_t s{}; s < states.size(); s += 1) {
+			step.clear();
+			transitions(states[s], step);
+			for (const Transition& t : step) {
+				auto [it, inserted] = index.try_emplace(t.to, (std::uint32_t)states.size());
+				if (inserted) states.push_back(t.to);
+				edges.push_back({ it->second, t.probability, t.outcome });
+			}
+			if (states.size() > max_states or edges.size() > 32 * max_states) {
+				states.clear();
+				edges.clear();
+				first_edge.clear();
+				throw std::length_error{ "Reachable joint chain has more than " + std::to_string(max_states) + " states or " + std::to_string(32 * max_states) + \
+					" transitions; use a finite horizon instead" };
+			}
+			first_edge.push_back(edges.size());
+		}
+	}
+
+	// strongly_connected_components() returns component number of every explored state (Tarjan's algorithm without recursion)
+	std::vector<std::size_t> strongly_connected_components() const {
+		const std::size_t none = std::numeric_limits<std::size_t>::max();
+		std::size_t n = states.size();
+		std::vector<std::size_t> component(n, none), order(n, none), low(n, 0), stack{};
+		std::vector<bool> on_stack(n, false);
+		std::vector<std::pair<std::size_t, std::size_t>> calls{}; // {state, next edge}
+		std::size_t counter{}, num_components{};
+
+		for (std::size_t root{}; root < n; root += 1) {
+			if (order[root] != none) continue;
+			calls.push_back({ root, first_edge[root] });
+			order[root] = low[root] = counter++;
+			stack.push_back(root);
+			on_stack[root] = true;
+			while (!calls.empty()) {
+				auto& [s, e] = calls.back();
+				if (e < first_edge[s + 1]) {
+					std::size_t to = edges[e].to;
+					e += 1;
+					if (order[to] == none) {
+						order[to] = low[to] = counter++;
+						stack.push_back(to);
+						on_stack[to] = true;
+						calls.push_back({ to, first_edge[to] });
+					}
+					else if (on_stack[to]) low[s] = std::min(low[s], order[to]);
+					continue;
+				}
+				std::size_t finished = s;
+				calls.pop_back();
+				if (!calls.empty()) low[calls.back().first] = std::min(low[calls.back().first], low[finished]);
+				if (low[finished] == order[finished]) {
+					std::size_t member{};
+					do {
+						member = stack.back();
+						stack.pop_back();
+						on_stack[member] = false;
+						component[member] = num_components;
+					} while (member != finished);
+					num_components += 1;
+				}
+			}
+		}
+		return component;
+	}
+
+	struct Edge {
+		std::uint32_t to{};
+		double probability{};
+		std::uint8_t outcome{};
+	};
+
+	Player& p1;
+	Player& p2;
+	Joint_State initial{};
+	std::size_t max_states{};
+	std::unordered_map<std::uint64_t, std::vector<Markov_Choice>> cache_p1{}, cache_p2{};
+
+	// explored chain (stationary())
+	std::vector<Joint_State> states{};
+	std::vector<std::size_t> first_edge{};
+	std::vector<Edge> edges{};
+};
+
+
+// make_markov_player() creates a Player with Markov description from its configuration string (Fixed(R), Rotation(1), Frequency,
+// Anti_Rotation, Random, Meta_Player_Rand_Strat or Meta_Player_Rand_Strat(rounds,strategy,rotation)); throws std::invalid_argument for other strategies
+std::unique_ptr<Player> make_markov_player(std::string config) {
+	std::string name = config.substr(0, config.find('('));
+	std::string arg{};
+	if (config.find('(') != std::string::npos) arg = config.substr(config.find('(') + 1, config.rfind(')') - config.find('(') - 1);
+
+	if (name == "Fixed" and arg.size() == 1) return std::make_unique<Fixed>(arg[0]);
+	if (name == "Rotation") return std::make_unique<Rotation>((short)std::stoi(arg.empty() ? "0" : arg));
+	if (name == "Frequency") return std::make_unique<Frequency>();
+	if (name == "Anti_Rotation") return std::make_unique<Anti_Rotation>();
+	if (name == "Random") return std::make_unique<Random>(0);
+	if (name == "Meta_Player_Rand_Strat") { // optional initial state (rounds,strategy,rotation), see Meta_Player_Rand_Strat::get_config()
+		int initial[3]{};
+		std::istringstream iss{ arg };
+		std::string value{};
+		for (int k{}; k < 3 and std::getline(iss, value, ','); k += 1) initial[k] = std::stoi(value);
+		return std::make_unique<Meta_Player_Rand_Strat>(false, "", initial[0], initial[1], initial[2]);
+	}
+	throw std::invalid_argument{ "No Markov description for strategy " + config };
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "RPS_Header.h"
+
+
+//// Hardware counter profiling: cycles, instructions, cache misses and branch misses per strategy and per phase of a round
+
+// Perf_Profiler is a Game_Profiler (see Game::set_profiler()): Game reports begin and end of every get_move() call of both Players and of
+// the evaluation and output phases of every round; Perf_Profiler reads the counters of the calling thread at both points and adds up the
+// difference. Counters are opened with Linux perf_event_open() for user space only (works with the default perf_event_paranoid = 2).
+// If the kernel denies access (or on other systems) only wall time is measured and the counter columns say n/a.
+
+enum Perf_Event { perf_cycles, perf_instructions, perf_cache_misses, perf_branch_misses, num_perf_events };
+
+const std::array<std::string, num_perf_events> perf_event_names{ "cycles", "instructions", "cache misses", "branch misses" };
+
+
+// Perf_Counters: group of hardware counters of the calling thread; counters the CPU (or VM) doesn't offer are left out
+struct Perf_Counters {
+
+	Perf_Counters() {
+#ifdef __linux__
+		const std::uint64_t configs[num_perf_events]{ PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+		for (int e{}; e < num_perf_events; e += 1) {
+			perf_event_attr attr{};
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = configs[e];
+			attr.disabled = (leader < 0 ? 1 : 0); // whole group is enabled by the leader
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0); // this thread, any cpu
+			if (fd < 0) {
+				if (error.empty()) error = perf_event_names[e] + ": " + std::strerror(errno);
+				continue;
+			}
+			if (leader < 0) leader = fd;
+			fds[e] = fd;
+			slot[e] = num_open;
+			num_open += 1;
+		}
+		if (leader >= 0) {
+			ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		}
+		else if (errno == EACCES or errno == EPERM) error += " (see /proc/sys/kernel/perf_event_paranoid)";
+#else
+		error = "hardware counters are only supported on Linux";
+#endif
+	}
+
+	~Perf_Counters() {
+#ifdef __linux__
+		for (int fd : fds) if (fd >= 0) close(fd);
+#endif
+	}
+
+	Perf_Counters(const Perf_Counters&) = delete;
+	Perf_Counters& operator=(const Perf_Counters&) = delete;
+
+	// available() returns true if at least one counter could be opened
+	bool available() const {
+		return num_open > 0;
+	}
+
+	bool has(Perf_Event event) const {
+		return fds[event] >= 0;
+	}
+
+	// error: reason the first counter that failed couldn't be opened (empty if all are available)
+	const std::string& get_error() const {
+		return error;
+	}
+
+	// read() writes current counts (scaled up if the kernel had to multiplex counters); returns false if no counters are available
+	bool read(std::uint64_t values[num_perf_events]) const {
+#ifdef __linux__
+		if (leader < 0) return false;
+		std::uint64_t buffer[3 + num_perf_events]{}; // {nr, time_enabled, time_running, value of every open counter}
+		if (::read(leader, buffer, sizeof(buffer)) < (ssize_t)(3 + num_open) * (ssize_t)sizeof(std::uint64_t)) return false;
+		double scale = (buffer[2] > 0 and buffer[2] < buffer[1] ? (double)buffer[1] / (double)buffer[2] : 1);
+		for (int e{}; e < num_perf_events; e += 1) {
+			values[e] = (fds[e] >= 0 ? (scale == 1 ? buffer[3 + slot[e]] : (std::uint64_t)((double)buffer[3 + slot[e]] * scale)) : 0);
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+private:
+	int fds[num_perf_events]{ -1, -1, -1, -1 };
+	int slot[num_perf_events]{}; // position of counter in group read
+	int leader{ -1 };
+	int num_open{};
+	std::string error{};
+};
+
+
+// Perf_Stats: counters added up over all measured calls of one phase
+struct Perf_Stats {
+	long long calls{};
+	std::uint64_t nanoseconds{};
+	std::uint64_t counts[num_perf_events]{};
+};
+
+// Perf_Row: one line of a profile report (e.g. get_move() of one strategy)
+struct Perf_Row {
+	std::string label{};
+	Perf_Stats stats{};
+};
+
+
+struct Perf_Profiler : Game_Profiler {
+
+	// sample_every: only every n-th round is measured (reading the counters costs a system call, about as much as a cheap get_move())
+	Perf_Profiler(long long sample_every = 1) : sample_every{ std::max(sample_every, 1ll) } {}
+
+	bool sample_round() override {
+		round += 1;
+		return ((round - 1) % sample_every == 0);
+	}
+
+	void begin_phase(Game_Phase phase) override {
+		Phase_Start& start = starts[(int)phase];
+		counters.read(start.counts);
+		start.time = std::chrono::steady_clock::now(); // last, so the clock isn't part of the measured interval
+	}
+
+	void end_phase(Game_Phase phase) override {
+		auto now = std::chrono::steady_clock::now();
+		std::uint64_t counts[num_perf_events]{};
+		counters.read(counts);
+
+		const Phase_Start& start = starts[(int)phase];
+		Perf_Stats& sum = stats[(int)phase];
+		sum.calls += 1;
+		sum.nanoseconds += (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now - start.time).count();
+		for (int e{}; e < num_perf_events; e += 1) sum.counts[e] += counts[e] - start.counts[e];
+	}
+
+	const Perf_Stats& get_stats(Game_Phase phase) const {
+		return stats[(int)phase];
+	}
+
+	const Perf_Counters& get_counters() const {
+		return counters;
+	}
+
+	// rows() labels the phases with the names of the Players of the profiled game
+	std::vector<Perf_Row> rows(std::string name_p1, std::string name_p2) const {
+		return {
+			{ "get_move " + name_p1 + " (P1)", get_stats(Game_Phase::move_p1) },
+			{ "get_move " + name_p2 + " (P2)", get_stats(Game_Phase::move_p2) },
+			{ "evaluate", get_stats(Game_Phase::evaluate) },
+			{ "output", get_stats(Game_Phase::output) }
+		};
+	}
+
+private:
+	struct Phase_Start {
+		std::chrono::steady_clock::time_point time{};
+		std::uint64_t counts[num_perf_events]{};
+	};
+
+	Perf_Counters counters{};
+	long long sample_every{};
+	long long round{};
+	Phase_Start starts[4]{};
+	Perf_Stats stats[4]{};
+};
+
+
+// print_perf_report() prints averages per call of every row; counters that aren't available are printed as n/a
+void print_perf_report(const std::vector<Perf_Row>& rows, const Perf_Counters& counters, std::ostream& os = std::cout) {
+	std::size_t width{ 8 };
+	for (const Perf_Row& row : rows) width = std::max(width, row.label.size() + 2);
+
+	os << "\n----------------\n\nProfile (averages per call)\n\n";
+	if (!counters.available()) os << "Hardware counters unavailable (" << counters.get_error() << "), measuring wall time only\n\n";
+	os << std::left << std::setw((int)width) << "Phase" << std::right << std::setw(12) << "calls" << std::setw(12) << "ns";
+	for (const std::string& name : perf_event_names) os << std::setw(15) << name;
+	os << std::setw(8) << "IPC" << "\n";
+
+	os << std::fixed << std::setprecision(1);
+	for (const Perf_Row& row : rows) {
+		const Perf_Stats& s = row.stats;
+		double calls = (double)std::max(s.calls, 1ll);
+		os << std::left << std::setw((int)width) << row.label << std::right << std::setw(12) << s.calls << std::setw(12) << (double)s.nanoseconds / calls;
+		for (int e{}; e < num_perf_events; e += 1) {
+			if (counters.has((Perf_Event)e)) os << std::setw(15) << (double)s.counts[e] / calls;
+			else os << std::setw(15) << "n/a";
+		}
+		if (counters.has(perf_cycles) and counters.has(perf_instructions) and s.counts[perf_cycles]) {
+			os << std::setw(8) << std::setprecision(2) << (double)s.counts[perf_instructions] / (double)s.counts[perf_cycles] << std::setprecision(1);
+		}
+		else os << std::setw(8) << "n/a";
+		os << "\n";
+	}
+	os << std::defaultfloat << std::setprecision(6) << "\n----------------" << std::endl;
+}
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <stdexcept>
+
+#include "RPS_Header.h"
+
+
+//// Plot export: plot-ready win rate and Meta score series, downsampled while the game is played
+
+// Downsampled_Series: streaming min/max bucket downsampling to a fixed point budget
+// Every bucket covers bucket_width consecutive values and keeps their minimum and maximum (so spikes survive downsampling);
+// when all buckets are in use, neighbouring buckets are merged and bucket_width doubles. Memory and output size only depend on
+// the point budget, not on the number of values added
+struct Downsampled_Series {
+
+	Downsampled_Series(std::string name = "", std::size_t point_budget = 1000) : name{ name }, max_buckets{ std::max<std::size_t>(point_budget / 2, 1) } {}
+
+	void add(long long x, double y) {
+		if (count == 0) first = { x, y };
+		last = { x, y };
+		count += 1;
+
+		if (buckets.empty() or buckets.back().count == bucket_width) {
+			if (buckets.size() == max_buckets) merge_buckets(); // merged buckets are only full if bucket count was even
+			if (buckets.empty() or buckets.back().count == bucket_width) buckets.push_back(Bucket{ x, y, x, y, 0 });
+		}
+		Bucket& bucket = buckets.back();
+		if (y < bucket.min) bucket.min_x = x, bucket.min = y;
+		if (y > bucket.max) bucket.max_x = x, bucket.max = y;
+		bucket.count += 1;
+	}
+
+	// points() returns downsampled series ordered by x: minimum and maximum of every bucket plus first and last value
+	std::vector<std::pair<long long, double>> points() {
+		std::vector<std::pair<long long, double>> result{};
+		if (count == 0) return result;
+		result.push_back(first);
+		for (const Bucket& bucket : buckets) {
+			std::pair<long long, double> p_min{ bucket.min_x, bucket.min }, p_max{ bucket.max_x, bucket.max };
+			if (p_max.first < p_min.first) std::swap(p_min, p_max);
+			if (p_min.first > result.back().first) result.push_back(p_min);
+			if (p_max.first > result.back().first) result.push_back(p_max);
+		}
+		if (last.first > result.back().first) result.push_back(last);
+		return result;
+	}
+
+	std::string name{};
+
+private:
+	struct Bucket {
+		long long min_x{};
+		double min{};
+		long long max_x{};
+		double max{};
+		long long count{};
+	};
+
+	void merge_buckets() {
+		std::vector<Bucket> merged{};
+		for (std::size_t i{}; i < buckets.size(); i += 2) {
+			Bucket bucket = buckets[i];
+			if (i + 1 < buckets.size()) {
+				const Bucket& next = buckets[i + 1];
+				if (next.min < bucket.min) bucket.min_x = next.min_x, bucket.min = next.min;
+				if (next.max > bucket.max) bucket.max_x = next.max_x, bucket.max = next.max;
+				bucket.count += next.count;
+			}
+			merged.push_back(bucket);
+		}
+		buckets = merged;
+		bucket_width *= 2;
+	}
+
+	std::size_t max_buckets{};
+	long long bucket_width{ 1 };
+	long long count{};
+	std::pair<long long, double> first{}, last{};
+	std::vector<Bucket> buckets{};
+};
+
+
+// write_svg() writes a simple line chart of given series (x: round, y: value; y range from y_min to y_max)
+bool write_svg(std::string path, std::string title, std::vector<Downsampled_Series*> series, double y_min, double y_max) {
+	const char* colors[]{ "#1f77b4", "#d62728", "#2ca02c", "#ff7f0e", "#9467bd", "#8c564b", "#e377c2", "#7f7f7f", "#bcbd22", "#17becf" };
+	const double width{ 900 }, height{ 450 }, left{ 60 }, right{ 250 }, top{ 40 }, bottom{ 40 };
+	const double plot_w = width - left - right, plot_h = height - top - bottom;
+
+	std::ofstream ofs(path, std::ofstream::out);
+	if (!ofs.is_open()) return false;
+
+	long long x_max{ 1 };
+	std::vector<std::vector<std::pair<long long, double>>> all_points{};
+	for (Downsampled_Series* s : series) {
+		all_points.push_back(s->points());
+		if (!all_points.back().empty()) x_max = std::max(x_max, all_points.back().back().first);
+	}
+	if (!(y_max > y_min)) y_max = y_min + 1;
+
+	ofs << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << width << "\" height=\"" << height << "\" font-family=\"sans-serif\" font-size=\"12\">\n";
+	ofs << "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+	ofs << "<text x=\"" << left << "\" y=\"24\" font-size=\"16\">" << title << "</text>\n";
+	ofs << "<rect x=\"" << left << "\" y=\"" << top << "\" width=\"" << plot_w << "\" height=\"" << plot_h << "\" fill=\"none\" stroke=\"black\"/>\n";
+	ofs << "<text x=\"" << left - 5 << "\" y=\"" << top + 4 << "\" text-anchor=\"end\">" << y_max << "</text>\n";
+	ofs << "<text x=\"" << left - 5 << "\" y=\"" << top + plot_h + 4 << "\" text-anchor=\"end\">" << y_min << "</text>\n";
+	ofs << "<text x=\"" << left << "\" y=\"" << top + plot_h + 18 << "\">1</text>\n";
+	ofs << "<text x=\"" << left + plot_w << "\" y=\"" << top + plot_h + 18 << "\" text-anchor=\"end\">" << x_max << "</text>\n";
+	ofs << "<text x=\"" << left + plot_w / 2 << "\" y=\"" << top + plot_h + 32 << "\" text-anchor=\"middle\">Round</text>\n";
+
+	for (std::size_t k{}; k < series.size(); k += 1) {
+		const char* color = colors[k % 10];
+		ofs << "<polyline fill=\"none\" stroke-width=\"1.2\" stroke=\"" << color << "\" points=\"";
+		for (const auto& [x, y] : all_points[k]) {
+			double px = left + plot_w * (double)(x - 1) / (double)std::max(x_max - 1, 1ll);
+			double py = top + plot_h * (1 - (std::clamp(y, y_min, y_max) - y_min) / (y_max - y_min));
+			ofs << px << "," << py << " ";
+		}
+		ofs << "\"/>\n";
+		double legend_y = top + 14 + 16 * (double)k;
+		ofs << "<line x1=\"" << width - right + 10 << "\" y1=\"" << legend_y - 4 << "\" x2=\"" << width - right + 30 << "\" y2=\"" << legend_y - 4 << "\" stroke=\"" << color << "\" stroke-width=\"2\"/>\n";
+		ofs << "<text x=\"" << width - right + 35 << "\" y=\"" << legend_y << "\">" << series[k]->name << "</text>\n";
+	}
+	ofs << "</svg>\n";
+	return true;
+}
+
+
+// Plot_Recorder: Game_Observer that records running win rates, rolling window win rates and (optionally) Meta Player score trajectories
+// Per round cost and memory are constant (rolling window keeps window outcomes), so recording costs the same for 1k or 1B rounds
+struct Plot_Recorder : Game_Observer {
+
+	Plot_Recorder(std::string name_p1, std::string name_p2, std::size_t point_budget = 1000, std::size_t window = 100) : \
+		point_budget{ point_budget }, window{ std::max<std::size_t>(window, 1) }, ring(this->window, 0) {
+		win_rate.emplace_back("Win Rate " + name_p1, point_budget);
+		win_rate.emplace_back("Win Rate " + name_p2, point_budget);
+		win_rate.emplace_back("Draw Rate", point_budget);
+		rolling.emplace_back("Win Rate " + name_p1 + " (last " + std::to_string(this->window) + ")", point_budget);
+		rolling.emplace_back("Win Rate " + name_p2 + " (last " + std::to_string(this->window) + ")", point_budget);
+	}
+
+	// track_meta() additionally records every score of given Meta Player (one series per strategy and rotation)
+	void track_meta(Meta_Player_Naive* meta, std::string label) {
+		std::vector<std::string> names = meta->get_strategy_names();
+		Tracked_Meta tracked{ meta };
+		for (int i{}; i < 3; i += 1) {
+			for (const std::string& strategy : names) {
+				tracked.scores.emplace_back(label + ": " + strategy + " Rot" + std::to_string(i), point_budget);
+			}
+		}
+		metas.push_back(tracked);
+	}
+
+	void on_round(long long round, const Move m1, const Move m2, short outcome) override {
+		long long x = round + 1;
+		count[outcome] += 1;
+		for (int k{}; k < 3; k += 1) win_rate[(k + 2) % 3].add(x, (double)count[k] / (double)x); // series order: p1 wins, p2 wins, draws
+
+		// rolling window: ring buffer of last window outcomes
+		std::size_t slot = (std::size_t)(round % (long long)window);
+		if (round >= (long long)window) window_count[ring[slot]] -= 1;
+		ring[slot] = (std::uint8_t)outcome;
+		window_count[outcome] += 1;
+		double filled = (double)std::min<long long>(x, (long long)window);
+		rolling[0].add(x, (double)window_count[1] / filled);
+		rolling[1].add(x, (double)window_count[2] / filled);
+
+		for (Tracked_Meta& tracked : metas) {
+			std::size_t k{};
+			for (const std::vector<double>& element : tracked.meta->get_scores()) {
+				for (double score : element) {
+					if (k < tracked.scores.size()) tracked.scores[k].add(x, score);
+					k += 1;
+				}
+			}
+		}
+	}
+
+	// save() writes <id_tag>_series.csv (all series, long format: Series,Round,Value), <id_tag>_win_rate.svg and <id_tag>_meta_scores.svg
+	bool save(std::string path, std::string id_tag = "") {
+		try {
+			std::filesystem::path dir{ path };
+			std::ofstream ofs((dir / (id_tag + "_series.csv")).string(), std::ofstream::out);
+			if (!ofs.is_open()) throw std::runtime_error{ "This file path is invalid, unable to open file." };
+			ofs << "Series,Round,Value\n";
+			for (Downsampled_Series* s : all_series()) {
+				for (const auto& [x, y] : s->points()) ofs << "\"" << s->name << "\"," << x << "," << y << "\n";
+			}
+			ofs.close();
+
+			std::vector<Downsampled_Series*> rate_series{ &win_rate[0], &win_rate[1], &win_rate[2], &rolling[0], &rolling[1] };
+			if (!write_svg((dir / (id_tag + "_win_rate.svg")).string(), "Win Rates", rate_series, 0, 1)) throw std::runtime_error{ "Unable to write win rate chart." };
+
+			if (!metas.empty()) {
+				std::vector<Downsampled_Series*> score_series{};
+				double y_min{}, y_max{};
+				for (Tracked_Meta& tracked : metas) {
+					for (Downsampled_Series& s : tracked.scores) {
+						score_series.push_back(&s);
+						for (const auto& [x, y] : s.points()) {
+							y_min = std::min(y_min, y);
+							y_max = std::max(y_max, y);
+						}
+					}
+				}
+				if (!write_svg((dir / (id_tag + "_meta_scores.svg")).string(), "Meta Player Scores", score_series, y_min, y_max)) throw std::runtime_error{ "Unable to write Meta score chart." };
+			}
+		}
+		catch (std::exception& e) {
+			std::cout << "Error saving plot data: " << e.what() << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+private:
+	struct Tracked_Meta {
+		Meta_Player_Naive* meta{};
+		std::vector<Downsampled_Series> scores{};
+	};
+
+	std::vector<Downsampled_Series*> all_series() {
+		std::vector<Downsampled_Series*> result{};
+		for (Downsampled_Series& s : win_rate) result.push_back(&s);
+		for (Downsampled_Series& s : rolling) result.push_back(&s);
+		for (Tracked_Meta& tracked : metas) {
+			for (Downsampled_Series& s : tracked.scores) result.push_back(&s);
+		}
+		return result;
+	}
+
+	std::size_t point_budget{};
+	std::size_t window{};
+
+	long long count[3]{ 0, 0, 0 }; // {draws, p1 wins, p2 wins}
+	long long window_count[3]{ 0, 0, 0 };
+	std::vector<std::uint8_t> ring{}; // outcomes of last window rounds
+
+	std::vector<Downsampled_Series> win_rate{}; // p1, p2, draws
+	std::vector<Downsampled_Series> rolling{}; // p1, p2
+	std::vector<Tracked_Meta> metas{};
+};
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include "RPS_Header.h"
+#include "RPS_Plugin_ABI.h"
+
+
+//// Strategy plugins: Player strategies loaded from shared objects at runtime (C ABI declared in RPS_Plugin_ABI.h)
+
+// Plugin_Library: one loaded shared object; resolves the ABI functions and creates strategy instances
+struct Plugin_Library {
+
+	// Throws std::runtime_error if the library can't be opened, doesn't export the full ABI or was built against another ABI version
+	Plugin_Library(const std::string& lib_path) : path{ lib_path } {
+#ifdef _WIN32
+		handle = (void*)LoadLibraryA(path.c_str());
+#else
+		handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+		if (!handle) throw std::runtime_error{ "Unable to open plugin " + path + last_error() };
+
+		try {
+			abi_version_fn = (rps_abi_version_fn)resolve("rps_abi_version");
+			name_fn = (rps_name_fn)resolve("rps_name");
+			create_fn = (rps_create_fn)resolve("rps_create");
+			destroy_fn = (rps_destroy_fn)resolve("rps_destroy");
+			reset_fn = (rps_reset_fn)resolve("rps_reset");
+			get_moves_fn = (rps_get_moves_fn)resolve("rps_get_moves");
+
+			if (abi_version_fn() != RPS_PLUGIN_ABI_VERSION) throw std::runtime_error{ "Plugin " + path + " was built against another plugin ABI version" };
+			const char* plugin_name = name_fn();
+			name = (plugin_name ? plugin_name : path);
+		}
+		catch (std::exception&) {
+			close();
+			throw;
+		}
+	}
+
+	// Library handle can't be shared between copies
+	Plugin_Library(const Plugin_Library&) = delete;
+	Plugin_Library& operator=(const Plugin_Library&) = delete;
+
+	~Plugin_Library() {
+		close();
+	}
+
+	// creates a new strategy instance; every Plugin_Player owns exactly one instance
+	void* create() {
+		void* instance = create_fn();
+		if (!instance) throw std::runtime_error{ "Plugin " + name + " failed to create a strategy instance" };
+		return instance;
+	}
+
+	void destroy(void* instance) {
+		destroy_fn(instance);
+	}
+
+	void reset(void* instance) {
+		reset_fn(instance);
+	}
+
+	// Batched move decision for count games at once (see rps_get_moves in RPS_Plugin_ABI.h); batch drivers call this directly
+	// instead of going through Plugin_Player::get_move() once per game
+	void get_moves(void* const* instances, const rps_history* histories, std::uint8_t* moves, std::size_t count) {
+		get_moves_fn(instances, histories, moves, count);
+		for (std::size_t i{}; i < count; i += 1) {
+			if (moves[i] > 2) throw std::range_error{ "Plugin " + name + " returned an invalid move" };
+		}
+	}
+
+	std::string get_name() {
+		return name;
+	}
+
+	std::string get_path() {
+		return path;
+	}
+
+private:
+	void* resolve(const char* symbol) {
+#ifdef _WIN32
+		void* address = (void*)GetProcAddress((HMODULE)handle, symbol);
+#else
+		void* address = dlsym(handle, symbol);
+#endif
+		if (!address) throw std::runtime_error{ "Plugin " + path + " does not export " + symbol };
+		return address;
+	}
+
+	void close() {
+		if (!handle) return;
+#ifdef _WIN32
+		FreeLibrary((HMODULE)handle);
+#else
+		dlclose(handle);
+#endif
+		handle = nullptr;
+	}
+
+	// loader error message (only available with dlopen)
+	static std::string last_error() {
+#ifdef _WIN32
+		return "";
+#else
+		const char* err = dlerror();
+		return (err ? std::string{ ": " } + err : "");
+#endif
+	}
+
+	std::string path{};
+	std::string name{};
+	void* handle{};
+
+	rps_abi_version_fn abi_version_fn{};
+	rps_name_fn name_fn{};
+	rps_create_fn create_fn{};
+	rps_destroy_fn destroy_fn{};
+	rps_reset_fn reset_fn{};
+	rps_get_moves_fn get_moves_fn{};
+};
+
+
+// load_plugins() tries to load every shared object in given directory; libraries that fail to load are skipped with an error message
+std::vector<std::shared_ptr<Plugin_Library>> load_plugins(const std::string& dir) {
+	std::vector<std::shared_ptr<Plugin_Library>> plugins{};
+	std::error_code ec{};
+	if (!std::filesystem::is_directory(dir, ec)) return plugins; // no plugin directory -> no plugins
+
+	// sort paths so menu numbering doesn't depend on directory iteration order
+	std::vector<std::filesystem::path> paths{};
+	for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+		std::string ext = entry.path().extension().string();
+		if (entry.is_regular_file() and (ext == ".so" or ext == ".dll" or ext == ".dylib")) paths.push_back(entry.path());
+	}
+	std::sort(paths.begin(), paths.end());
+
+	for (const std::filesystem::path& lib_path : paths) {
+		try {
+			plugins.push_back(std::make_shared<Plugin_Library>(lib_path.string()));
+		}
+		catch (std::exception& e) {
+			std::cout << "\nError: " << e.what() << " (skipping plugin)\n";
+		}
+	}
+	return plugins;
+}
+
+
+// Plugin_Player: Player strategy backed by a plugin instance; can be used like any built-in Player (also as Meta Player oracle)
+struct Plugin_Player : Player {
+
+	Plugin_Player(std::shared_ptr<Plugin_Library> library, std::string tag = "") : library{ library }, instance{ library->create() } {
+		name = library->get_name();
+		if (not (tag == "")) name = name + " " + tag;
+	}
+
+	// instance belongs to exactly one Plugin_Player
+	Plugin_Player(const Plugin_Player&) = delete;
+	Plugin_Player& operator=(const Plugin_Player&) = delete;
+
+	~Plugin_Player() {
+		library->destroy(instance);
+	}
+
+	Move get_move(const vector& other_history, const vector& self_history) override {
+		// histories only ever grow (Game) or are passed as prefixes of earlier histories (Meta Player oracle calls),
+		// so only the new tail has to be packed instead of converting the whole history on every call
+		pack(other_history, packed_other);
+		pack(self_history, packed_self);
+
+		rps_history history{ packed_other.data(), packed_self.data(), std::min(packed_other.size(), packed_self.size()) };
+		std::uint8_t move{};
+		library->get_moves(&instance, &history, &move, 1);
+		return Move{ (short)move };
+	}
+
+	void reset() override {
+		library->reset(instance);
+		packed_other.clear();
+		packed_self.clear();
+	}
+
+	std::string get_name() override {
+		return name;
+	}
+
+	std::string name{};
+
+private:
+	// pack() brings packed up to date with history (1 byte per move)
+	static void pack(const vector& history, std::vector<std::uint8_t>& packed) {
+		if (packed.size() > history.size()) packed.resize(history.size()); // history is a prefix of what we have seen before
+		for (std::size_t i{ packed.size() }; i < history.size(); i += 1) {
+			packed.push_back((std::uint8_t)history[i]);
+		}
+	}
+
+	std::shared_ptr<Plugin_Library> library; // keeps library loaded as long as any of its players exist
+	void* instance{};
+
+	std::vector<std::uint8_t> packed_other{};
+	std::vector<std::uint8_t> packed_self{};
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+// C ABI for strategy plugins: a plugin is a shared object (.so / .dll) exporting the functions declared below.
+// Plugins only need this header (no C++ types cross the library boundary), see Plugins/Beat_Last_Plugin.cpp for an example.
+
+#include <stdint.h>
+
+// Increment whenever the signatures below change; the engine refuses to load plugins built against another version
+#define RPS_PLUGIN_ABI_VERSION 1
+
+#ifdef _WIN32
+#define RPS_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define RPS_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Packed move history of one game as seen by the plugin; moves are stored as one byte per move (0 Rock, 1 Paper, 2 Scissors)
+// other: opponent moves, self: own moves; both arrays hold length moves
+typedef struct rps_history {
+	const uint8_t* other;
+	const uint8_t* self;
+	uint64_t length;
+} rps_history;
+
+// Functions every plugin has to export (symbol names in brackets)
+typedef uint32_t (*rps_abi_version_fn)(void);     // [rps_abi_version] returns RPS_PLUGIN_ABI_VERSION the plugin was built with
+typedef const char* (*rps_name_fn)(void);         // [rps_name] strategy name shown in the selection menu
+typedef void* (*rps_create_fn)(void);             // [rps_create] creates one strategy instance (one instance per game); returns NULL on failure
+typedef void (*rps_destroy_fn)(void* instance);   // [rps_destroy] destroys instance created by rps_create
+typedef void (*rps_reset_fn)(void* instance);     // [rps_reset] resets instance state (new game)
+
+// [rps_get_moves] batched move decision: for every i < count, writes the move of instances[i] given histories[i] to moves[i];
+// a single game is simply count = 1, batch drivers pass many games at once to keep call overhead per move low
+typedef void (*rps_get_moves_fn)(void* const* instances, const rps_history* histories, uint8_t* moves, uint64_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <stdexcept>
+
+#include "RPS_Header.h"
+#include "RPS_Cache.h"
+
+
+//// Opponent profiles: what Meta Player learned about an opponent, so the next game against it doesn't start from flat scores
+
+// A profile is stored per opponent identity (its configuration, see Player::get_config(), or its name if it has none) in
+// <dir>/<hash of identity>.profile as key=value lines: Meta Player's final scores with the names of its strategies, the best strategy
+// and rotation, and summed up results of all profiled games. Meta_Player_Naive::warm_start() seeds a new game from the scores with a
+// trust factor; after the game the profile takes over the new final scores (they already include everything seen before).
+
+struct Opponent_Profile {
+	std::string opponent{};
+	long long games{};
+	long long rounds{};
+	long long score[3]{ 0, 0, 0 }; // {draws, Meta Player wins, opponent wins} over all profiled games
+	std::vector<std::string> strategies{};
+	std::vector<std::vector<double>> scores{}; // scores[rotation][strategy] as in Meta_Player_Naive::get_scores()
+	std::string best_strategy{};
+	int best_rotation{};
+
+	// learn() takes over meta's scores after a game against the profiled opponent; score: {draws, meta wins, opponent wins} of that game
+	void learn(Meta_Player_Naive& meta, const long long game_score[3]) {
+		strategies = meta.get_strategy_names();
+		scores = meta.get_scores();
+		double max{};
+		for (std::size_t i{}; i < scores.size(); i += 1) {
+			for (std::size_t j{}; j < scores[i].size(); j += 1) {
+				if (scores[i][j] > max) {
+					max = scores[i][j];
+					best_strategy = strategies[j];
+					best_rotation = (int)i;
+				}
+			}
+		}
+		games += 1;
+		for (int k{}; k < 3; k += 1) {
+			score[k] += game_score[k];
+			rounds += game_score[k];
+		}
+	}
+
+	// apply() warm starts meta from the profile (see Meta_Player_Naive::warm_start())
+	void apply(Meta_Player_Naive& meta, double trust) const {
+		meta.warm_start(strategies, scores, trust);
+	}
+};
+
+
+struct Profile_Store {
+
+	Profile_Store(std::string dir) : dir{ dir } {}
+
+	// identity() returns the key profiles of player are stored under
+	static std::string identity(Player& player) {
+		std::string config{};
+		if (player.get_config(config)) return config;
+		return player.get_name();
+	}
+
+	// load() writes stored profile of opponent to profile and returns true; returns false if there is none (or it can't be read)
+	bool load(const std::string& opponent, Opponent_Profile& profile) {
+		std::ifstream ifs(path(opponent));
+		std::map<std::string, std::string> values{};
+		std::string line{};
+		while (std::getline(ifs, line)) {
+			if (!line.empty() and line.back() == '\r') line.pop_back();
+			std::size_t pos = line.find('=');
+			if (pos != std::string::npos) values[line.substr(0, pos)] = line.substr(pos + 1);
+		}
+		if (!(values["opponent"] == opponent)) return false; // missing file or hash collision
+
+		try {
+			Opponent_Profile loaded{ opponent, std::stoll(values["games"]), std::stoll(values["rounds"]) };
+			std::istringstream score_stream{ values["score"] };
+			for (long long& s : loaded.score) score_stream >> s;
+			loaded.strategies = split(values["strategies"], ';');
+			for (const std::string& row : split(values["scores"], '|')) {
+				loaded.scores.push_back({});
+				for (const std::string& value : split(row, ';')) loaded.scores.back().push_back(std::stod(value));
+				if (loaded.scores.back().size() != loaded.strategies.size()) return false;
+			}
+			if (loaded.scores.size() != 3) return false;
+			loaded.best_strategy = values["best_strategy"];
+			loaded.best_rotation = std::stoi(values["best_rotation"]);
+			profile = loaded;
+		}
+		catch (std::exception&) {
+			return false; // malformed profile is ignored
+		}
+		return true;
+	}
+
+	// save() writes profile (replacing an older one of the same opponent); throws std::runtime_error if profile directory isn't writable
+	void save(const Opponent_Profile& profile) {
+		std::error_code ec{};
+		std::filesystem::create_directories(dir, ec);
+		std::ofstream ofs(path(profile.opponent), std::ofstream::out);
+		if (!ofs.is_open()) throw std::runtime_error{ "Unable to write opponent profile " + path(profile.opponent) };
+		ofs.precision(17); // exact round trip of scores
+		ofs << "opponent=" << profile.opponent << "\n";
+		ofs << "games=" << profile.games << "\nrounds=" << profile.rounds << "\n";
+		ofs << "score=" << profile.score[0] << " " << profile.score[1] << " " << profile.score[2] << "\n";
+		ofs << "best_strategy=" << profile.best_strategy << "\nbest_rotation=" << profile.best_rotation << "\n";
+		ofs << "strategies=";
+		for (std::size_t j{}; j < profile.strategies.size(); j += 1) ofs << (j ? ";" : "") << profile.strategies[j];
+		ofs << "\nscores=";
+		for (std::size_t i{}; i < profile.scores.size(); i += 1) {
+			ofs << (i ? "|" : "");
+			for (std::size_t j{}; j < profile.scores[i].size(); j += 1) ofs << (j ? ";" : "") << profile.scores[i][j];
+		}
+		ofs << "\n";
+	}
+
+private:
+	std::string path(const std::string& opponent) {
+		std::ostringstream oss{};
+		oss << std::hex << Result_Cache::hash(opponent) << ".profile";
+		return (std::filesystem::path{ dir } / oss.str()).string();
+	}
+
+	static std::vector<std::string> split(const std::string& text, char separator) {
+		std::vector<std::string> parts{};
+		std::istringstream iss{ text };
+		for (std::string part{}; std::getline(iss, part, separator);) parts.push_back(part);
+		return parts;
+	}
+
+	std::string dir{};
+};
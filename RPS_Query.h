@@ -0,0 +1,437 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <array>
+#include <cmath>
+#include <cctype>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "RPS_Header.h"
+#include "RPS_Trace.h"
+
+
+//// Game query: grouped statistics over a directory of saved games (see Game::save())
+
+// Every saved game <name>.csv may have a metadata file <name>.meta next to it (key=value lines: player1, player2, scoring1, scoring2,
+// rounds, config) written when the game is saved. Saves without metadata fall back to the file name convention <p1>_v_<p2>[_<suffix>].
+// Scanning maps every csv file into memory and parses it in parallel; per file summaries are cached in <dir>/.rps_query_cache
+// together with file size and modification time, so only new or changed files are parsed again.
+
+
+// write_game_metadata() writes metadata file for saved game <path>/<id_tag>.csv
+bool write_game_metadata(std::string path, std::string id_tag, const std::map<std::string, std::string>& metadata) {
+	std::ofstream ofs((std::filesystem::path{ path } / (id_tag + ".meta")).string(), std::ofstream::out);
+	if (!ofs.is_open()) return false;
+	for (const auto& [key, value] : metadata) ofs << key << "=" << value << "\n";
+	return true;
+}
+
+// read_game_metadata() reads metadata file belonging to csv_path; returns empty map if there is none
+std::map<std::string, std::string> read_game_metadata(const std::filesystem::path& csv_path) {
+	std::map<std::string, std::string> metadata{};
+	std::filesystem::path meta_path{ csv_path };
+	std::ifstream ifs(meta_path.replace_extension(".meta"));
+	std::string line{};
+	while (std::getline(ifs, line)) {
+		if (!line.empty() and line.back() == '\r') line.pop_back();
+		std::size_t pos = line.find('=');
+		if (pos != std::string::npos) metadata[line.substr(0, pos)] = line.substr(pos + 1);
+	}
+	return metadata;
+}
+
+
+// Mapped_File: read only memory mapping of a whole file (empty files aren't mapped)
+struct Mapped_File {
+
+	Mapped_File(const std::string& path) {
+#ifdef _WIN32
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) throw std::runtime_error{ "Unable to open " + path };
+		LARGE_INTEGER file_size{};
+		GetFileSizeEx(file, &file_size);
+		length = (std::size_t)file_size.QuadPart;
+		if (length == 0) return;
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping) bytes = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!bytes) throw std::runtime_error{ "Unable to map " + path };
+#else
+		fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0) throw std::runtime_error{ "Unable to open " + path };
+		struct stat file_stat {};
+		fstat(fd, &file_stat);
+		length = (std::size_t)file_stat.st_size;
+		if (length == 0) return;
+		void* addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr == MAP_FAILED) throw std::runtime_error{ "Unable to map " + path };
+		bytes = (const char*)addr;
+		madvise(addr, length, MADV_SEQUENTIAL);
+#endif
+	}
+
+	Mapped_File(const Mapped_File&) = delete;
+	Mapped_File& operator=(const Mapped_File&) = delete;
+
+	~Mapped_File() {
+#ifdef _WIN32
+		if (bytes) UnmapViewOfFile(bytes);
+		if (mapping) CloseHandle(mapping);
+		if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+		if (bytes) munmap((void*)bytes, length);
+		if (fd >= 0) close(fd);
+#endif
+	}
+
+	const char* data() const {
+		return bytes;
+	}
+
+	std::size_t size() const {
+		return length;
+	}
+
+private:
+	const char* bytes{};
+	std::size_t length{};
+#ifdef _WIN32
+	HANDLE file{ INVALID_HANDLE_VALUE };
+	HANDLE mapping{};
+#else
+	int fd{ -1 };
+#endif
+};
+
+
+// Win rate curves are sampled at checkpoint rounds 1, 2, 5, 10, 20, 50, ... (cumulative counts up to that round), so summaries of
+// games of any length stay small and curves of games with different lengths can be averaged
+inline long long query_checkpoint(std::size_t k) {
+	const long long steps[3]{ 1, 2, 5 };
+	long long round = steps[k % 3];
+	for (std::size_t i{}; i < k / 3; i += 1) round *= 10;
+	return round;
+}
+
+
+// Game_Summary: everything a query needs from one saved game
+struct Game_Summary {
+	std::string file{};
+	long long mtime{};
+	std::uint64_t size{};
+	std::string player[2]{}, scoring[2]{};
+	long long rounds{};
+	long long score[3]{ 0, 0, 0 }; // {draws, p1 wins, p2 wins}
+	std::vector<std::array<long long, 3>> checkpoints{}; // cumulative {draws, p1 wins, p2 wins} at query_checkpoint(k)
+};
+
+
+// summarize_game() parses saved game csv (memory mapped) and its metadata; csv files that aren't saved games (other header) are
+// returned with empty file name
+Game_Summary summarize_game(const std::filesystem::path& csv_path) {
+	Game_Summary summary{};
+	Mapped_File file{ csv_path.string() };
+	const std::string header{ "Move History P1," };
+	if (file.size() < header.size() or !(std::string(file.data(), header.size()) == header)) return summary;
+	summary.file = csv_path.string();
+
+	std::map<std::string, std::string> metadata = read_game_metadata(csv_path);
+	if (metadata.count("player1") and metadata.count("player2")) {
+		summary.player[0] = metadata["player1"];
+		summary.player[1] = metadata["player2"];
+		summary.scoring[0] = metadata["scoring1"];
+		summary.scoring[1] = metadata["scoring2"];
+	}
+	else { // file name convention <p1>_v_<p2>[_<suffix starting with a digit>]
+		std::string stem = csv_path.stem().string();
+		std::size_t pos = stem.find("_v_");
+		summary.player[0] = (pos == std::string::npos ? stem : stem.substr(0, pos));
+		summary.player[1] = (pos == std::string::npos ? "" : stem.substr(pos + 3));
+		std::size_t suffix = summary.player[1].find_last_of('_');
+		while (suffix != std::string::npos and suffix + 1 < summary.player[1].size() and std::isdigit((unsigned char)summary.player[1][suffix + 1])) {
+			summary.player[1].erase(suffix);
+			suffix = summary.player[1].find_last_of('_');
+		}
+	}
+
+	// rows are "<move p1>,<move p2>,<outcome>[,<game history>]"; header and game history only rows (",,,<n>") don't start with a digit
+	const char* p = file.data();
+	const char* end = p + file.size();
+	long long count[3]{ 0, 0, 0 };
+	std::size_t next_checkpoint{};
+	while (p < end) {
+		const char* line_end = (const char*)std::memchr(p, '\n', (std::size_t)(end - p));
+		if (!line_end) line_end = end;
+		if (line_end - p >= 5 and *p >= '0' and *p <= '2' and p[1] == ',' and p[3] == ',' and p[4] >= '0' and p[4] <= '2') {
+			count[p[4] - '0'] += 1;
+			summary.rounds += 1;
+			if (summary.rounds == query_checkpoint(next_checkpoint)) {
+				summary.checkpoints.push_back({ count[0], count[1], count[2] });
+				next_checkpoint += 1;
+			}
+		}
+		p = line_end + 1;
+	}
+	for (int k{}; k < 3; k += 1) summary.score[k] = count[k];
+	return summary;
+}
+
+
+// Query_Cache: per file summaries of previous scans, keyed by file path and valid as long as size and modification time are unchanged
+struct Query_Cache {
+
+	Query_Cache(std::string path) : path{ path } {
+		std::ifstream ifs(path);
+		std::string line{};
+		while (std::getline(ifs, line)) {
+			std::vector<std::string> fields = split(line);
+			if (fields.size() < 11) continue; // malformed line
+			Game_Summary summary{};
+			try {
+				summary.file = fields[0];
+				summary.mtime = std::stoll(fields[1]);
+				summary.size = std::stoull(fields[2]);
+				summary.player[0] = fields[3], summary.player[1] = fields[4];
+				summary.scoring[0] = fields[5], summary.scoring[1] = fields[6];
+				summary.rounds = std::stoll(fields[7]);
+				for (int k{}; k < 3; k += 1) summary.score[k] = std::stoll(fields[8 + k]);
+				for (std::size_t i{ 11 }; i + 2 < fields.size(); i += 3) {
+					summary.checkpoints.push_back({ std::stoll(fields[i]), std::stoll(fields[i + 1]), std::stoll(fields[i + 2]) });
+				}
+			}
+			catch (std::exception&) {
+				continue;
+			}
+			entries[summary.file] = summary;
+		}
+	}
+
+	// lookup() returns cached summary of file if it is still up to date
+	bool lookup(const std::string& file, long long mtime, std::uint64_t size, Game_Summary& summary) {
+		auto entry = entries.find(file);
+		if (entry == entries.end() or !(entry->second.mtime == mtime) or !(entry->second.size == size)) return false;
+		summary = entry->second;
+		return true;
+	}
+
+	// save() rewrites cache with given summaries (files that don't exist anymore are dropped)
+	bool save(const std::vector<Game_Summary>& summaries) {
+		std::ofstream ofs(path, std::ofstream::out);
+		if (!ofs.is_open()) return false;
+		for (const Game_Summary& s : summaries) {
+			ofs << s.file << "\t" << s.mtime << "\t" << s.size << "\t" << s.player[0] << "\t" << s.player[1] << "\t" << s.scoring[0] << "\t" \
+				<< s.scoring[1] << "\t" << s.rounds << "\t" << s.score[0] << "\t" << s.score[1] << "\t" << s.score[2];
+			for (const std::array<long long, 3>& c : s.checkpoints) ofs << "\t" << c[0] << "\t" << c[1] << "\t" << c[2];
+			ofs << "\n";
+		}
+		return true;
+	}
+
+private:
+	static std::vector<std::string> split(const std::string& line) {
+		std::vector<std::string> fields{};
+		std::istringstream iss{ line };
+		std::string field{};
+		while (std::getline(iss, field, '\t')) fields.push_back(field);
+		return fields;
+	}
+
+	std::string path{};
+	std::map<std::string, Game_Summary> entries{};
+};
+
+
+// Query_Group: aggregate of all games in one group, seen from the grouped player's side
+struct Query_Group {
+	long long games{};
+	long long rounds{};
+	long long count[3]{ 0, 0, 0 }; // {draws, wins, losses}
+	std::vector<double> curve_win{}, curve_draw{}; // sums of cumulative win / draw rates at checkpoints
+	std::vector<long long> curve_games{}; // number of games reaching each checkpoint
+
+	double rate(int k) const {
+		return (rounds ? (double)count[k] / (double)rounds : 0);
+	}
+
+	// 95% Wilson score interval of win rate; treats rounds as independent trials
+	std::pair<double, double> win_interval() const {
+		if (rounds == 0) return { 0, 1 };
+		const double z{ 1.96 };
+		double n = (double)rounds, p = rate(1);
+		double center = (p + z * z / (2 * n)) / (1 + z * z / n);
+		double half = z * std::sqrt(p * (1 - p) / n + z * z / (4 * n * n)) / (1 + z * z / n);
+		return { std::max(center - half, 0.0), std::min(center + half, 1.0) };
+	}
+};
+
+
+// Game_Query: scans a directory of saved games and groups them
+// by: "player" (every game counts for both players), "opponent" (games of players matching filter, grouped by opponent),
+//     "scoring" (games of Meta Players, grouped by scoring function) or "pairing" (player vs opponent)
+struct Game_Query {
+
+	Game_Query(std::string dir, unsigned threads = 0) : dir{ dir }, threads{ threads ? threads : std::max(std::thread::hardware_concurrency(), 1u) } {}
+
+	// scan() summarizes all csv files below dir (parsing only files that changed since the last scan) and updates the cache file
+	void scan() {
+		std::vector<std::filesystem::path> files{};
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(dir)) {
+			if (entry.is_regular_file() and entry.path().extension() == ".csv") files.push_back(entry.path());
+		}
+		std::sort(files.begin(), files.end());
+
+		Query_Cache cache{ cache_path() };
+		summaries = std::vector<Game_Summary>(files.size());
+		std::vector<char> cached(files.size(), 0);
+		for (std::size_t i{}; i < files.size(); i += 1) {
+			long long mtime = (long long)std::filesystem::last_write_time(files[i]).time_since_epoch().count();
+			std::uint64_t size = std::filesystem::file_size(files[i]);
+			cached[i] = cache.lookup(files[i].string(), mtime, size, summaries[i]);
+			summaries[i].mtime = mtime;
+			summaries[i].size = size;
+		}
+
+		// uncached files are handed out one by one, so a few huge saves don't hold up a worker with a fixed share
+		std::atomic<std::size_t> next{ 0 };
+		std::vector<std::string> errors(files.size());
+		std::vector<std::thread> workers{};
+		for (unsigned t{}; t < threads; t += 1) {
+			workers.emplace_back([&]() {
+				for (std::size_t i = next++; i < files.size(); i = next++) {
+					if (cached[i]) continue;
+					Trace_Span span{ "summarize game" };
+					try {
+						long long mtime = summaries[i].mtime;
+						std::uint64_t size = summaries[i].size;
+						summaries[i] = summarize_game(files[i]);
+						summaries[i].mtime = mtime;
+						summaries[i].size = size;
+					}
+					catch (std::exception& e) {
+						errors[i] = e.what();
+					}
+				}
+			});
+		}
+		for (std::thread& worker : workers) worker.join();
+
+		parsed = 0, from_cache = 0;
+		for (std::size_t i{}; i < files.size(); i += 1) {
+			if (cached[i]) from_cache += 1;
+			else parsed += 1;
+			if (!errors[i].empty()) std::cout << "Error: " << errors[i] << " (file skipped)\n";
+		}
+		std::erase_if(summaries, [](const Game_Summary& s) { return s.file.empty(); });
+		if (!cache.save(summaries)) std::cout << "Error: unable to write query cache " << cache_path() << "\n";
+	}
+
+	// group() aggregates scanned games; filter restricts grouped players to names containing it
+	std::map<std::string, Query_Group> group(std::string by, std::string filter = "") {
+		if (!(by == "player" or by == "opponent" or by == "scoring" or by == "pairing")) throw std::invalid_argument{ "Unknown grouping " + by };
+		std::map<std::string, Query_Group> groups{};
+		for (const Game_Summary& s : summaries) {
+			for (int side{}; side < 2; side += 1) {
+				const std::string& self = s.player[side];
+				const std::string& other = s.player[1 - side];
+				if (self.empty() or (!filter.empty() and self.find(filter) == std::string::npos)) continue;
+
+				std::string key{};
+				if (by == "player") key = self;
+				else if (by == "opponent") key = other;
+				else if (by == "pairing") key = self + " vs " + other;
+				else if (s.scoring[side].empty()) continue; // not a Meta Player (or unknown scoring function)
+				else key = s.scoring[side];
+
+				Query_Group& g = groups[key];
+				g.games += 1;
+				g.rounds += s.rounds;
+				g.count[0] += s.score[0];
+				g.count[1] += s.score[1 + side];
+				g.count[2] += s.score[2 - side];
+				if (g.curve_games.size() < s.checkpoints.size()) {
+					g.curve_win.resize(s.checkpoints.size());
+					g.curve_draw.resize(s.checkpoints.size());
+					g.curve_games.resize(s.checkpoints.size());
+				}
+				for (std::size_t k{}; k < s.checkpoints.size(); k += 1) {
+					double round = (double)query_checkpoint(k);
+					g.curve_win[k] += (double)s.checkpoints[k][1 + side] / round;
+					g.curve_draw[k] += (double)s.checkpoints[k][0] / round;
+					g.curve_games[k] += 1;
+				}
+			}
+		}
+		return groups;
+	}
+
+	// number of csv files parsed by last scan() (including csv files that turned out not to be saved games)
+	std::size_t files_parsed() {
+		return parsed;
+	}
+
+	// number of saved games last scan() took from the cache
+	std::size_t files_cached() {
+		return from_cache;
+	}
+
+	std::size_t size() {
+		return summaries.size();
+	}
+
+private:
+	std::string cache_path() {
+		return (std::filesystem::path{ dir } / ".rps_query_cache").string();
+	}
+
+	std::string dir{};
+	unsigned threads{};
+	std::vector<Game_Summary> summaries{};
+	std::size_t parsed{}, from_cache{};
+};
+
+
+// print_query() prints grouped statistics as a table; save_query_curves() writes win rate curves (long format: Group,Round,...)
+void print_query(const std::map<std::string, Query_Group>& groups, std::ostream& os = std::cout) {
+	os << "Group,Games,Rounds,Win Rate,Draw Rate,Loss Rate,Win Rate CI Low,Win Rate CI High\n";
+	os << std::fixed << std::setprecision(4);
+	for (const auto& [key, g] : groups) {
+		auto [low, high] = g.win_interval();
+		os << "\"" << key << "\"," << g.games << "," << g.rounds << "," << g.rate(1) << "," << g.rate(0) << "," << g.rate(2) << "," << low << "," << high << "\n";
+	}
+	os << std::defaultfloat;
+}
+
+bool save_query_curves(std::string path, const std::map<std::string, Query_Group>& groups) {
+	std::ofstream ofs(path, std::ofstream::out);
+	if (!ofs.is_open()) return false;
+	ofs << "Group,Round,Mean Win Rate,Mean Draw Rate,Games\n";
+	for (const auto& [key, g] : groups) {
+		for (std::size_t k{}; k < g.curve_games.size(); k += 1) {
+			ofs << "\"" << key << "\"," << query_checkpoint(k) << "," << g.curve_win[k] / (double)g.curve_games[k] << "," \
+				<< g.curve_draw[k] / (double)g.curve_games[k] << "," << g.curve_games[k] << "\n";
+		}
+	}
+	return true;
+}
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <coroutine>
+#include <functional>
+#include <exception>
+#include <condition_variable>
+#include <mutex>
+#include <deque>
+#include <queue>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <string>
+
+#include "RPS_Header.h"
+#include "RPS_Trace.h"
+
+
+//// Coroutine game loop: many games (bot and interactive ones) multiplexed on a few threads
+
+// play_async() is Game::play() as a C++20 coroutine: instead of blocking it suspends while waiting for a move (Async_Player, e.g. a person
+// typing) or for the delay between rounds. Scheduler resumes suspended games once their move or delay is ready, so thousands of games
+// share a small number of worker threads instead of one thread per game. Every game frame is only resumed by one worker at a time.
+
+struct Scheduler;
+
+// Game_Task: coroutine type of play_async(); the frame is owned by Scheduler from Scheduler::spawn() on and destroyed when the game ends
+struct Game_Task {
+
+	struct promise_type;
+	using handle_type = std::coroutine_handle<promise_type>;
+
+	// Final_Awaiter reports the finished game to Scheduler and destroys the frame (the worker that resumed it doesn't touch it anymore)
+	struct Final_Awaiter {
+		bool await_ready() noexcept { return false; }
+		void await_suspend(handle_type handle) noexcept;
+		void await_resume() noexcept {}
+	};
+
+	struct promise_type {
+		Scheduler* scheduler{};
+
+		Game_Task get_return_object() { return Game_Task{ handle_type::from_promise(*this) }; }
+		std::suspend_always initial_suspend() noexcept { return {}; } // starts when Scheduler resumes it the first time
+		Final_Awaiter final_suspend() noexcept { return {}; }
+		void return_void() {}
+
+		// a failing game (e.g. input of an interactive player closed) ends; other games keep running
+		void unhandled_exception() {
+			try {
+				std::rethrow_exception(std::current_exception());
+			}
+			catch (std::exception& e) {
+				std::cout << "\nError: " << e.what() << " (game aborted)\n";
+			}
+		}
+	};
+
+	handle_type handle{};
+};
+
+
+// Async_Player: Player whose next move may not be available yet (e.g. a person or a remote client); get_move() may block until it is,
+// so Async_Players also work with Game::play(); play_async() waits for notify_when_ready() instead
+struct Async_Player : Player {
+
+	// move_ready() returns true if get_move() can answer without blocking
+	virtual bool move_ready() = 0;
+
+	// notify_when_ready() calls resume once, from any thread, as soon as move_ready() is true (immediately if it already is)
+	virtual void notify_when_ready(std::function<void()> resume) = 0;
+};
+
+
+// Scheduler: runs spawned games on worker threads; games suspended on a move or a delay don't occupy a worker
+struct Scheduler {
+
+	Scheduler(unsigned threads = 1) : threads{ std::max(threads, 1u) } {}
+
+	// spawn() hands over a game loop; it starts running with Scheduler::run()
+	void spawn(Game_Task task) {
+		task.handle.promise().scheduler = this;
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			active += 1;
+		}
+		schedule(task.handle);
+	}
+
+	// schedule() makes suspended coroutine ready to be resumed; may be called from any thread
+	void schedule(std::coroutine_handle<> handle) {
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			ready.push_back(handle);
+		}
+		wake.notify_one();
+	}
+
+	// run() resumes ready games on worker threads (the calling thread is one of them) until all spawned games are finished
+	void run() {
+		std::vector<std::thread> workers{};
+		for (unsigned t{ 1 }; t < threads; t += 1) workers.emplace_back([this]() { work(); });
+		work();
+		for (std::thread& worker : workers) worker.join();
+	}
+
+	// Delay_Awaiter: suspends game until given time has passed (Game delay between rounds)
+	struct Delay_Awaiter {
+		Scheduler& scheduler;
+		std::chrono::steady_clock::time_point due;
+
+		bool await_ready() { return std::chrono::steady_clock::now() >= due; }
+		void await_suspend(std::coroutine_handle<> handle) { scheduler.schedule_at(due, handle); }
+		void await_resume() {}
+	};
+
+	Delay_Awaiter delay(std::chrono::milliseconds duration) {
+		return Delay_Awaiter{ *this, std::chrono::steady_clock::now() + duration };
+	}
+
+	// Move_Awaiter: gets next move of Player 1 (player = 0) or Player 2 (player = 1) of game; suspends if it is an Async_Player whose move isn't ready
+	struct Move_Awaiter {
+		Scheduler& scheduler;
+		Game& game;
+		int player;
+
+		bool await_ready() {
+			Async_Player* async_player = dynamic_cast<Async_Player*>(&game.player(player));
+			return !async_player or async_player->move_ready();
+		}
+		void await_suspend(std::coroutine_handle<> handle) {
+			Scheduler* s = &scheduler;
+			dynamic_cast<Async_Player&>(game.player(player)).notify_when_ready([s, handle]() { s->schedule(handle); });
+		}
+		Move await_resume() { return game.next_move(player); }
+	};
+
+	Move_Awaiter next_move(Game& game, int player) {
+		return Move_Awaiter{ *this, game, player };
+	}
+
+	// finished() is called by the final awaiter of every game
+	void finished() {
+		std::lock_guard<std::mutex> lock{ mutex };
+		active -= 1;
+		if (active == 0) wake.notify_all();
+	}
+
+private:
+	struct Timer {
+		std::chrono::steady_clock::time_point due;
+		std::coroutine_handle<> handle;
+		bool operator>(const Timer& other) const { return due > other.due; }
+	};
+
+	void schedule_at(std::chrono::steady_clock::time_point due, std::coroutine_handle<> handle) {
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			timers.push(Timer{ due, handle });
+		}
+		wake.notify_one(); // a sleeping worker may have to wake up earlier now
+	}
+
+	void work() {
+		std::unique_lock<std::mutex> lock{ mutex };
+		while (true) {
+			auto now = std::chrono::steady_clock::now();
+			while (!timers.empty() and timers.top().due <= now) {
+				ready.push_back(timers.top().handle);
+				timers.pop();
+			}
+			if (!ready.empty()) {
+				std::coroutine_handle<> handle = ready.front();
+				ready.pop_front();
+				lock.unlock();
+				{
+					Trace_Span span{ "resume game", "scheduler" };
+					handle.resume(); // runs game until it suspends or ends
+				}
+				lock.lock();
+				continue;
+			}
+			if (active == 0) return;
+			if (timers.empty()) wake.wait(lock);
+			else wake.wait_until(lock, timers.top().due);
+		}
+	}
+
+	unsigned threads{};
+	std::mutex mutex{};
+	std::condition_variable wake{};
+	std::deque<std::coroutine_handle<>> ready{};
+	std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers{};
+	std::size_t active{};
+};
+
+inline void Game_Task::Final_Awaiter::await_suspend(handle_type handle) noexcept {
+	Scheduler* scheduler = handle.promise().scheduler;
+	handle.destroy();
+	scheduler->finished();
+}
+
+
+// play_async() plays game like Game::play() (same rounds, histories, observers and cycle detection); results are available from
+// Game::get_result() afterwards. print_stats: print Game Stats at the end like Game::play() (off for bulk games)
+Game_Task play_async(Game& game, Scheduler& scheduler, bool verbose = false, bool print_stats = false) {
+	game.begin_play();
+	for (long long i{}; i < game.get_rounds(); i += 1) {
+		Move next_move_p1 = co_await scheduler.next_move(game, 0);
+		Move next_move_p2 = co_await scheduler.next_move(game, 1);
+
+		bool finished = game.play_round(i, next_move_p1, next_move_p2, verbose);
+		if (game.get_delay()) co_await scheduler.delay(std::chrono::milliseconds{ game.get_delay() });
+		if (finished) break;
+	}
+	if (print_stats) game.evaluate_game(verbose);
+}
+
+
+// Async_Human: Human Player for multiplexed games; moves are handed over with provide_input() (e.g. by a thread reading the console)
+struct Async_Human : Async_Player {
+
+	Async_Human(std::string tag = "") {
+		if (not (tag == "")) name = name + " " + tag;
+	}
+
+	// provide_input() adds next move (0 Rock, 1 Paper, 2 Scissors); may be called from any thread
+	void provide_input(short move) {
+		std::function<void()> resume{};
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			pending.push_back(move);
+			resume.swap(waiter);
+		}
+		input_available.notify_all();
+		if (resume) resume();
+	}
+
+	// close_input() ends input (e.g. end of console input); waiting and later get_move() calls throw std::runtime_error
+	void close_input() {
+		std::function<void()> resume{};
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			closed = true;
+			resume.swap(waiter);
+		}
+		input_available.notify_all();
+		if (resume) resume();
+	}
+
+	// input_closed() returns true after close_input() (e.g. the game is over and a reading thread should stop)
+	bool input_closed() {
+		std::lock_guard<std::mutex> lock{ mutex };
+		return closed;
+	}
+
+	bool move_ready() override {
+		std::lock_guard<std::mutex> lock{ mutex };
+		return closed or !pending.empty();
+	}
+
+	void notify_when_ready(std::function<void()> resume) override {
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			if (!closed and pending.empty()) {
+				waiter = resume;
+				std::cout << name << ", Input Move shape (0 (Rock), 1 (Paper), 2 (Scissors)): " << std::flush;
+				return;
+			}
+		}
+		resume();
+	}
+
+	// get_move() blocks until a move has been provided
+	Move get_move(const vector& empty1, const vector& empty2) override {
+		std::unique_lock<std::mutex> lock{ mutex };
+		input_available.wait(lock, [this]() { return closed or !pending.empty(); });
+		if (pending.empty()) throw std::runtime_error{ name + " input has been closed" };
+		short move = pending.front();
+		pending.pop_front();
+		return Move{ move };
+	}
+
+	History_Requirement history_requirement() override {
+		return { 0, false, false };
+	}
+
+	bool interactive() override {
+		return true;
+	}
+
+	std::string get_name() override {
+		return name;
+	}
+
+	std::string name = "Pathetic Human Player";
+
+private:
+	std::mutex mutex{};
+	std::condition_variable input_available{};
+	std::deque<short> pending{};
+	std::function<void()> waiter{};
+	bool closed{};
+};
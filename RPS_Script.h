@@ -0,0 +1,384 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+
+#include "RPS_Header.h"
+
+
+//// Strategy scripts: strategies described in a small text language, compiled to a finite-state machine when loaded
+
+// A script is a list of states; the first state is where the game starts. Every state plays one move expression and has rules that
+// are checked in order after every round; the first rule whose conditions all hold switches to another state, otherwise the state
+// is kept. Lines starting with # are comments.
+//
+//   name <strategy name>                     (optional, default: file name)
+//   state <id> play <move>                   <move>: R, P, S, other or self (last move of opponent / own last move), optionally
+//                                            rotated: other+1 beats the opponent's last move (Rock is played while there is none)
+//   on <condition> [and <condition> ...] goto <id>
+//                                            <condition>: win, loss, draw (round just played), other R|P|S, self R|P|S, always,
+//                                            rounds <n> (the state has been played n rounds in a row)
+//   cycle <move> <move> ... [every <n>]      shorthand for states playing the moves in turn, each for n rounds (default 1)
+//
+// Example (win-stay, lose-shift):
+//   state stay play self
+//     on loss goto shift
+//   state shift play self+1
+//     on always goto stay
+//
+// The compiler expands states by everything their moves and rules depend on (last moves, rounds in a row) into a transition table;
+// Script_Player then needs one table lookup per observed round and one per move.
+
+// Script_Strategy: compiled script (shared by all Script_Players of this script)
+struct Script_Strategy {
+	std::string name{};
+	std::string path{};
+	std::vector<std::uint8_t> moves{}; // moves[state]: move played in state
+	std::vector<std::uint32_t> next{}; // next[state * 9 + self move * 3 + other move]: state after a round; state 0 is the start
+	std::uint64_t hash{}; // FNV-1a hash of both tables, part of Script_Player::get_config()
+
+	std::size_t size() const {
+		return moves.size();
+	}
+};
+
+
+// compile_script() compiles script source; origin is used in error messages. Throws std::invalid_argument for invalid scripts
+std::shared_ptr<Script_Strategy> compile_script(const std::string& source, const std::string& origin = "script") {
+
+	// Expression: constant move or last move of a player (other / self) rotated by rotation
+	struct Expression {
+		enum Kind { constant, other, self } kind{};
+		short move{};
+		short rotation{};
+	};
+	struct Condition {
+		enum Kind { outcome, other_move, self_move, rounds, always } kind{};
+		int value{};
+	};
+	struct Rule {
+		std::vector<Condition> conditions{};
+		std::string target{};
+		int line{};
+	};
+	struct State {
+		std::string id{};
+		Expression play{};
+		std::vector<Rule> rules{};
+		int max_rounds{}; // largest n of rounds conditions (rounds in a row are counted up to this)
+		int line{};
+	};
+
+	auto fail = [&origin](int line, const std::string& message) {
+		return std::invalid_argument{ origin + ":" + std::to_string(line) + ": " + message };
+	};
+	auto parse_shape = [&fail](const std::string& word, int line) -> short {
+		if (word == "R" or word == "P" or word == "S") return Move{ word[0] }.index;
+		throw fail(line, "expected R, P or S instead of '" + word + "'");
+	};
+	auto parse_expression = [&](const std::string& word, int line) {
+		Expression e{};
+		std::string base = word.substr(0, word.find_first_of("+-"));
+		if (base.size() < word.size()) {
+			try {
+				e.rotation = (short)mod_euc(std::stoi(word.substr(base.size())), 3);
+			}
+			catch (std::exception&) {
+				throw fail(line, "invalid rotation in '" + word + "'");
+			}
+		}
+		if (base == "other") e.kind = Expression::other;
+		else if (base == "self") e.kind = Expression::self;
+		else {
+			e.kind = Expression::constant;
+			e.move = Move{ parse_shape(base, line) }.rotate_by(e.rotation).index;
+		}
+		return e;
+	};
+
+	std::string name{};
+	std::vector<State> states{};
+	std::istringstream lines{ source };
+	std::string text{};
+	for (int line{ 1 }; std::getline(lines, text); line += 1) {
+		text = text.substr(0, text.find('#'));
+		std::istringstream words{ text };
+		std::string keyword{};
+		if (!(words >> keyword)) continue;
+
+		if (keyword == "name") {
+			std::getline(words >> std::ws, name);
+			while (!name.empty() and (name.back() == '\r' or name.back() == ' ')) name.pop_back();
+		}
+		else if (keyword == "state") {
+			State state{};
+			std::string play{}, expression{};
+			if (!(words >> state.id >> play >> expression) or !(play == "play")) throw fail(line, "expected 'state <id> play <move>'");
+			state.play = parse_expression(expression, line);
+			state.line = line;
+			states.push_back(state);
+		}
+		else if (keyword == "on") {
+			if (states.empty()) throw fail(line, "rule outside of a state");
+			Rule rule{ {}, "", line };
+			std::string word{};
+			while (words >> word) {
+				Condition condition{};
+				if (word == "win") condition = { Condition::outcome, 1 };
+				else if (word == "loss") condition = { Condition::outcome, 2 };
+				else if (word == "draw") condition = { Condition::outcome, 0 };
+				else if (word == "always") condition = { Condition::always, 0 };
+				else if (word == "other" or word == "self") {
+					std::string shape{};
+					if (!(words >> shape)) throw fail(line, "expected R, P or S after '" + word + "'");
+					condition = { (word == "other" ? Condition::other_move : Condition::self_move), parse_shape(shape, line) };
+				}
+				else if (word == "rounds") {
+					int n{};
+					if (!(words >> n) or n < 1) throw fail(line, "expected number of rounds (at least 1) after 'rounds'");
+					condition = { Condition::rounds, n };
+					states.back().max_rounds = std::max(states.back().max_rounds, n);
+				}
+				else throw fail(line, "unknown condition '" + word + "'");
+				rule.conditions.push_back(condition);
+
+				if (!(words >> word)) throw fail(line, "expected 'goto <id>'");
+				if (word == "and") continue;
+				if (!(word == "goto") or !(words >> rule.target)) throw fail(line, "expected 'and <condition>' or 'goto <id>'");
+				break;
+			}
+			if (rule.target.empty()) throw fail(line, "expected 'on <condition> goto <id>'");
+			states.back().rules.push_back(rule);
+		}
+		else if (keyword == "cycle") {
+			std::vector<short> cycle{};
+			int every{ 1 };
+			std::string word{};
+			while (words >> word) {
+				if (word == "every") {
+					if (!(words >> every) or every < 1) throw fail(line, "expected number of rounds (at least 1) after 'every'");
+					break;
+				}
+				cycle.push_back(parse_shape(word, line));
+			}
+			if (cycle.empty()) throw fail(line, "expected 'cycle <move> <move> ... [every <n>]'");
+			std::string prefix = "cycle" + std::to_string(line) + "_";
+			for (std::size_t k{}; k < cycle.size(); k += 1) {
+				State state{ prefix + std::to_string(k), { Expression::constant, cycle[k] }, {}, every, line };
+				state.rules.push_back({ { { Condition::rounds, every } }, prefix + std::to_string((k + 1) % cycle.size()), line });
+				states.push_back(state);
+			}
+		}
+		else throw fail(line, "unknown keyword '" + keyword + "'");
+	}
+	if (states.empty()) throw fail(1, "script has no states");
+
+	std::map<std::string, int> state_index{};
+	for (int s{}; s < (int)states.size(); s += 1) {
+		if (!state_index.try_emplace(states[s].id, s).second) throw fail(states[s].line, "state '" + states[s].id + "' is defined twice");
+	}
+	std::vector<std::vector<int>> targets(states.size());
+	for (int s{}; s < (int)states.size(); s += 1) {
+		for (const Rule& rule : states[s].rules) {
+			auto it = state_index.find(rule.target);
+			if (it == state_index.end()) throw fail(rule.line, "unknown state '" + rule.target + "'");
+			targets[s].push_back(it->second);
+		}
+	}
+
+	// machine states: script state, rounds played in it (up to its max_rounds), last other and self move (3 = none) where needed
+	bool needs_other{}, needs_self{};
+	for (const State& state : states) {
+		needs_other = needs_other or state.play.kind == Expression::other;
+		needs_self = needs_self or state.play.kind == Expression::self;
+	}
+	struct Key {
+		int state{}, rounds{}, other{ 3 }, self{ 3 };
+		bool operator<(const Key& k) const { return std::tie(state, rounds, other, self) < std::tie(k.state, k.rounds, k.other, k.self); }
+	};
+
+	auto strategy = std::make_shared<Script_Strategy>();
+	strategy->name = name;
+	std::map<Key, std::uint32_t> numbers{ { Key{}, 0 } };
+	std::vector<Key> keys{ Key{} };
+	for (std::size_t k{}; k < keys.size(); k += 1) {
+		const Key key = keys[k];
+		const State& state = states[key.state];
+		const Expression& e = state.play;
+		short move = e.move;
+		if (e.kind == Expression::other) move = (key.other == 3 ? 0 : rotation_table[key.other][e.rotation]);
+		if (e.kind == Expression::self) move = (key.self == 3 ? 0 : rotation_table[key.self][e.rotation]);
+		strategy->moves.push_back((std::uint8_t)move);
+
+		for (short self{}; self < 3; self += 1) {
+			for (short other{}; other < 3; other += 1) {
+				int played = std::min(key.rounds + 1, state.max_rounds);
+				Key to{ key.state, played, (needs_other ? other : 3), (needs_self ? self : 3) };
+				for (std::size_t r{}; r < state.rules.size(); r += 1) {
+					bool holds{ true };
+					for (const Condition& c : state.rules[r].conditions) {
+						switch (c.kind) {
+						case Condition::outcome: holds = holds and outcome_table[self][other] == c.value; break;
+						case Condition::other_move: holds = holds and other == c.value; break;
+						case Condition::self_move: holds = holds and self == c.value; break;
+						case Condition::rounds: holds = holds and key.rounds + 1 >= c.value; break;
+						case Condition::always: break;
+						}
+					}
+					if (holds) {
+						to.state = targets[key.state][r];
+						to.rounds = 0;
+						break;
+					}
+				}
+				auto [it, inserted] = numbers.try_emplace(to, (std::uint32_t)keys.size());
+				if (inserted) keys.push_back(to);
+				strategy->next.push_back(it->second);
+			}
+		}
+	}
+
+	std::uint64_t hash{ 14695981039346656037ull };
+	auto add = [&hash](std::uint64_t value) { hash = (hash ^ value) * 1099511628211ull; };
+	for (std::uint8_t move : strategy->moves) add(move);
+	for (std::uint32_t to : strategy->next) add(to);
+	strategy->hash = hash;
+	return strategy;
+}
+
+// load_script() reads and compiles a script file; name defaults to the file name
+std::shared_ptr<Script_Strategy> load_script(const std::string& path) {
+	std::ifstream ifs(path, std::ifstream::in);
+	if (!ifs.is_open()) throw std::runtime_error{ "Unable to open strategy script " + path };
+	std::stringstream source{};
+	source << ifs.rdbuf();
+	std::shared_ptr<Script_Strategy> strategy = compile_script(source.str(), path);
+	strategy->path = path;
+	if (strategy->name.empty()) strategy->name = std::filesystem::path{ path }.stem().string();
+	return strategy;
+}
+
+// load_scripts() compiles every .rps file in given directory; invalid scripts are skipped with an error message
+std::vector<std::shared_ptr<Script_Strategy>> load_scripts(const std::string& dir) {
+	std::vector<std::shared_ptr<Script_Strategy>> scripts{};
+	std::error_code ec{};
+	if (!std::filesystem::is_directory(dir, ec)) return scripts; // no script directory -> no scripts
+
+	// sort paths so menu numbering doesn't depend on directory iteration order
+	std::vector<std::filesystem::path> paths{};
+	for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+		if (entry.is_regular_file() and entry.path().extension() == ".rps") paths.push_back(entry.path());
+	}
+	std::sort(paths.begin(), paths.end());
+
+	for (const std::filesystem::path& script_path : paths) {
+		try {
+			scripts.push_back(load_script(script_path.string()));
+		}
+		catch (std::exception& e) {
+			std::cout << "\nError: " << e.what() << " (skipping strategy script)\n";
+		}
+	}
+	return scripts;
+}
+
+
+// Script_Player: generic interpreter of compiled scripts; can be used like any built-in Player (also as Meta Player oracle)
+struct Script_Player : Player {
+
+	Script_Player(std::shared_ptr<const Script_Strategy> strategy, std::string tag = "") : strategy{ strategy } {
+		name = strategy->name;
+		if (not (tag == "")) name = name + " " + tag;
+	}
+
+	// histories only ever grow (Game) or are passed as prefixes of earlier histories (Meta Player oracle calls), so only rounds
+	// that haven't been observed yet advance the machine (one round per call in a game); shorter histories restart it
+	Move get_move(const vector& other_history, const vector& self_history) override {
+		std::size_t rounds = std::min(other_history.size(), self_history.size());
+		if (rounds < observed) {
+			state = 0;
+			observed = 0;
+		}
+		const std::uint32_t* next = strategy->next.data();
+		for (; observed < rounds; observed += 1) state = next[state * 9 + self_history[observed] * 3 + other_history[observed]];
+		return Move{ (short)strategy->moves[state] };
+	}
+
+	// the machine only needs the round it hasn't observed yet (Game asks once per round)
+	History_Requirement history_requirement() override {
+		return { 1, false, false };
+	}
+
+	// recent histories end with move summary.rounds - 1; fewer rounds than observed (new game) restart the machine, like in get_move()
+	// (rounds that already dropped out of the recent moves can't be caught up, the machine then starts over with the recent moves)
+	Move get_move_bounded(const vector& other_recent, const vector& self_recent, const History_Summary& summary) override {
+		std::size_t recent = std::min(other_recent.size(), self_recent.size());
+		if (summary.rounds < observed or summary.rounds - observed > recent) {
+			state = 0;
+			observed = (std::size_t)summary.rounds - recent;
+		}
+		const std::uint32_t* next = strategy->next.data();
+		for (std::size_t i = recent - (std::size_t)(summary.rounds - observed); i < recent; i += 1) {
+			state = next[state * 9 + self_recent[i] * 3 + other_recent[i]];
+		}
+		observed = (std::size_t)summary.rounds;
+		return Move{ (short)strategy->moves[state] };
+	}
+
+	void reset() override {
+		state = 0;
+		observed = 0;
+	}
+
+	bool get_config(std::string& config) override {
+		std::ostringstream oss{};
+		oss << "Script(" << strategy->name << "," << std::hex << strategy->hash << ")";
+		config = oss.str();
+		return true;
+	}
+
+	// the machine state determines all future moves
+	bool get_fingerprint(const vector& other_history, const vector& self_history, const History_Summary& summary, std::uint64_t& fingerprint) override {
+		get_move(other_history, self_history);
+		fingerprint = state;
+		return true;
+	}
+
+	// Markov description is the machine itself
+	bool markov_initial(std::uint64_t& initial) override {
+		initial = 0;
+		return true;
+	}
+
+	void markov_choices(std::uint64_t machine_state, std::vector<Markov_Choice>& choices) override {
+		choices.push_back({ 1, (short)strategy->moves[machine_state], machine_state });
+	}
+
+	std::uint64_t markov_observe(std::uint64_t after, short self_move, short other_move) override {
+		return strategy->next[after * 9 + self_move * 3 + other_move];
+	}
+
+	std::string get_name() override {
+		return name;
+	}
+
+	std::string get_path() {
+		return strategy->path;
+	}
+
+	std::string name{};
+
+private:
+	std::shared_ptr<const Script_Strategy> strategy{};
+	std::uint32_t state{};
+	std::size_t observed{};
+};
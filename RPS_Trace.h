@@ -0,0 +1,203 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+
+#include "RPS_Header.h"
+
+
+//// Timeline tracing: spans of games and tool tasks as Chrome trace-event JSON (open in ui.perfetto.dev or chrome://tracing)
+
+// Spans are recorded into a buffer per thread (only its own thread appends, so recording takes no lock) and written once at the end.
+// Games are traced with Trace_Profiler (a Game_Profiler, see Game::set_profiler()): every sampled round is a span with the get_move()
+// calls of both Players, evaluation and output nested inside. Other code marks spans with Trace_Span, which only records while
+// active_trace is set (e.g. by the console program if RPS_TRACE is set).
+
+// Trace_Event: one complete span (times in ns since the recorder was created); round is -1 for spans that aren't rounds
+struct Trace_Event {
+	const char* name{};
+	const char* category{};
+	std::int64_t start{};
+	std::int64_t duration{};
+	long long round{ -1 };
+};
+
+
+struct Trace_Recorder {
+
+	Trace_Recorder() : id{ next_id.fetch_add(1) } {}
+
+	Trace_Recorder(const Trace_Recorder&) = delete;
+	Trace_Recorder& operator=(const Trace_Recorder&) = delete;
+
+	// now() returns ns since the recorder was created
+	std::int64_t now() const {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+	}
+
+	// record() appends a span to the buffer of the calling thread; name and category have to outlive the recorder (literals or intern())
+	void record(const char* name, const char* category, std::int64_t start, std::int64_t end, long long round = -1) {
+		buffer().events.push_back({ name, category, start, end - start, round });
+	}
+
+	// intern() keeps a copy of text for the lifetime of the recorder (names built at runtime, e.g. Player names)
+	const char* intern(const std::string& text) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		strings.push_back(text);
+		return strings.back().c_str();
+	}
+
+	// write() writes all recorded spans as trace-event JSON; only call once recording threads are finished. Returns false if path can't be written
+	bool write(std::string path) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		std::ofstream ofs{ path };
+		if (!ofs.is_open()) return false;
+		ofs << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+		ofs << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Rock-Paper-Scissors engine\"}}";
+		ofs << std::fixed << std::setprecision(3);
+		for (const std::unique_ptr<Trace_Buffer>& buffer : buffers) {
+			ofs << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid << ",\"args\":{\"name\":\"thread " << buffer->tid << "\"}}";
+			for (const Trace_Event& event : buffer->events) {
+				ofs << ",\n{\"name\":\"" << escape(event.name) << "\",\"cat\":\"" << escape(event.category) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid;
+				ofs << ",\"ts\":" << (double)event.start / 1000 << ",\"dur\":" << (double)event.duration / 1000;
+				if (event.round >= 0) ofs << ",\"args\":{\"round\":" << event.round + 1 << "}";
+				ofs << "}";
+			}
+		}
+		ofs << "\n]}\n";
+		return (bool)ofs;
+	}
+
+	// number of recorded spans (all threads)
+	std::size_t size() {
+		std::lock_guard<std::mutex> lock{ mutex };
+		std::size_t n{};
+		for (const std::unique_ptr<Trace_Buffer>& buffer : buffers) n += buffer->events.size();
+		return n;
+	}
+
+private:
+	struct Trace_Buffer {
+		int tid{};
+		std::vector<Trace_Event> events{};
+	};
+
+	// buffer() returns the calling thread's buffer; the lock is only taken the first time a thread records
+	Trace_Buffer& buffer() {
+		thread_local std::uint64_t cached_recorder{};
+		thread_local Trace_Buffer* cached_buffer{};
+		if (cached_recorder == id) return *cached_buffer;
+
+		std::lock_guard<std::mutex> lock{ mutex };
+		buffers.push_back(std::make_unique<Trace_Buffer>());
+		buffers.back()->tid = (int)buffers.size();
+		buffers.back()->events.reserve(1 << 12);
+		cached_recorder = id;
+		cached_buffer = buffers.back().get();
+		return *cached_buffer;
+	}
+
+	static std::string escape(const char* text) {
+		std::string escaped{};
+		for (; *text; text += 1) {
+			if (*text == '"' or *text == '\\') escaped += '\\';
+			if ((unsigned char)*text >= 0x20) escaped += *text;
+		}
+		return escaped;
+	}
+
+	inline static std::atomic<std::uint64_t> next_id{ 1 }; // thread buffers are cached per recorder id (addresses may be reused)
+	std::uint64_t id{};
+	std::chrono::steady_clock::time_point origin{ std::chrono::steady_clock::now() };
+	std::mutex mutex{};
+	std::vector<std::unique_ptr<Trace_Buffer>> buffers{};
+	std::deque<std::string> strings{};
+};
+
+
+// active_trace: recorder used by Trace_Span (nullptr: tracing off); set before and reset after any traced threads run
+Trace_Recorder* active_trace{};
+
+// Trace_Span: records the lifetime of the object as span (if tracing is on), e.g. { Trace_Span span{ "Game::save", "io" }; game.save(...); }
+struct Trace_Span {
+
+	Trace_Span(const char* name, const char* category = "task") : recorder{ active_trace }, name{ name }, category{ category } {
+		if (recorder) start = recorder->now();
+	}
+
+	~Trace_Span() {
+		if (recorder) recorder->record(name, category, start, recorder->now());
+	}
+
+	Trace_Span(const Trace_Span&) = delete;
+	Trace_Span& operator=(const Trace_Span&) = delete;
+
+private:
+	Trace_Recorder* recorder{};
+	const char* name{};
+	const char* category{};
+	std::int64_t start{};
+};
+
+
+// Trace_Profiler: traces every sample_every-th round of a game (round span with the phases inside); next: another profiler that gets
+// all phases as well (e.g. Perf_Profiler), Trace_Profiler doesn't take ownership. Call finish() after the game to close the last round
+struct Trace_Profiler : Game_Profiler {
+
+	Trace_Profiler(Trace_Recorder& recorder, std::string name_p1, std::string name_p2, long long sample_every = 1, Game_Profiler* next = nullptr) : \
+		recorder{ recorder }, sample_every{ std::max(sample_every, 1ll) }, next{ next } {
+		names[(int)Game_Phase::move_p1] = recorder.intern("get_move " + name_p1 + " (P1)");
+		names[(int)Game_Phase::move_p2] = recorder.intern("get_move " + name_p2 + " (P2)");
+		names[(int)Game_Phase::evaluate] = "evaluate";
+		names[(int)Game_Phase::output] = "output";
+	}
+
+	// rounds sampled by next are reported to it, but only traced if they are sampled here as well
+	bool sample_round() override {
+		finish();
+		sampled = (round % sample_every == 0);
+		round += 1;
+		next_sampled = (next and next->sample_round());
+		if (sampled) {
+			round_start = recorder.now();
+			round_end = round_start;
+		}
+		return sampled or next_sampled;
+	}
+
+	void begin_phase(Game_Phase phase) override {
+		if (sampled) starts[(int)phase] = recorder.now();
+		if (next_sampled) next->begin_phase(phase);
+	}
+
+	void end_phase(Game_Phase phase) override {
+		if (next_sampled) next->end_phase(phase);
+		if (!sampled) return;
+		round_end = recorder.now();
+		recorder.record(names[(int)phase], "round", starts[(int)phase], round_end);
+	}
+
+	// finish() records the span of the last sampled round
+	void finish() {
+		if (sampled and round_end > round_start) recorder.record("round", "game", round_start, round_end, round - 1);
+		sampled = false;
+	}
+
+private:
+	Trace_Recorder& recorder;
+	long long sample_every{};
+	Game_Profiler* next{};
+	const char* names[4]{};
+	long long round{};
+	bool sampled{}, next_sampled{};
+	std::int64_t round_start{}, round_end{};
+	std::int64_t starts[4]{};
+};
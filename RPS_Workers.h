@@ -0,0 +1,249 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <new>
+
+#if defined(__unix__) or defined(__APPLE__)
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#endif
+
+#include "RPS_Header.h"
+#include "RPS_Batch.h"
+
+
+//// Multi-process sweeps: matchups between batched strategies played by forked worker processes
+
+// A sweep plays every pair of a list of batched strategies (see make_batch_strategy()). Its games are cut into units (one matchup,
+// a range of games) that worker processes claim from a result table in shared memory: a unit's slot is claimed with one atomic
+// compare-and-swap (free -> worker id), the worker plays the unit with Batch_Game and marks the slot done after writing its stats.
+// Workers share no other state, so a crashing worker (e.g. a faulty plugin) only loses the units it had claimed: the coordinator
+// notices the dead process, frees its claimed slots and starts a replacement worker. Units are seeded by game number
+// (see Batch_Strategy::set_first_game()), so results don't depend on the number of workers, the unit size or re-issued units.
+// Without fork() (non-POSIX systems) the units are played by the calling process.
+
+// Sweep_Unit: games [first_game, first_game + num_games) of one matchup
+struct Sweep_Unit {
+	std::size_t matchup{};
+	std::size_t first_game{};
+	std::size_t num_games{};
+};
+
+// Sweep_Matchup: strategies (configuration strings) and merged stats of all their games (units merged in game order)
+struct Sweep_Matchup {
+	std::string p1{}, p2{};
+	Round_Stats stats{};
+};
+
+
+struct Process_Sweep {
+
+	// all pairs of strategies play num_games games of num_rounds rounds, cut into units of unit_games games;
+	// throws std::invalid_argument for unknown strategies (before any worker starts)
+	Process_Sweep(const std::vector<std::string>& strategies, std::size_t num_games, long long num_rounds, std::size_t unit_games = 256) : \
+		num_rounds{ num_rounds } {
+		for (const std::string& config : strategies) make_batch_strategy(config);
+		unit_games = std::max(unit_games, (std::size_t)1);
+		for (std::size_t i{}; i < strategies.size(); i += 1) {
+			for (std::size_t j{ i + 1 }; j < strategies.size(); j += 1) {
+				for (std::size_t first{}; first < num_games; first += unit_games) {
+					units.push_back({ matchups.size(), first, std::min(unit_games, num_games - first) });
+				}
+				matchups.push_back({ strategies[i], strategies[j] });
+			}
+		}
+	}
+
+	// run() plays all units with the given number of worker processes and sums up the results per matchup;
+	// throws std::runtime_error if shared memory can't be mapped or no worker can be started
+	void run(unsigned workers) {
+		for (Sweep_Matchup& matchup : matchups) matchup.stats = Round_Stats{};
+		reissued = 0;
+		failed = 0;
+#if defined(__unix__) or defined(__APPLE__)
+		std::size_t bytes = sizeof(Shared_Table) + units.size() * sizeof(Result_Slot);
+		void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+		if (memory == MAP_FAILED) throw std::runtime_error{ std::string{ "Unable to map shared result table: " } + std::strerror(errno) };
+		table = new (memory) Shared_Table{};
+		slots = reinterpret_cast<Result_Slot*>(static_cast<char*>(memory) + sizeof(Shared_Table));
+		for (std::size_t u{}; u < units.size(); u += 1) new (&slots[u]) Result_Slot{};
+
+		try {
+			coordinate(std::max(workers, 1u));
+		}
+		catch (...) {
+			munmap(memory, bytes);
+			throw;
+		}
+
+		for (std::size_t u{}; u < units.size(); u += 1) {
+			if (slots[u].state.load(std::memory_order_acquire) != slot_done) {
+				failed += 1;
+				continue;
+			}
+			matchups[units[u].matchup].stats.merge(Round_Stats{ slots[u].stats });
+		}
+		munmap(memory, bytes);
+		table = nullptr;
+		slots = nullptr;
+#else
+		for (const Sweep_Unit& unit : units) matchups[unit.matchup].stats.merge(play_unit(unit));
+#endif
+	}
+
+	const std::vector<Sweep_Matchup>& get_matchups() const {
+		return matchups;
+	}
+
+	std::size_t get_units() const {
+		return units.size();
+	}
+
+	// number of units that had to be played again because their worker died
+	std::size_t get_reissued() const {
+		return reissued;
+	}
+
+	// number of units given up after max_attempts dead workers (their games are missing from the results)
+	std::size_t get_failed() const {
+		return failed;
+	}
+
+	// fault injection for testing: the first worker that claims unit crashes (std::abort()) instead of playing it
+	void set_crash_unit(long long unit) {
+		crash_unit = unit;
+	}
+
+	static constexpr std::uint32_t max_attempts{ 3 };
+
+private:
+	// slot state: slot_free, 1 + id of the worker that claimed it, slot_done or slot_failed
+	static constexpr std::uint32_t slot_free{ 0 }, slot_done{ 0xFFFFFFFF }, slot_failed{ 0xFFFFFFFE };
+
+	struct Result_Slot {
+		std::atomic<std::uint32_t> state{ slot_free };
+		std::atomic<std::uint32_t> attempts{};
+		Round_Stats_Record stats{}; // stats of the unit's games (trivially copyable, lives in shared memory)
+	};
+
+	struct Shared_Table {
+		std::atomic<std::size_t> next_unit{}; // units below haven't necessarily been played, but were claimed once
+	};
+
+	// play_unit() plays the games of unit in the calling process and returns their merged stats
+	Round_Stats play_unit(const Sweep_Unit& unit) {
+		std::unique_ptr<Batch_Strategy> s1 = make_batch_strategy(matchups[unit.matchup].p1);
+		std::unique_ptr<Batch_Strategy> s2 = make_batch_strategy(matchups[unit.matchup].p2);
+		s1->set_first_game(unit.first_game);
+		s2->set_first_game(unit.first_game);
+		Batch_Game games{ *s1, *s2, unit.num_games, num_rounds };
+		games.play();
+		return games.total();
+	}
+
+#if defined(__unix__) or defined(__APPLE__)
+	// claim() returns index of a claimed unit or units.size() if no free unit is left: first in order, then units freed after a crash
+	std::size_t claim(std::uint32_t worker) {
+		std::size_t u = table->next_unit.fetch_add(1, std::memory_order_relaxed);
+		if (u >= units.size()) u = 0;
+		for (; u < units.size(); u += 1) {
+			std::uint32_t expected{ slot_free };
+			if (slots[u].state.compare_exchange_strong(expected, 1 + worker, std::memory_order_acq_rel)) {
+				slots[u].attempts.fetch_add(1, std::memory_order_relaxed);
+				return u;
+			}
+		}
+		return units.size();
+	}
+
+	// work() is the body of a worker process
+	[[noreturn]] void work(std::uint32_t worker) {
+		int status{};
+		try {
+			for (std::size_t u = claim(worker); u < units.size(); u = claim(worker)) {
+				if ((long long)u == crash_unit and slots[u].attempts.load(std::memory_order_relaxed) == 1) std::abort();
+				play_unit(units[u]).pack(slots[u].stats);
+				slots[u].state.store(slot_done, std::memory_order_release);
+			}
+		}
+		catch (std::exception& e) {
+			std::cout << "\nError: " << e.what() << " (worker " << worker << " failed)\n" << std::flush;
+			status = 1;
+		}
+		_exit(status); // no destructors or atexit handlers of the coordinator's copy
+	}
+
+	// spawn() forks a worker with a new id; returns its pid
+	pid_t spawn(std::uint32_t worker) {
+		std::cout << std::flush; // buffered output would be written by both processes
+		pid_t pid = fork();
+		if (pid == 0) work(worker);
+		return pid;
+	}
+
+	// coordinate() starts the workers and waits for them; units of workers that died abnormally are freed and a replacement is started
+	void coordinate(unsigned workers) {
+		std::vector<std::pair<pid_t, std::uint32_t>> running{}; // {pid, worker id}
+		std::uint32_t next_id{};
+		for (unsigned w{}; w < workers and w < units.size(); w += 1) {
+			pid_t pid = spawn(next_id);
+			if (pid < 0) break;
+			running.push_back({ pid, next_id });
+			next_id += 1;
+		}
+		if (running.empty() and !units.empty()) throw std::runtime_error{ std::string{ "Unable to start worker processes: " } + std::strerror(errno) };
+
+		while (!running.empty()) {
+			int status{};
+			pid_t pid = waitpid(-1, &status, 0);
+			if (pid < 0) {
+				if (errno == EINTR) continue;
+				throw std::runtime_error{ std::string{ "Lost track of worker processes: " } + std::strerror(errno) };
+			}
+			auto dead = std::find_if(running.begin(), running.end(), [pid](const std::pair<pid_t, std::uint32_t>& r) { return r.first == pid; });
+			if (dead == running.end()) continue;
+			std::uint32_t worker = dead->second;
+			running.erase(dead);
+			if (WIFEXITED(status) and WEXITSTATUS(status) == 0) continue;
+
+			// worker died: free its units (or give them up after max_attempts) and start a replacement if anything is left to do
+			bool left{};
+			for (std::size_t u{}; u < units.size(); u += 1) {
+				std::uint32_t expected{ 1 + worker };
+				if (slots[u].state.load(std::memory_order_acquire) != expected) continue;
+				bool retry = slots[u].attempts.load(std::memory_order_relaxed) < max_attempts;
+				slots[u].state.compare_exchange_strong(expected, (retry ? slot_free : slot_failed), std::memory_order_acq_rel);
+				if (retry) reissued += 1;
+			}
+			for (std::size_t u{}; u < units.size() and !left; u += 1) left = (slots[u].state.load(std::memory_order_acquire) == slot_free);
+			std::cout << "\nWorker " << worker << " (pid " << pid << ") died" << (left ? ", re-issuing its units\n" : "\n");
+			if (left) {
+				pid_t replacement = spawn(next_id);
+				if (replacement > 0) running.push_back({ replacement, next_id });
+				next_id += 1;
+			}
+		}
+	}
+#endif
+
+	std::vector<Sweep_Matchup> matchups{};
+	std::vector<Sweep_Unit> units{};
+	long long num_rounds{};
+	long long crash_unit{ -1 };
+	std::size_t reissued{}, failed{};
+
+	// shared memory (only while run() is running)
+	Shared_Table* table{};
+	Result_Slot* slots{};
+};
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include "RPS_Header.h"
+
+
+//// Synthetic opponent workloads: regime-switching opponents with configurable difficulty for load tests of Meta Player configurations
+
+// A workload opponent plays one of the four basic strategies of Meta_Player_Rand_Strat (Frequency, Anti_Rotation, Rotation(0), Fixed(R))
+// with a rotation for a number of rounds (a regime), then switches. Unlike Meta_Player_Rand_Strat the distributions are configurable
+// (Workload_Config): dwell time of a regime, weights of the strategies and rotations, a noise rate (rounds replaced by a random move) and
+// adversarial bursts: with probability burst_rate a regime is followed by burst_length rounds that keep its strategy but play the move
+// beating the move that beats the regime's move, i.e. they punish an opponent that has locked on to the regime.
+// All random decisions are drawn in blocks from a std::mt19937_64 seeded with the configured seed (Workload_Stream): they don't depend on
+// the game, so a workload is reproducible from its configuration string alone (same results on every platform, no std distributions),
+// and a block costs a tight loop instead of several engine calls per round.
+
+// Workload_Config: parameters of a workload; configuration string: Workload(key=value,...) with keys seed, dwell=<min>-<max> (rounds per
+// regime), mix=<4 weights separated by ;> (Frequency;Anti_Rotation;Rotation;Fixed), rotations=<3 weights separated by ;>, noise=<0-1>,
+// burst=<rate>;<length>. Omitted keys keep their defaults (Meta_Player_Rand_Strat's distributions without noise and bursts)
+struct Workload_Config {
+	std::uint64_t seed{};
+	int dwell_min{ 1 }, dwell_max{ 21 };
+	double mix[4]{ 1, 1, 1, 1 };
+	double rotations[3]{ 1, 1, 1 };
+	double noise{};
+	double burst_rate{};
+	int burst_length{ 5 };
+
+	// parse() reads a configuration string (Workload or Workload(...)); throws std::invalid_argument for unknown keys or invalid values
+	static Workload_Config parse(std::string config) {
+		Workload_Config parsed{};
+		if (!(config.substr(0, config.find('(')) == "Workload")) throw std::invalid_argument{ config + " is no workload configuration" };
+		std::string arg{};
+		if (config.find('(') != std::string::npos) arg = config.substr(config.find('(') + 1, config.rfind(')') - config.find('(') - 1);
+
+		std::istringstream iss{ arg };
+		for (std::string item{}; std::getline(iss, item, ',');) {
+			std::size_t pos = item.find('=');
+			if (pos == std::string::npos) throw std::invalid_argument{ "Workload arguments have to be given as key=value (got " + item + ")" };
+			std::string key = item.substr(0, pos), value = item.substr(pos + 1);
+			if (key == "seed") parsed.seed = std::stoull(value);
+			else if (key == "dwell") {
+				std::size_t dash = value.find('-');
+				parsed.dwell_min = std::stoi(value.substr(0, dash));
+				parsed.dwell_max = (dash == std::string::npos ? parsed.dwell_min : std::stoi(value.substr(dash + 1)));
+			}
+			else if (key == "mix") read_weights(value, parsed.mix, 4, key);
+			else if (key == "rotations") read_weights(value, parsed.rotations, 3, key);
+			else if (key == "noise") parsed.noise = std::stod(value);
+			else if (key == "burst") {
+				std::size_t semicolon = value.find(';');
+				parsed.burst_rate = std::stod(value.substr(0, semicolon));
+				if (semicolon != std::string::npos) parsed.burst_length = std::stoi(value.substr(semicolon + 1));
+			}
+			else throw std::invalid_argument{ "Unknown workload argument " + key };
+		}
+		parsed.validate();
+		return parsed;
+	}
+
+	// to_string() returns the canonical configuration string (all keys, parse(to_string()) gives the same workload)
+	std::string to_string() const {
+		std::ostringstream oss{};
+		oss.precision(17);
+		oss << "Workload(seed=" << seed << ",dwell=" << dwell_min << "-" << dwell_max << ",mix=";
+		for (int k{}; k < 4; k += 1) oss << (k ? ";" : "") << mix[k];
+		oss << ",rotations=";
+		for (int k{}; k < 3; k += 1) oss << (k ? ";" : "") << rotations[k];
+		oss << ",noise=" << noise << ",burst=" << burst_rate << ";" << burst_length << ")";
+		return oss.str();
+	}
+
+	// validate() throws std::invalid_argument if the parameters don't describe a workload
+	void validate() const {
+		if (dwell_min < 1 or dwell_max < dwell_min) throw std::invalid_argument{ "Workload dwell has to be 1 <= min <= max" };
+		if (!(noise >= 0 and noise <= 1) or !(burst_rate >= 0 and burst_rate <= 1)) throw std::invalid_argument{ "Workload noise and burst rate have to be between 0 and 1" };
+		if (burst_length < 1) throw std::invalid_argument{ "Workload burst length has to be at least 1" };
+		if (!(std::min({ mix[0], mix[1], mix[2], mix[3] }) >= 0 and mix[0] + mix[1] + mix[2] + mix[3] > 0)) throw std::invalid_argument{ "Workload mix needs non-negative weights with a positive sum" };
+		if (!(std::min({ rotations[0], rotations[1], rotations[2] }) >= 0 and rotations[0] + rotations[1] + rotations[2] > 0)) throw std::invalid_argument{ "Workload rotations need non-negative weights with a positive sum" };
+	}
+
+private:
+	static void read_weights(const std::string& value, double* weights, int count, const std::string& key) {
+		std::istringstream iss{ value };
+		std::string weight{};
+		for (int k{}; k < count; k += 1) {
+			if (!std::getline(iss, weight, ';')) throw std::invalid_argument{ "Workload " + key + " needs " + std::to_string(count) + " weights" };
+			weights[k] = std::stod(weight);
+		}
+	}
+};
+
+
+// Workload_Stream: the decisions of one workload opponent, one byte per round: bits 0-1 strategy (index into Frequency, Anti_Rotation,
+// Rotation, Fixed), bits 2-3 rotation, bit 4 burst round, bit 5 noise round, bits 6-7 move of a noise round
+struct Workload_Stream {
+
+	Workload_Stream(const Workload_Config& config, std::uint64_t seed) : config{ config }, engine{ seed } {
+		config.validate();
+		double mix_sum = config.mix[0] + config.mix[1] + config.mix[2] + config.mix[3];
+		double rotation_sum = config.rotations[0] + config.rotations[1] + config.rotations[2];
+		for (int k{}; k < 4; k += 1) mix_cumulative[k] = (k ? mix_cumulative[k - 1] : 0) + config.mix[k] / mix_sum;
+		for (int k{}; k < 3; k += 1) rotation_cumulative[k] = (k ? rotation_cumulative[k - 1] : 0) + config.rotations[k] / rotation_sum;
+	}
+
+	// fill() writes the decisions of the next n rounds
+	void fill(std::uint8_t* rounds, std::size_t n) {
+		for (std::size_t r{}; r < n; r += 1) {
+			if (remaining == 0) next_regime();
+			remaining -= 1;
+			std::uint8_t decision = (std::uint8_t)(strategy | rotation << 2 | (burst ? 1 << 4 : 0));
+			if (config.noise > 0 and uniform() < config.noise) decision |= (std::uint8_t)(1 << 5 | below(3) << 6);
+			rounds[r] = decision;
+		}
+	}
+
+	static int strategy_of(std::uint8_t decision) {
+		return decision & 3;
+	}
+
+	static short rotation_of(std::uint8_t decision) {
+		return decision >> 2 & 3;
+	}
+
+	static bool is_burst(std::uint8_t decision) {
+		return decision >> 4 & 1;
+	}
+
+	// is_noise(): the round plays noise_move() instead of the strategy
+	static bool is_noise(std::uint8_t decision) {
+		return decision >> 5 & 1;
+	}
+
+	static short noise_move(std::uint8_t decision) {
+		return decision >> 6 & 3;
+	}
+
+private:
+	// next_regime() draws strategy, rotation and dwell time of the next regime, or turns the last regime into a burst
+	void next_regime() {
+		if (!burst and started and config.burst_rate > 0 and uniform() < config.burst_rate) {
+			burst = true;
+			rotation = (std::uint8_t)((rotation + 2) % 3); // the regime's move rotated by 2 beats the move that beats it
+			remaining = config.burst_length;
+			return;
+		}
+		burst = false;
+		started = true;
+		strategy = pick(mix_cumulative, 4);
+		rotation = pick(rotation_cumulative, 3);
+		remaining = config.dwell_min + (int)below((std::uint64_t)(config.dwell_max - config.dwell_min + 1));
+	}
+
+	// uniform() returns a double in [0, 1) from the top 53 bits of the engine
+	double uniform() {
+		return (double)(engine() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	// below() returns an integer in [0, bound) (multiply-shift; bias below 2^-32 for the small bounds used here)
+	std::uint64_t below(std::uint64_t bound) {
+		return ((engine() >> 32) * bound) >> 32;
+	}
+
+	std::uint8_t pick(const double* cumulative, int count) {
+		double u = uniform();
+		int k{};
+		while (k < count - 1 and !(u < cumulative[k])) k += 1;
+		return (std::uint8_t)k;
+	}
+
+	Workload_Config config{};
+	std::mt19937_64 engine;
+	double mix_cumulative[4]{}, rotation_cumulative[3]{};
+	std::uint8_t strategy{}, rotation{};
+	int remaining{};
+	bool burst{}, started{};
+};
+
+
+// Workload_Player: workload opponent as Player; decisions are taken from the stream block_rounds at a time
+struct Workload_Player : Player {
+
+	Workload_Player(const Workload_Config& config, std::string tag = "") : config{ config }, stream{ config, config.seed } {
+		if (not (tag == "")) name = name + " " + tag;
+	}
+
+	Workload_Player(std::string config, std::string tag = "") : Workload_Player{ Workload_Config::parse(config), tag } {}
+
+	Move get_move(const vector& other_history, const vector& self_history) override {
+		std::uint8_t decision = next_decision();
+		if (Workload_Stream::is_noise(decision)) return Move{ Workload_Stream::noise_move(decision) };
+		return strategies[Workload_Stream::strategy_of(decision)]->get_move(other_history, self_history).rotate_by(Workload_Stream::rotation_of(decision));
+	}
+
+	// everything the basic strategies need
+	History_Requirement history_requirement() override {
+		return { 2, true, false };
+	}
+
+	Move get_move_bounded(const vector& other_recent, const vector& self_recent, const History_Summary& summary) override {
+		std::uint8_t decision = next_decision();
+		if (Workload_Stream::is_noise(decision)) return Move{ Workload_Stream::noise_move(decision) };
+		return strategies[Workload_Stream::strategy_of(decision)]->get_move_bounded(other_recent, self_recent, summary).rotate_by(Workload_Stream::rotation_of(decision));
+	}
+
+	// a new game starts the stream from the beginning
+	void reset() override {
+		stream = Workload_Stream{ config, config.seed };
+		position = block_rounds;
+		for (Player* strat_ptr : strategies) strat_ptr->reset();
+	}
+
+	bool get_config(std::string& config_string) override {
+		config_string = config.to_string();
+		return true;
+	}
+
+	std::string get_name() override {
+		return name;
+	}
+
+	static constexpr std::size_t block_rounds{ 4096 };
+
+private:
+	std::uint8_t next_decision() {
+		if (position == block_rounds) {
+			stream.fill(block.data(), block_rounds);
+			position = 0;
+		}
+		position += 1;
+		return block[position - 1];
+	}
+
+	Workload_Config config{};
+	Workload_Stream stream;
+	std::vector<std::uint8_t> block = std::vector<std::uint8_t>(block_rounds);
+	std::size_t position{ block_rounds };
+
+	// same strategy repertoire as Meta_Player_Rand_Strat
+	Frequency teller_freq{};
+	Anti_Rotation teller_anti_rot{};
+	Rotation teller_rot{ 0 };
+	Fixed teller_fix{ 'R' };
+	std::vector<Player*> strategies{ &teller_freq, &teller_anti_rot, &teller_rot, &teller_fix };
+
+	std::string name{ "Workload Player" };
+};
@@ -0,0 +1,59 @@
+// Tests for RPS_Adversary.h: Meta_Model plays like Meta_Player_Naive, found sequences score the same against the real Meta Player
+// Build (Linux): g++ -std=c++20 -O2 -pthread -o adversary_test Adversary_Test.cpp -ldl && ./adversary_test
+
+#include "../RPS_Adversary.h"
+#include "RPS_Test.h"
+
+
+const std::string test_configs[]{ "Meta", "Meta_Player_Naive(naive_score_add,{0;1;-1;0;10;1})", "Meta_Player_Naive(drop_switch_mul,{0.9;1.2;0.8;1;5;1})", \
+	"Meta_Player_Naive(drop_switch_add,{0;1;-1;0;3;1})" };
+
+// Meta_Model's moves equal Meta_Player_Naive's against an opponent playing seeded random moves (until the first random fallback)
+void check_model(const std::string& config, int seed) {
+	scoring_func_ptr scoring_func{};
+	double scoring_vector[6]{};
+	parse_meta_config(config, scoring_func, scoring_vector);
+	Meta_Player_Naive meta{ false, "", scoring_func, scoring_vector };
+	Random opponent{ seed };
+	Meta_Model model{};
+	vector meta_history{}, opponent_history{};
+	for (int round{}; round < 500; round += 1) {
+		bool fallback{};
+		short predicted = model.decide(fallback);
+		if (fallback) break;
+		short meta_move = meta.get_move(opponent_history, meta_history).index;
+		if (predicted != meta_move) {
+			check(false, config + " against Random(" + std::to_string(seed) + "): Meta_Model differs in round " + std::to_string(round));
+			return;
+		}
+		short opponent_move = opponent.get_move(meta_history, opponent_history).index;
+		meta_history.push_back(meta_move);
+		opponent_history.push_back(opponent_move);
+		model.observe(meta_move, opponent_move, scoring_func, scoring_vector);
+	}
+}
+
+int main() {
+	try {
+		for (const std::string& config : test_configs) {
+			for (int seed{}; seed < 20; seed += 1) check_model(config, seed);
+		}
+
+		Fork_Join_Pool pool{ 2 };
+		for (const std::string& config : test_configs) {
+			Adversary_Search search{ config, 512 };
+			Adversary_Result result = search.search(40, 3, pool);
+			check(!result.worst.empty() and result.exploitability > 0, config + ": search finds a sequence beating Meta Player");
+			for (const Adversary_Sequence& sequence : result.worst) {
+				if (sequence.fallback_rounds) continue; // random fallback rounds count 0 in the search
+				std::vector<long long> score = search.replay(sequence.moves);
+				check(score[2] - score[1] == sequence.value, config + ": replayed sequence scores " + std::to_string(score[2] - score[1]) + \
+					" instead of " + std::to_string(sequence.value));
+			}
+		}
+	}
+	catch (const std::exception& e) {
+		check(false, std::string{ "unexpected exception: " } + e.what());
+	}
+	return test_result("Adversary_Test");
+}
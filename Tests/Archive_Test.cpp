@@ -0,0 +1,99 @@
+// Tests for RPS_Archive.h: round trip of all move encodings, concurrent appends of several writers, index/block mismatches
+// Build (Linux): g++ -std=c++20 -O2 -pthread -o archive_test Archive_Test.cpp && ./archive_test
+
+#include <thread>
+#include <filesystem>
+
+#include "../RPS_Archive.h"
+#include "RPS_Test.h"
+
+
+// moves of test game k: a Fixed, a Rotation and an irregular stream (packed, delta_rle and rle/packed encodings)
+vector test_moves(std::uint64_t k, int player, std::size_t rounds) {
+	vector moves{};
+	for (std::size_t i{}; i < rounds; i += 1) {
+		switch ((k + player) % 3) {
+		case 0: moves.push_back((short)(k % 3)); break;
+		case 1: moves.push_back((short)((i + k) % 3)); break;
+		default: moves.push_back((short)((i * i + k * i / 7) % 3)); break;
+		}
+	}
+	return moves;
+}
+
+void append_test_game(Archive_Writer& writer, std::uint64_t k) {
+	Archive_Recorder recorder{};
+	recorder.record_histories(test_moves(k, 0, 100 + k), test_moves(k, 1, 100 + k));
+	writer.append(k, "P1 of " + std::to_string(k), "P2 of " + std::to_string(k), recorder);
+}
+
+void check_test_game(Archive_Reader& reader, std::uint64_t k) {
+	std::string game = "game " + std::to_string(k);
+	if (!reader.has_game(k)) {
+		check(false, game + " is missing");
+		return;
+	}
+	Archived_Game header = reader.read_game(k);
+	check(header.id == k and header.rounds == 100 + k, game + " header");
+	check(header.name_p1 == "P1 of " + std::to_string(k) and header.name_p2 == "P2 of " + std::to_string(k), game + " names");
+	check(reader.read_moves(k, 0) == test_moves(k, 0, 100 + k), game + " moves of player 1");
+	check(reader.read_moves(k, 1) == test_moves(k, 1, 100 + k), game + " moves of player 2");
+}
+
+int main() {
+	std::string path = (std::filesystem::temp_directory_path() / "rps_archive_test").string();
+	auto remove_archive = [&]() {
+		std::filesystem::remove(path + ".rpsa");
+		std::filesystem::remove(path + ".rpsi");
+	};
+
+	try {
+		// round trip
+		remove_archive();
+		{
+			Archive_Writer writer{ path };
+			for (std::uint64_t k{}; k < 9; k += 1) append_test_game(writer, k);
+		}
+		{
+			Archive_Reader reader{ path };
+			for (std::uint64_t k{}; k < 9; k += 1) check_test_game(reader, k);
+			check(!reader.has_game(9), "game 9 isn't in the archive");
+		}
+
+		// concurrent appends: two writers on the same archive, each from its own thread
+		remove_archive();
+		{
+			Archive_Writer writer_a{ path }, writer_b{ path };
+			std::thread thread_a{ [&]() { for (std::uint64_t k{}; k < 200; k += 2) append_test_game(writer_a, k); } };
+			std::thread thread_b{ [&]() { for (std::uint64_t k{ 1 }; k < 200; k += 2) append_test_game(writer_b, k); } };
+			thread_a.join();
+			thread_b.join();
+		}
+		{
+			Archive_Reader reader{ path };
+			check(reader.size() == 200, "200 index slots after concurrent appends");
+			for (std::uint64_t k{}; k < 200; k += 1) check_test_game(reader, k);
+		}
+
+		// an index record pointing to the block of another game is rejected
+		{
+			std::fstream index{ path + ".rpsi", std::ios::binary | std::ios::in | std::ios::out };
+			char record[archive_index_record]{};
+			index.read(record, archive_index_record); // record of game 0
+			index.seekp((std::streamoff)archive_index_record);
+			index.write(record, archive_index_record); // game 1 now points to the block of game 0
+		}
+		{
+			Archive_Reader reader{ path };
+			bool rejected{ false };
+			try { reader.read_game(1); }
+			catch (const std::runtime_error&) { rejected = true; }
+			check(rejected, "read_game() rejects a block of another game");
+		}
+	}
+	catch (const std::exception& e) {
+		check(false, std::string{ "unexpected exception: " } + e.what());
+	}
+	remove_archive();
+	return test_result("Archive_Test");
+}
@@ -0,0 +1,65 @@
+// Tests for RPS_Batch.h: batched strategies play the same moves as their Player counterparts in every game of a batch
+// Build (Linux): g++ -std=c++20 -O2 -o batch_test Batch_Test.cpp -ldl && ./batch_test
+
+#include "../RPS_Batch.h"
+#include "../RPS_Cyclic.h"
+#include "RPS_Test.h"
+
+
+const std::vector<std::string> configs{ "Fixed(R)", "Fixed(S)", "Rotation(0)", "Rotation(1)", "Rotation(2)", "Frequency", "Anti_Rotation", "Random(7)", "Meta" };
+
+// played_moves() plays game g of a batch with Players (Random(seed) plays like Random(seed + g)) and returns the rounds until a Meta Player
+// would play its unseeded random fallback (all scores below 1), where Batch_Meta's moves stop matching
+long long played_moves(const std::string& config1, const std::string& config2, std::size_t g, long long rounds, Game_Result& result) {
+	auto make_player = [g](std::string config) {
+		if (config.rfind("Random(", 0) == 0) config = "Random(" + std::to_string(std::stoi(config.substr(7)) + (int)g) + ")";
+		return make_cyclic_player<3>(config);
+	};
+	std::unique_ptr<Player> player1 = make_player(config1), player2 = make_player(config2);
+	Game game{ *player1, *player2, rounds };
+	game.begin_play();
+	long long comparable{ rounds };
+	for (long long i{}; i < rounds; i += 1) {
+		Move move_p1 = game.next_move(0);
+		Move move_p2 = game.next_move(1);
+		for (Player* player : { player1.get(), player2.get() }) {
+			Meta_Player_Naive* meta = dynamic_cast<Meta_Player_Naive*>(player);
+			if (!meta or i == 0 or comparable < rounds) continue;
+			double max{};
+			for (const std::vector<double>& rotation : meta->get_scores()) max = std::max(max, *std::max_element(rotation.begin(), rotation.end()));
+			if (max < 1) comparable = i;
+		}
+		game.play_round(i, move_p1, move_p2);
+	}
+	result = game.get_result();
+	return comparable;
+}
+
+int main() {
+	constexpr std::size_t games{ 4 };
+	constexpr long long rounds{ 300 };
+	try {
+		for (const std::string& config1 : configs) {
+			for (const std::string& config2 : configs) {
+				std::unique_ptr<Batch_Strategy> strategy1 = make_batch_strategy(config1), strategy2 = make_batch_strategy(config2);
+				Batch_Game batch{ *strategy1, *strategy2, games, rounds, true };
+				batch.play();
+				bool same{ true };
+				for (std::size_t g{}; g < games; g += 1) {
+					Game_Result played{}, batched = batch.get_result(g);
+					long long comparable = played_moves(config1, config2, g, rounds, played);
+					same = same and comparable > 0;
+					for (long long r{}; r < comparable; r += 1) {
+						same = same and played.move_history_p1[r] == batched.move_history_p1[r] and played.move_history_p2[r] == batched.move_history_p2[r];
+					}
+					if (comparable == rounds) same = same and played.score[0] == batched.score[0] and played.score[1] == batched.score[1] and played.score[2] == batched.score[2];
+				}
+				check(same, config1 + " vs " + config2 + ": batched games play the moves of Player games");
+			}
+		}
+	}
+	catch (const std::exception& e) {
+		check(false, std::string{ "unexpected exception: " } + e.what());
+	}
+	return test_result("Batch_Test");
+}
@@ -0,0 +1,58 @@
+// Tests for move budgets (Game::set_move_budget() in RPS_Header.h): Players get the deadline with full and with bounded histories
+// Build (Linux): g++ -std=c++20 -O2 -o budget_test Budget_Test.cpp && ./budget_test
+
+#include "../RPS_Header.h"
+#include "RPS_Test.h"
+
+
+// Deadline_Player: plays Rock and counts the moves it was asked for with and without a deadline
+struct Deadline_Player : Player {
+	Deadline_Player(bool bounded) : bounded{ bounded } {}
+
+	Move get_move(const vector& other_history, const vector& self_history) override {
+		without_deadline += 1;
+		return Move{ 'R' };
+	}
+
+	History_Requirement history_requirement() override {
+		if (bounded) return { 1, false, false };
+		return History_Requirement{};
+	}
+
+	Move get_move_until(const vector& other_history, const vector& self_history, std::chrono::steady_clock::time_point deadline) override {
+		with_deadline += (deadline != std::chrono::steady_clock::time_point::max());
+		return Move{ 'R' };
+	}
+
+	Move get_move_bounded_until(const vector& other_recent, const vector& self_recent, const History_Summary& summary, std::chrono::steady_clock::time_point deadline) override {
+		with_deadline += (deadline != std::chrono::steady_clock::time_point::max());
+		return Move{ 'R' };
+	}
+
+	std::string get_name() override {
+		return "Deadline Player";
+	}
+
+	bool bounded{};
+	long long with_deadline{}, without_deadline{};
+};
+
+int main() {
+	for (bool bounded : { false, true }) {
+		std::string histories = (bounded ? "bounded histories" : "full histories");
+		Deadline_Player player1{ bounded }, player2{ bounded };
+		Game game{ player1, player2, 100 };
+		game.set_keep_histories(!bounded);
+		game.set_move_budget(std::chrono::microseconds{ 1000000 });
+		game.begin_play();
+		for (long long i{}; i < 100; i += 1) {
+			Move move_p1 = game.next_move(0);
+			Move move_p2 = game.next_move(1);
+			game.play_round(i, move_p1, move_p2);
+		}
+		check(game.has_full_histories() != bounded, histories + ": game keeps " + histories);
+		check(player1.with_deadline == 100 and player2.with_deadline == 100, histories + ": every move is asked for with the deadline");
+		check(player1.without_deadline == 0 and player2.without_deadline == 0, histories + ": no move is asked for without a deadline");
+	}
+	return test_result("Budget_Test");
+}
@@ -0,0 +1,75 @@
+// Tests for RPS_Cache.h: round trip of results with and without histories, malformed index lines, configuration mismatches
+// Build (Linux): g++ -std=c++20 -O2 -o cache_test Cache_Test.cpp && ./cache_test
+
+#include <filesystem>
+
+#include "../RPS_Cache.h"
+#include "RPS_Test.h"
+
+
+Game_Result played_game(long long rounds) {
+	Game_Result result{ rounds };
+	result.has_histories = true;
+	for (long long i{}; i < rounds; i += 1) {
+		result.move_history_p1.push_back((short)(i % 3));
+		result.move_history_p2.push_back((short)(i * i % 3));
+		result.win_history.push_back(evaluate_round(Move{ result.move_history_p1.back() }, Move{ result.move_history_p2.back() }));
+		result.score[result.win_history.back()] += 1;
+	}
+	return result;
+}
+
+bool same_score(const Game_Result& a, const Game_Result& b) {
+	return a.num_rounds == b.num_rounds and a.score[0] == b.score[0] and a.score[1] == b.score[1] and a.score[2] == b.score[2];
+}
+
+int main() {
+	std::string dir = (std::filesystem::temp_directory_path() / "rps_cache_test").string();
+	std::filesystem::remove_all(dir);
+
+	try {
+		Game_Result short_game = played_game(500), long_game = played_game(20000);
+		{
+			Result_Cache cache{ dir };
+			cache.store("short", short_game);
+			cache.store("long", long_game);
+		}
+
+		// malformed lines are skipped when loading, the valid lines around them are still loaded
+		{
+			std::ofstream ofs((std::filesystem::path{ dir } / "index.txt").string(), std::ofstream::app);
+			ofs << "zz 10 1 2 3 0 Fixed(R)\n";
+			ofs << "ffffffffffffffffffffffff 10 1 2 3 0 Fixed(P)\n";
+			ofs << "12ab 10 1 2\n";
+			ofs << "\n";
+			ofs << "12abx 10 1 2 3 0 Fixed(S)\n";
+		}
+		Result_Cache cache{ dir };
+		check(cache.size() == 2, "malformed index lines are skipped");
+
+		Game_Result loaded{};
+		check(cache.lookup("short", loaded) and same_score(loaded, short_game), "short game is cached");
+		check(loaded.has_histories and loaded.move_history_p1 == short_game.move_history_p1 and loaded.move_history_p2 == short_game.move_history_p2 \
+			and loaded.win_history == short_game.win_history, "histories of the short game are cached");
+
+		loaded = Game_Result{};
+		check(cache.lookup("long", loaded) and same_score(loaded, long_game), "long game is cached");
+		check(!loaded.has_histories and loaded.win_history.empty(), "histories of the long game aren't stored");
+		int history_files{};
+		for (const auto& file : std::filesystem::directory_iterator{ dir }) history_files += (file.path().extension() == ".csv");
+		check(history_files == 1, "only the short game has a history file");
+
+		// lookup() needs the full configuration, a matching hash isn't enough
+		check(!cache.lookup("unknown", loaded), "unknown configuration isn't cached");
+		{
+			std::ofstream ofs((std::filesystem::path{ dir } / "index.txt").string(), std::ofstream::app);
+			ofs << std::hex << Result_Cache::hash("collision") << std::dec << " 10 1 2 3 0 something else\n";
+		}
+		check(!Result_Cache{ dir }.lookup("collision", loaded), "configuration mismatch isn't returned");
+	}
+	catch (const std::exception& e) {
+		check(false, std::string{ "unexpected exception: " } + e.what());
+	}
+	std::filesystem::remove_all(dir);
+	return test_result("Cache_Test");
+}
@@ -0,0 +1,55 @@
+// Tests for cycle detection (Game::fast_forward() in RPS_Header.h): fast-forwarded games end with the same stats as fully played ones
+// Build (Linux): g++ -std=c++20 -O2 -o cycle_test Cycle_Test.cpp && ./cycle_test
+
+#include <memory>
+#include <sstream>
+#include <functional>
+
+#include "../RPS_Header.h"
+#include "RPS_Test.h"
+
+
+const std::vector<std::pair<std::string, std::function<Player* ()>>> deterministic_players{
+	{ "Fixed(R)", []() -> Player* { return new Fixed{ 'R' }; } },
+	{ "Fixed(S)", []() -> Player* { return new Fixed{ 'S' }; } },
+	{ "Rotation(0)", []() -> Player* { return new Rotation{ 0 }; } },
+	{ "Rotation(1)", []() -> Player* { return new Rotation{ 1 }; } },
+	{ "Rotation(2)", []() -> Player* { return new Rotation{ 2 }; } },
+	{ "Frequency", []() -> Player* { return new Frequency{}; } },
+	{ "Anti_Rotation", []() -> Player* { return new Anti_Rotation{}; } },
+};
+
+// play() returns the stats of a game between new Players; fast-forward messages aren't printed
+Round_Stats play(std::size_t p1, std::size_t p2, long long rounds, bool cycle_detection, bool& fast_forwarded) {
+	std::unique_ptr<Player> player1{ deterministic_players[p1].second() }, player2{ deterministic_players[p2].second() };
+	Game game{ *player1, *player2, rounds };
+	game.set_cycle_detection(cycle_detection);
+	std::ostringstream silenced{};
+	std::streambuf* console = std::cout.rdbuf(silenced.rdbuf());
+	game.begin_play();
+	fast_forwarded = false;
+	for (long long i{}; i < rounds and !fast_forwarded; i += 1) {
+		Move move_p1 = game.next_move(0);
+		Move move_p2 = game.next_move(1);
+		fast_forwarded = game.play_round(i, move_p1, move_p2);
+	}
+	std::cout.rdbuf(console);
+	return game.get_stats();
+}
+
+int main() {
+	int fast_forwarded_games{};
+	for (std::size_t p1{}; p1 < deterministic_players.size(); p1 += 1) {
+		for (std::size_t p2{}; p2 < deterministic_players.size(); p2 += 1) {
+			std::string matchup = deterministic_players[p1].first + " vs " + deterministic_players[p2].first;
+			bool fast_forwarded{}, unused{};
+			Round_Stats skipped = play(p1, p2, 5000, true, fast_forwarded), played = play(p1, p2, 5000, false, unused);
+			fast_forwarded_games += fast_forwarded;
+			bool same{ skipped.get_rounds() == played.get_rounds() };
+			for (int k{}; k < 3; k += 1) same = same and skipped.get_score(k) == played.get_score(k) and skipped.longest_streak(k) == played.longest_streak(k);
+			check(same, matchup + ": fast-forwarded game has the stats of the played game");
+		}
+	}
+	check(fast_forwarded_games == (int)(deterministic_players.size() * deterministic_players.size()), "every deterministic matchup is fast-forwarded");
+	return test_result("Cycle_Test");
+}
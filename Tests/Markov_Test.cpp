@@ -0,0 +1,81 @@
+// Tests for RPS_Markov.h: exact expectations against simulated games, refused matchups, approximate results
+// Build (Linux): g++ -std=c++20 -O2 -o markov_test Markov_Test.cpp && ./markov_test
+
+#include <cmath>
+
+#include "../RPS_Markov.h"
+#include "RPS_Test.h"
+
+
+// mean score of games between fresh Players (seed is passed to configs containing Random), 0 seeds: one game
+void simulate(std::string config1, std::string config2, long long rounds, int seeds, double mean[3]) {
+	for (int seed{}; seed < std::max(seeds, 1); seed += 1) {
+		auto make = [seed](std::string config) -> std::unique_ptr<Player> {
+			if (config == "Random") return std::make_unique<Random>(seed);
+			return make_markov_player(config);
+		};
+		std::unique_ptr<Player> player1 = make(config1), player2 = make(config2);
+		Game game{ *player1, *player2, rounds };
+		game.begin_play(); // single steps of Game::play() without the printed game stats
+		for (long long i{}; i < rounds; i += 1) {
+			Move move_p1 = game.next_move(0);
+			Move move_p2 = game.next_move(1);
+			if (game.play_round(i, move_p1, move_p2)) break;
+		}
+		Game_Result result = game.get_result();
+		for (int k{}; k < 3; k += 1) mean[k] += (double)result.score[k] / std::max(seeds, 1);
+	}
+}
+
+// expectations of the joint chain agree with simulated games (deterministic matchups exactly, Random ones within 4 standard errors)
+void check_horizon(std::string config1, std::string config2, long long rounds, int seeds) {
+	std::string matchup = config1 + " vs " + config2;
+	std::unique_ptr<Player> player1 = make_markov_player(config1), player2 = make_markov_player(config2);
+	Markov_Horizon horizon = Markov_Analyzer{ *player1, *player2 }.finite_horizon(rounds);
+	check(!horizon.approximate, matchup + " is exact");
+
+	double mean[3]{};
+	simulate(config1, config2, rounds, seeds, mean);
+	for (int k{}; k < 3; k += 1) {
+		double tolerance = (seeds ? 4 * std::sqrt(horizon.variance[k] / seeds) : 1e-9);
+		check(std::abs(mean[k] - horizon.expected[k]) <= tolerance, matchup + ": outcome " + std::to_string(k) + " expected " + \
+			std::to_string(horizon.expected[k]) + ", simulated " + std::to_string(mean[k]));
+	}
+}
+
+int main() {
+	try {
+		check_horizon("Frequency", "Rotation(1)", 200, 0);
+		check_horizon("Frequency", "Anti_Rotation", 200, 0);
+		check_horizon("Anti_Rotation", "Rotation(2)", 200, 0);
+		check_horizon("Frequency", "Frequency", 200, 0);
+		check_horizon("Anti_Rotation", "Random", 50, 2000);
+		check_horizon("Rotation(1)", "Random", 50, 2000);
+		check_horizon("Random", "Anti_Rotation", 50, 2000);
+
+		// counting Players against moves that vary at random are refused up front
+		for (auto [config1, config2] : { std::pair{ "Random", "Frequency" }, { "Meta_Player_Rand_Strat", "Rotation(1)" }, \
+			{ "Frequency", "Meta_Player_Rand_Strat" }, { "Meta_Player_Rand_Strat", "Anti_Rotation" } }) {
+			std::unique_ptr<Player> player1 = make_markov_player(config1), player2 = make_markov_player(config2);
+			bool refused{ false };
+			try { Markov_Analyzer{ *player1, *player2 }; }
+			catch (const std::invalid_argument&) { refused = true; }
+			check(refused, std::string{ config1 } + " vs " + config2 + " is refused");
+		}
+
+		// Frequency lumps count differences above 64: exact before they can occur, approximate afterwards
+		std::unique_ptr<Player> frequency = make_markov_player("Frequency"), fixed = make_markov_player("Fixed(R)");
+		check(!Markov_Analyzer{ *frequency, *fixed }.finite_horizon(60).approximate, "Frequency vs Fixed(R) is exact for 60 rounds");
+		check(Markov_Analyzer{ *frequency, *fixed }.finite_horizon(100).approximate, "Frequency vs Fixed(R) is approximate for 100 rounds");
+		check(Markov_Analyzer{ *frequency, *fixed }.stationary().approximate, "long run of Frequency vs Fixed(R) is approximate");
+
+		std::unique_ptr<Player> switching = make_markov_player("Meta_Player_Rand_Strat");
+		Markov_Horizon horizon = Markov_Analyzer{ *switching, *fixed }.finite_horizon(40);
+		check(!horizon.approximate and std::abs(horizon.expected[0] + horizon.expected[1] + horizon.expected[2] - 40) < 1e-9, \
+			"Meta_Player_Rand_Strat vs Fixed(R) is exact for 40 rounds");
+	}
+	catch (const std::exception& e) {
+		check(false, std::string{ "unexpected exception: " } + e.what());
+	}
+	return test_result("Markov_Test");
+}
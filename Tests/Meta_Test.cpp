@@ -0,0 +1,115 @@
+// Tests for Meta_Player_Naive (RPS_Header.h): the histories its oracles get are the game's histories without the last round, also if
+// the histories Meta Player gets don't continue the ones of the previous move
+// Build (Linux): g++ -std=c++20 -O2 -o meta_test Meta_Test.cpp && ./meta_test
+
+#include <random>
+
+#include "../RPS_Header.h"
+#include "RPS_Test.h"
+
+
+// Recording_Oracle: oracle that remembers what Meta Player passed to it in its last consultation
+struct Recording_Oracle : Player {
+
+	Move get_move(const vector& other_history, const vector& self_history) override {
+		History_Summary summary{ other_history.size() };
+		for (short move : other_history) summary.other_counts[move] += 1;
+		for (short move : self_history) summary.self_counts[move] += 1;
+		return get_move_bounded(other_history, self_history, summary);
+	}
+
+	Move get_move_bounded(const vector& other_recent, const vector& self_recent, const History_Summary& summary) override {
+		other = other_recent;
+		self = self_recent;
+		counts_ok = (summary.rounds == other_recent.size());
+		for (short k{}; k < 3; k += 1) {
+			counts_ok = counts_ok and summary.other_counts[k] == (std::uint64_t)std::count(other.begin(), other.end(), k) \
+				and summary.self_counts[k] == (std::uint64_t)std::count(self.begin(), self.end(), k);
+		}
+		return Move{ 'R' };
+	}
+
+	std::string get_name() override {
+		return "Recording Oracle";
+	}
+
+	vector other{}, self{};
+	bool counts_ok{};
+};
+
+double test_scoring_vector[6]{ 0.95, 1.1, 0.9, 1, 10, 1 };
+
+// the oracle saw Meta Player's histories (other: Meta Player's moves, self: opponent moves) without their last Move
+void check_oracle(const Recording_Oracle& oracle, const vector& meta_moves, const vector& opponent_moves, std::string what) {
+	check(oracle.other == vector(meta_moves.begin(), meta_moves.end() - 1) and oracle.self == vector(opponent_moves.begin(), opponent_moves.end() - 1), \
+		what + ": oracle gets the histories without the last round");
+	check(oracle.counts_ok, what + ": oracle gets the move counts of its histories");
+}
+
+int main() {
+	std::mt19937 engine{ 5 };
+	vector a_opponent{}, a_meta{}, b_opponent{}, b_meta{};
+	for (int i{}; i < 300; i += 1) {
+		a_opponent.push_back((short)(engine() % 3));
+		a_meta.push_back((short)(engine() % 3));
+	}
+	b_opponent = a_opponent;
+	b_meta = a_meta;
+	b_opponent[10] = (short)((b_opponent[10] + 1) % 3); // same histories except for one early move pair
+	b_meta[20] = (short)((b_meta[20] + 2) % 3);
+
+	// histories in new vectors every move: a continuing history, then one that only differs early on (same last moves)
+	{
+		Meta_Player_Naive meta{ false, "", naive_score_mul, test_scoring_vector };
+		Recording_Oracle* oracle = new Recording_Oracle{};
+		meta.add_oracle(oracle);
+		for (std::size_t n{ 1 }; n <= 100; n += 1) meta.get_move(vector(a_opponent.begin(), a_opponent.begin() + n), vector(a_meta.begin(), a_meta.begin() + n));
+		check_oracle(*oracle, vector(a_meta.begin(), a_meta.begin() + 100), vector(a_opponent.begin(), a_opponent.begin() + 100), "continuing histories");
+
+		meta.get_move(vector(b_opponent.begin(), b_opponent.begin() + 101), vector(b_meta.begin(), b_meta.begin() + 101));
+		check_oracle(*oracle, vector(b_meta.begin(), b_meta.begin() + 101), vector(b_opponent.begin(), b_opponent.begin() + 101), "history changed early on");
+
+		meta.get_move(vector(b_opponent.begin(), b_opponent.begin() + 50), vector(b_meta.begin(), b_meta.begin() + 50));
+		check_oracle(*oracle, vector(b_meta.begin(), b_meta.begin() + 50), vector(b_opponent.begin(), b_opponent.begin() + 50), "shorter history");
+	}
+
+	// the same vectors growing in place (like a Game's histories), then changed early on in a copy
+	{
+		Meta_Player_Naive meta{ false, "", naive_score_mul, test_scoring_vector };
+		Recording_Oracle* oracle = new Recording_Oracle{};
+		meta.add_oracle(oracle);
+		vector opponent{}, own{};
+		for (std::size_t n{}; n < 300; n += 1) {
+			opponent.push_back(a_opponent[n]);
+			own.push_back(a_meta[n]);
+			meta.get_move(opponent, own);
+		}
+		check_oracle(*oracle, own, opponent, "histories growing in place");
+
+		vector opponent_copy{ b_opponent }, own_copy{ b_meta };
+		meta.get_move(opponent_copy, own_copy);
+		check_oracle(*oracle, own_copy, opponent_copy, "other vectors with an early change");
+	}
+
+	// one Meta Player in two Games without reset(): the second Game's histories don't continue the first ones
+	{
+		Meta_Player_Naive meta{ false, "", naive_score_mul, test_scoring_vector };
+		Recording_Oracle* oracle = new Recording_Oracle{};
+		meta.add_oracle(oracle);
+		for (int seed{ 1 }; seed <= 2; seed += 1) {
+			Random opponent{ seed };
+			Game game{ meta, opponent, 200 };
+			game.begin_play();
+			for (long long i{}; i < 200; i += 1) {
+				Move move_meta = game.next_move(0);
+				Move move_opponent = game.next_move(1);
+				game.play_round(i, move_meta, move_opponent);
+			}
+			Game_Result result = game.get_result();
+			vector meta_moves(result.move_history_p1.begin(), result.move_history_p1.end() - 1); // Meta Player's last move saw 199 rounds
+			vector opponent_moves(result.move_history_p2.begin(), result.move_history_p2.end() - 1);
+			check_oracle(*oracle, meta_moves, opponent_moves, "game " + std::to_string(seed) + " of a reused Meta Player");
+		}
+	}
+	return test_result("Meta_Test");
+}
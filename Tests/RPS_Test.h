@@ -0,0 +1,23 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+
+
+//// Minimal checks for the test programs in this folder (each one is a standalone program, see README.md)
+
+inline int failed_checks{};
+
+// check() reports a failed condition and counts it
+inline void check(bool ok, const std::string& what) {
+	if (ok) return;
+	std::cout << "FAILED: " << what << "\n";
+	failed_checks += 1;
+}
+
+// test_result() prints the summary and returns the exit code of the test program (0 if all checks passed)
+inline int test_result(const std::string& name) {
+	if (failed_checks) std::cout << name << ": " << failed_checks << " failed check(s)\n";
+	else std::cout << name << ": ok\n";
+	return failed_checks ? 1 : 0;
+}
@@ -0,0 +1,146 @@
+// Tests for RPS_Trace.h: round trip of spans recorded on several threads and of a traced game through the trace-event JSON file
+// Build (Linux): g++ -std=c++20 -O2 -pthread -o trace_test Trace_Test.cpp && ./trace_test
+
+#include <map>
+#include <thread>
+#include <filesystem>
+
+#include "../RPS_Trace.h"
+#include "RPS_Test.h"
+
+
+// Read_Event: a span as read back from the file (every event is on its own line)
+struct Read_Event {
+	std::string name{}, category{};
+	int tid{};
+	double ts{}, dur{};
+	long long round{ -1 };
+};
+
+// string_field() returns the unescaped string value of "key": in line
+std::string string_field(const std::string& line, const std::string& key) {
+	std::size_t i = line.find("\"" + key + "\":\"");
+	if (i == std::string::npos) return "";
+	std::string value{};
+	for (i += key.size() + 4; i < line.size() and line[i] != '"'; i += 1) {
+		if (line[i] == '\\') i += 1;
+		value += line[i];
+	}
+	return value;
+}
+
+// number_field() returns the number value of "key": in line (-1 if there is none)
+double number_field(const std::string& line, const std::string& key) {
+	std::size_t i = line.find("\"" + key + "\":");
+	if (i == std::string::npos) return -1;
+	return std::stod(line.substr(i + key.size() + 3));
+}
+
+std::vector<Read_Event> read_trace(const std::string& path, bool& well_formed) {
+	std::ifstream ifs{ path };
+	std::string line{};
+	std::vector<Read_Event> events{};
+	std::getline(ifs, line);
+	well_formed = (line == "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+	std::string last{};
+	while (std::getline(ifs, line)) {
+		last = line;
+		if (line.find("\"ph\":\"X\"") == std::string::npos) continue;
+		well_formed = well_formed and line.front() == '{' and (line.back() == '}' or line.ends_with("},"));
+		events.push_back({ string_field(line, "name"), string_field(line, "cat"), (int)number_field(line, "tid"), number_field(line, "ts"),
+			number_field(line, "dur"), (long long)number_field(line, "round") });
+	}
+	well_formed = well_formed and last == "]}";
+	return events;
+}
+
+int main() {
+	std::string path = (std::filesystem::temp_directory_path() / "rps_trace_test.json").string();
+	constexpr int threads{ 4 }, spans{ 1000 };
+
+	{
+		// spans of several threads, names that need escaping
+		Trace_Recorder recorder{};
+		active_trace = &recorder;
+		const char* name = recorder.intern("quoted \"name\" with \\ backslash");
+		std::vector<std::thread> workers{};
+		for (int t{}; t < threads; t += 1) {
+			workers.emplace_back([&recorder, name]() {
+				for (int i{}; i < spans; i += 1) {
+					std::int64_t start = recorder.now();
+					recorder.record(name, "task", start, start + 1000);
+				}
+				Trace_Span span{ "worker", "thread" };
+			});
+		}
+		for (std::thread& worker : workers) worker.join();
+		active_trace = nullptr;
+		check(recorder.size() == threads * (spans + 1), "every span of every thread is recorded");
+		check(recorder.write(path), "trace is written");
+
+		bool well_formed{};
+		std::vector<Read_Event> events = read_trace(path, well_formed);
+		check(well_formed, "trace file is trace-event JSON");
+		check(events.size() == threads * (spans + 1), "every span is written");
+		std::map<int, int> spans_per_thread{};
+		bool names_ok{ true }, times_ok{ true };
+		for (const Read_Event& event : events) {
+			if (event.category == "task") {
+				spans_per_thread[event.tid] += 1;
+				names_ok = names_ok and event.name == "quoted \"name\" with \\ backslash";
+				times_ok = times_ok and event.ts >= 0 and event.dur == 1 and event.round == -1;
+			}
+			else names_ok = names_ok and event.name == "worker" and event.category == "thread";
+		}
+		check(names_ok, "names and categories read back unchanged");
+		check(times_ok, "start and duration read back unchanged (us)");
+		bool per_thread_ok{ spans_per_thread.size() == threads };
+		for (auto [tid, n] : spans_per_thread) per_thread_ok = per_thread_ok and n == spans;
+		check(per_thread_ok, "spans of every thread are written with their thread id");
+	}
+
+	{
+		// traced game: every round span holds the get_move() calls of both players
+		Trace_Recorder recorder{};
+		Rotation player1{ 1 };
+		Frequency player2{};
+		Trace_Profiler profiler{ recorder, player1.get_name(), player2.get_name(), 10 };
+		Game game{ player1, player2, 100 };
+		game.set_profiler(&profiler);
+		game.begin_play();
+		for (long long i{}; i < 100; i += 1) {
+			Move move_p1 = game.next_move(0);
+			Move move_p2 = game.next_move(1);
+			game.play_round(i, move_p1, move_p2);
+		}
+		profiler.finish();
+		check(recorder.write(path), "game trace is written");
+
+		bool well_formed{};
+		std::vector<Read_Event> events = read_trace(path, well_formed);
+		check(well_formed, "game trace file is trace-event JSON");
+		std::vector<long long> rounds{};
+		std::vector<const Read_Event*> round_spans{};
+		int moves{};
+		for (const Read_Event& event : events) {
+			if (event.name == "round") {
+				rounds.push_back(event.round);
+				round_spans.push_back(&event);
+			}
+			if (event.name.rfind("get_move ", 0) == 0) moves += 1;
+		}
+		check(rounds == std::vector<long long>{ 1, 11, 21, 31, 41, 51, 61, 71, 81, 91 }, "every 10th round is traced with its number");
+		check(moves == 20, "get_move() calls of both players in the traced rounds are written");
+		bool nested{ true };
+		for (const Read_Event& event : events) {
+			if (event.category != "round") continue;
+			bool inside{};
+			for (const Read_Event* round : round_spans) inside = inside or (event.ts >= round->ts and event.ts + event.dur <= round->ts + round->dur + 0.001);
+			nested = nested and inside;
+		}
+		check(nested, "phases lie inside their round span");
+	}
+
+	std::filesystem::remove(path);
+	return test_result("Trace_Test");
+}